@@ -36,12 +36,51 @@
 #endif
 
 
+#ifndef ENTT_CHUNK_SIZE
+#   define ENTT_CHUNK_SIZE 1024
+#endif
+
+
+#ifndef ENTT_ALLOCATOR
+#   include <memory>
+#   define ENTT_ALLOCATOR std::allocator
+#endif
+
+
 #ifndef ENTT_ASSERT
 #   include <cassert>
 #   define ENTT_ASSERT(condition) assert(condition)
 #endif
 
 
+#ifndef ENTT_USE_SIGNATURE
+#   define ENTT_SIGNATURE_ENABLED false
+#else
+#   define ENTT_SIGNATURE_ENABLED true
+#endif
+
+
+#ifndef ENTT_USE_ALIVE_LIST
+#   define ENTT_ALIVE_LIST_ENABLED false
+#else
+#   define ENTT_ALIVE_LIST_ENABLED true
+#endif
+
+
+#ifndef ENTT_USE_POOL_STATS
+#   define ENTT_POOL_STATS_ENABLED false
+#else
+#   define ENTT_POOL_STATS_ENABLED true
+#endif
+
+
+#ifndef ENTT_USE_ZEROED_PAGES
+#   define ENTT_ZEROED_PAGES_ENABLED false
+#else
+#   define ENTT_ZEROED_PAGES_ENABLED true
+#endif
+
+
 #ifndef ENTT_NO_ETO
 #   include <type_traits>
 #   define ENTT_IS_EMPTY(Type) std::is_empty<Type>
@@ -2,6 +2,8 @@
 #define ENTT_CORE_ALGORITHM_HPP
 
 
+#include <array>
+#include <cstddef>
 #include <vector>
 #include <utility>
 #include <iterator>
@@ -135,6 +137,86 @@ struct radix_sort {
             }
         }
     }
+
+    /**
+     * @brief Sorts the elements in a range by means of an executor.
+     *
+     * The range is split in blocks that are counted and scattered by separate
+     * tasks during each pass, therefore the sort can run on multiple threads.
+     * The result is the same as that of the single threaded version.<br/>
+     * The executor is a function object that accepts a number of tasks and a
+     * task to run for each index in the range `[0, count)`. It must return only
+     * once all the tasks have completed. Its signature must be equivalent to
+     * the following:
+     *
+     * @code{.cpp}
+     * void(std::size_t count, Task task);
+     * @endcode
+     *
+     * The _getter_ can be invoked concurrently from different tasks.
+     *
+     * @tparam Executor Type of executor.
+     * @tparam It Type of random access iterator.
+     * @tparam Getter Type of _getter_ function object.
+     * @param executor A valid executor.
+     * @param first An iterator to the first element of the range to sort.
+     * @param last An iterator past the last element of the range to sort.
+     * @param getter A valid _getter_ function object.
+     */
+    template<typename Executor, typename It, typename Getter = identity>
+    void operator()(Executor &&executor, It first, It last, Getter getter = Getter{}) const {
+        if(first < last) {
+            static constexpr auto mask = (1 << Bit) - 1;
+            static constexpr auto buckets = 1 << Bit;
+            static constexpr auto passes = N / Bit;
+            // blocks are large enough to amortize the cost of their histograms
+            static constexpr std::size_t block = 1u << 14u;
+            static constexpr std::size_t max_tasks = 64u;
+
+            using value_type = typename std::iterator_traits<It>::value_type;
+            const auto length = static_cast<std::size_t>(std::distance(first, last));
+            const auto tasks = (std::min)(max_tasks, (length + block - 1u) / block);
+            const auto step = (length + tasks - 1u) / tasks;
+
+            std::vector<value_type> aux(length);
+            std::vector<std::array<std::size_t, buckets>> index(tasks);
+
+            auto part = [&executor, &getter, &index, tasks, step, length](auto from, auto out, auto start) {
+                executor(tasks, [&getter, &index, from, step, length, start](const std::size_t task) {
+                    auto &count = index[task];
+                    count.fill(0u);
+
+                    std::for_each(from + (std::min)(task * step, length), from + (std::min)((task + 1u) * step, length), [&getter, &count, start](const value_type &item) {
+                        ++count[(getter(item) >> start) & mask];
+                    });
+                });
+
+                for(std::size_t bucket{}, offset{}; bucket < buckets; ++bucket) {
+                    for(std::size_t task{}; task < tasks; ++task) {
+                        offset += std::exchange(index[task][bucket], offset);
+                    }
+                }
+
+                executor(tasks, [&getter, &index, from, out, step, length, start](const std::size_t task) {
+                    auto &offset = index[task];
+
+                    std::for_each(from + (std::min)(task * step, length), from + (std::min)((task + 1u) * step, length), [&getter, &offset, out, start](value_type &item) {
+                        out[offset[(getter(item) >> start) & mask]++] = std::move(item);
+                    });
+                });
+            };
+
+            for(std::size_t pass = 0; pass < (passes & ~1); pass += 2) {
+                part(first, aux.begin(), pass * Bit);
+                part(aux.begin(), first, (pass + 1) * Bit);
+            }
+
+            if constexpr(passes & 1) {
+                part(first, aux.begin(), (passes - 1) * Bit);
+                std::move(aux.begin(), aux.end(), first);
+            }
+        }
+    }
 };
 
 
@@ -0,0 +1,316 @@
+#ifndef ENTT_CORE_THREAD_POOL_HPP
+#define ENTT_CORE_THREAD_POOL_HPP
+
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../config/config.h"
+
+
+namespace entt {
+
+
+/**
+ * @brief Minimal work-stealing pool of threads.
+ *
+ * A thread pool is a function object that accepts a number of tasks and a
+ * task to run for each index in the range `[0, count)`, the same as any other
+ * executor:
+ *
+ * @code{.cpp}
+ * void(std::size_t count, Task task);
+ * @endcode
+ *
+ * Moreover, it runs graphs of jobs in which jobs spawn other jobs as they
+ * complete (see the `run` member function for more details).<br/>
+ * Each thread has its own queue of jobs. Threads consume their own jobs first
+ * and steal those of the other threads when they run out of work. The thread
+ * that submitted the jobs also takes part in the work. The function returns
+ * only once all the jobs have completed. The first exception thrown by a job,
+ * if any, is rethrown to the caller after that.
+ *
+ * @warning
+ * Jobs submitted by different threads are executed one after the other.
+ * Submitting a job from within a job of the same pool results in a deadlock.
+ */
+class thread_pool {
+    struct queue_type {
+        std::mutex mutex;
+        std::deque<std::size_t> jobs;
+    };
+
+    void fail() {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        if(!error) {
+            error = std::current_exception();
+        }
+    }
+
+    void push(const std::size_t slot, const std::size_t job) {
+        ++pending;
+
+        try {
+            std::lock_guard<std::mutex> lock{queues[slot].mutex};
+            queues[slot].jobs.push_back(job);
+            ++queued;
+        } catch(...) {
+            --pending;
+            throw;
+        }
+
+        if(sleeping.load() != 0u) {
+            // sleepers are either blocked or about to notice the new job once the lock is released
+            std::lock_guard<std::mutex> lock{mutex};
+            wake.notify_one();
+        }
+    }
+
+    [[nodiscard]] bool acquire(const std::size_t slot, std::size_t &job) {
+        for(std::size_t pos{}; pos < slots && queued.load() != 0u; ++pos) {
+            auto &curr = queues[(slot + pos) % slots];
+            std::lock_guard<std::mutex> lock{curr.mutex};
+
+            if(!curr.jobs.empty()) {
+                // own jobs are taken from the back while the others are stolen from the front
+                if(pos) {
+                    job = curr.jobs.front();
+                    curr.jobs.pop_front();
+                } else {
+                    job = curr.jobs.back();
+                    curr.jobs.pop_back();
+                }
+
+                --queued;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void execute(const std::size_t slot, const std::size_t job) {
+        try {
+            invoke(*this, task, slot, job);
+        } catch(...) {
+            fail();
+        }
+
+        if(--pending == 0u) {
+            std::lock_guard<std::mutex> lock{mutex};
+            wake.notify_all();
+        }
+    }
+
+    void work(const std::size_t slot) {
+        for(std::size_t job{};;) {
+            if(acquire(slot, job)) {
+                execute(slot, job);
+            } else {
+                std::unique_lock<std::mutex> lock{mutex};
+                ++sleeping;
+                wake.wait(lock, [this]() { return stop || queued.load() != 0u; });
+                --sleeping;
+
+                if(stop) {
+                    break;
+                }
+            }
+        }
+    }
+
+    template<typename Func, typename Seed>
+    void dispatch(Seed seed, Func &func) {
+        std::lock_guard<std::mutex> serial{submit};
+
+        task = &func;
+        invoke = +[](thread_pool &pool, void *instance, const std::size_t slot, const std::size_t pos) {
+            (*static_cast<Func *>(instance))(pos, [&pool, slot](const std::size_t next) { pool.push(slot, next); });
+        };
+
+        try {
+            // initial jobs are spread across all the queues
+            seed([this, slot = std::size_t{}](const std::size_t job) mutable {
+                push(slot, job);
+                slot = (slot + 1u) % slots;
+            });
+        } catch(...) {
+            fail();
+        }
+
+        for(std::size_t next{}; pending.load() != 0u;) {
+            if(acquire(0u, next)) {
+                execute(0u, next);
+            } else {
+                std::unique_lock<std::mutex> lock{mutex};
+                ++sleeping;
+                wake.wait(lock, [this]() { return pending.load() == 0u || queued.load() != 0u; });
+                --sleeping;
+            }
+        }
+
+        if(std::lock_guard<std::mutex> lock{mutex}; error) {
+            std::rethrow_exception(std::exchange(error, nullptr));
+        }
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stop = true;
+        }
+
+        wake.notify_all();
+
+        for(auto &&thread: threads) {
+            thread.join();
+        }
+    }
+
+public:
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Default constructor.
+     *
+     * Together with the calling thread, the pool uses as many threads as the
+     * hardware supports.
+     */
+    thread_pool()
+        : thread_pool{size_type{(std::max)(std::thread::hardware_concurrency(), 1u)} - 1u}
+    {}
+
+    /**
+     * @brief Constructs a pool with a given number of worker threads.
+     * @param workers Number of worker threads, the calling thread excluded.
+     */
+    explicit thread_pool(const size_type workers)
+        : slots{workers + 1u},
+          threads{},
+          queues{std::make_unique<queue_type[]>(slots)},
+          submit{},
+          mutex{},
+          wake{},
+          queued{},
+          pending{},
+          sleeping{},
+          task{},
+          invoke{},
+          error{},
+          stop{}
+    {
+        try {
+            threads.reserve(workers);
+
+            for(auto pos = workers; pos; --pos) {
+                threads.emplace_back(&thread_pool::work, this, pos);
+            }
+        } catch(...) {
+            release();
+            throw;
+        }
+    }
+
+    /*! @brief Default copy constructor, deleted on purpose. */
+    thread_pool(const thread_pool &) = delete;
+
+    /*! @brief Default destructor, it waits for the worker threads to exit. */
+    ~thread_pool() {
+        release();
+    }
+
+    /**
+     * @brief Default copy assignment operator, deleted on purpose.
+     * @return This thread pool.
+     */
+    thread_pool & operator=(const thread_pool &) = delete;
+
+    /**
+     * @brief Returns the number of worker threads, the calling thread excluded.
+     * @return Number of worker threads.
+     */
+    [[nodiscard]] size_type size() const ENTT_NOEXCEPT {
+        return threads.size();
+    }
+
+    /**
+     * @brief Runs a task for each index in a range and waits for all of them.
+     *
+     * The task is invoked concurrently from different threads.
+     *
+     * @tparam Task Type of task to run.
+     * @param length Number of tasks to run.
+     * @param func A valid task, that is a function object that accepts an index.
+     */
+    template<typename Task>
+    void operator()(const size_type length, Task func) {
+        auto job = [&func](const size_type pos, auto &&) { func(pos); };
+
+        dispatch([length](auto push) {
+            for(size_type pos{}; pos < length; ++pos) {
+                push(pos);
+            }
+        }, job);
+    }
+
+    /**
+     * @brief Runs a graph of jobs and waits for all of them.
+     *
+     * Jobs are identified by unsigned integers and the range contains those to
+     * run first. The function object is invoked once for each job, along with
+     * a callable object that schedules other jobs. Jobs scheduled this way run
+     * only after the calling one has returned, possibly on other threads. The
+     * signature of the function object must be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(std::size_t job, Spawn spawn);
+     * @endcode
+     *
+     * Where `spawn` is invoked as `spawn(std::size_t job)`.<br/>
+     * Jobs scheduled by a thread are consumed by the same thread in a last-in
+     * first-out order, unless they are stolen by other threads in the meantime.
+     *
+     * @tparam It Type of input iterator.
+     * @tparam Func Type of function object to invoke.
+     * @param first An iterator to the first job to run.
+     * @param last An iterator past the last job to run.
+     * @param func A valid function object.
+     */
+    template<typename It, typename Func>
+    void run(It first, It last, Func func) {
+        dispatch([first, last](auto push) mutable {
+            for(; first != last; ++first) {
+                push(static_cast<size_type>(*first));
+            }
+        }, func);
+    }
+
+private:
+    const size_type slots;
+    std::vector<std::thread> threads;
+    std::unique_ptr<queue_type[]> queues;
+    std::mutex submit;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::atomic<size_type> queued;
+    std::atomic<size_type> pending;
+    std::atomic<size_type> sleeping;
+    void *task;
+    void(* invoke)(thread_pool &, void *, const size_type, const size_type);
+    std::exception_ptr error;
+    bool stop;
+};
+}
+
+
+#endif
@@ -0,0 +1,455 @@
+#ifndef ENTT_ENTITY_CACHED_VIEW_HPP
+#define ENTT_ENTITY_CACHED_VIEW_HPP
+
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../config/config.h"
+#include "../core/type_traits.hpp"
+#include "component.hpp"
+#include "entity.hpp"
+#include "fwd.hpp"
+#include "pool.hpp"
+#include "sparse_set.hpp"
+
+
+namespace entt {
+
+
+/**
+ * @brief Log of the entities assigned to or removed from a pool.
+ *
+ * Change logs are created by the registry the first time a cached view needs
+ * them and are shared by all the cached views that iterate the same type of
+ * component. Each cached view reads the log from its own cursor. Entries are
+ * recorded only as long as there are readers and are discarded once all the
+ * readers have consumed them.
+ *
+ * @warning
+ * Readers that never consume their entries prevent the log from shrinking.
+ *
+ * @tparam Entity A valid entity type (see entt_traits for more details).
+ */
+template<typename Entity>
+class basic_change_log {
+    using alloc_traits = std::allocator_traits<typename sparse_set<Entity>::allocator_type>;
+    static constexpr auto detached = (std::numeric_limits<std::size_t>::max)();
+
+    void trim() {
+        auto first = offset + entries.size();
+
+        for(const auto cursor: cursors) {
+            first = (cursor == detached) ? first : (std::min)(first, cursor);
+        }
+
+        // entries are dropped in bulk so as to amortize the cost of moving the others
+        if(const auto count = first - offset; count && (2u * count >= entries.size())) {
+            entries.erase(entries.begin(), entries.begin() + static_cast<typename decltype(entries)::difference_type>(count));
+            offset = first;
+        }
+    }
+
+public:
+    /*! @brief Allocator type. */
+    using allocator_type = typename alloc_traits::allocator_type;
+    /*! @brief Underlying entity identifier. */
+    using entity_type = Entity;
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /**
+     * @brief Constructs an empty change log with a given allocator.
+     * @param alloc Allocator to use for all memory allocations.
+     */
+    explicit basic_change_log(const allocator_type &alloc = allocator_type{})
+        : entries{alloc},
+          cursors{typename alloc_traits::template rebind_alloc<size_type>{alloc}},
+          offset{},
+          readers{}
+    {}
+
+    /**
+     * @brief Records a range of entities.
+     *
+     * This function is meant to be connected to the batch construction and
+     * destruction signals of a pool.
+     *
+     * @param first A pointer to the first entity of the range.
+     * @param last A pointer past the last entity of the range.
+     */
+    void record(basic_registry<Entity> &, const Entity *first, const Entity *last) {
+        if(readers) {
+            entries.insert(entries.end(), first, last);
+        }
+    }
+
+    /**
+     * @brief Adds a reader to the log.
+     *
+     * Readers only see the entities recorded after they are attached.
+     *
+     * @return The slot that identifies the reader.
+     */
+    [[nodiscard]] size_type attach() {
+        const auto slot = static_cast<size_type>(std::find(cursors.cbegin(), cursors.cend(), detached) - cursors.cbegin());
+
+        if(slot == cursors.size()) {
+            cursors.push_back(offset + entries.size());
+        } else {
+            cursors[slot] = offset + entries.size();
+        }
+
+        ++readers;
+        return slot;
+    }
+
+    /**
+     * @brief Removes a reader from the log.
+     * @param slot A slot returned by `attach`.
+     */
+    void detach(const size_type slot) {
+        ENTT_ASSERT(slot < cursors.size() && cursors[slot] != detached);
+        cursors[slot] = detached;
+
+        if(--readers) {
+            trim();
+        } else {
+            entries.clear();
+        }
+    }
+
+    /**
+     * @brief Visits the entities recorded since the last call for a reader.
+     *
+     * The same entity can be returned more than once. The signature of the
+     * function should be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(const Entity);
+     * @endcode
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param slot A slot returned by `attach`.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void consume(const size_type slot, Func func) {
+        ENTT_ASSERT(slot < cursors.size() && cursors[slot] != detached);
+
+        for(auto pos = cursors[slot] - offset, last = entries.size(); pos < last; ++pos) {
+            func(entries[pos]);
+        }
+
+        cursors[slot] = offset + entries.size();
+        trim();
+    }
+
+    /**
+     * @brief Returns the number of entries not yet consumed by all the readers.
+     * @return Number of entries still in the log.
+     */
+    [[nodiscard]] size_type size() const ENTT_NOEXCEPT {
+        return entries.size();
+    }
+
+private:
+    std::vector<entity_type, allocator_type> entries;
+    std::vector<size_type, typename alloc_traits::template rebind_alloc<size_type>> cursors;
+    size_type offset;
+    size_type readers;
+};
+
+
+/**
+ * @brief Cached view.
+ *
+ * A cached view keeps the list of the entities that have all the given
+ * components, rather than looking for them every time it's iterated as views
+ * do. The list is kept up-to-date lazily, from the change logs of the pools
+ * (see `basic_change_log`). Pending changes are applied the next time the
+ * cached view is accessed and each entity is checked once per log in which it
+ * appears, no matter how many times its components changed in the meantime.
+ *
+ * Unlike groups, cached views don't connect themselves to any signal. All the
+ * cached views that iterate a given type of component share the same change
+ * log and pools without cached views don't pay for it.
+ *
+ * @b Important
+ *
+ * Iterators aren't invalidated if:
+ *
+ * * New instances of the given components are created and assigned to
+ *   entities.
+ * * The entity currently pointed is modified (as an example, if one of the
+ *   given components is removed from the entity to which the iterator points).
+ * * The entity currently pointed is destroyed.
+ *
+ * In all other cases, modifying the pools iterated by the cached view in any
+ * way invalidates all the iterators and using them results in undefined
+ * behavior.
+ *
+ * @note
+ * Contrary to views and groups, cached views are meant to be stored. They're
+ * movable but they cannot be copied.
+ *
+ * @warning
+ * Lifetime of a cached view must not overcome that of the registry that
+ * generated it. In any other case, attempting to use it results in undefined
+ * behavior.
+ *
+ * @tparam Entity A valid entity type (see entt_traits for more details).
+ * @tparam Component Types of components iterated by the cached view.
+ */
+template<typename Entity, typename... Component>
+class basic_cached_view {
+    /*! @brief A registry is allowed to create cached views. */
+    friend class basic_registry<Entity>;
+
+    template<typename Comp>
+    using pool_type = pool_t<Entity, Comp>;
+
+    using log_type = basic_change_log<Entity>;
+
+    basic_cached_view(pool_type<Component> &... cpool, std::shared_ptr<unpack_as_t<log_type, Component>>... clog, const typename sparse_set<Entity>::allocator_type &alloc)
+        : pools{&cpool...},
+          logs{std::make_pair(clog, clog->attach())...},
+          matched{alloc}
+    {
+        const sparse_set<Entity> *candidate = (std::min)({ static_cast<const sparse_set<Entity> *>(&cpool)... }, [](const auto *lhs, const auto *rhs) {
+            return lhs->size() < rhs->size();
+        });
+
+        // logs are read from now on, everything else is collected once and for all
+        for(const auto entt: *candidate) {
+            if((cpool.contains(entt) && ...)) {
+                matched.emplace(entt);
+            }
+        }
+    }
+
+    void release() {
+        for(auto &&elem: logs) {
+            if(elem.first) {
+                elem.first->detach(elem.second);
+            }
+        }
+    }
+
+    void maybe_valid_if(const Entity entt) {
+        if((std::get<pool_type<Component> *>(pools)->contains(entt) && ...)) {
+            // the identifier of a recycled entity replaces the one of its predecessor
+            const auto *lead = std::get<0>(pools);
+            const auto curr = lead->data()[lead->index(entt)];
+
+            if(matched.contains(curr) && matched.data()[matched.index(curr)] != curr) {
+                matched.erase(curr);
+            }
+
+            if(!matched.contains(curr)) {
+                matched.emplace(curr);
+            }
+        } else if(matched.contains(entt)) {
+            matched.erase(entt);
+        }
+    }
+
+    template<typename Func, typename... Type>
+    void traverse(Func &func, type_list<Type...>) const {
+        for(const auto entt: matched) {
+            if constexpr(std::is_invocable_v<Func, decltype(std::declval<pool_type<Type> &>().get({}))...>) {
+                func(std::get<pool_type<Type> *>(pools)->get(entt)...);
+            } else {
+                func(entt, std::get<pool_type<Type> *>(pools)->get(entt)...);
+            }
+        }
+    }
+
+public:
+    /*! @brief Underlying entity identifier. */
+    using entity_type = Entity;
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+    /*! @brief Random access iterator type. */
+    using iterator = typename sparse_set<Entity>::iterator;
+
+    /*! @brief Default copy constructor, deleted on purpose. */
+    basic_cached_view(const basic_cached_view &) = delete;
+
+    /*! @brief Default move constructor. */
+    basic_cached_view(basic_cached_view &&) = default;
+
+    /*! @brief Default destructor, it detaches the cached view from the logs. */
+    ~basic_cached_view() {
+        release();
+    }
+
+    /**
+     * @brief Default copy assignment operator, deleted on purpose.
+     * @return This cached view.
+     */
+    basic_cached_view & operator=(const basic_cached_view &) = delete;
+
+    /**
+     * @brief Move assignment operator.
+     * @param other The instance to move from.
+     * @return This cached view.
+     */
+    basic_cached_view & operator=(basic_cached_view &&other) {
+        if(this != &other) {
+            release();
+            pools = other.pools;
+            logs = std::move(other.logs);
+            matched = std::move(other.matched);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Applies the pending changes to the list of entities.
+     *
+     * There is no need to invoke this function explicitly, since all the other
+     * member functions do it when required. However, it allows to choose when
+     * to pay for the pending changes, for example before iterating the cached
+     * view from multiple threads.
+     */
+    void refresh() {
+        for(auto &&elem: logs) {
+            elem.first->consume(elem.second, [this](const Entity entt) { maybe_valid_if(entt); });
+        }
+    }
+
+    /**
+     * @brief Returns the number of entities that have the given components.
+     * @return Number of entities that have the given components.
+     */
+    [[nodiscard]] size_type size() {
+        refresh();
+        return matched.size();
+    }
+
+    /**
+     * @brief Checks whether a cached view is empty.
+     * @return True if the cached view is empty, false otherwise.
+     */
+    [[nodiscard]] bool empty() {
+        refresh();
+        return matched.empty();
+    }
+
+    /**
+     * @brief Returns an iterator to the first entity of the cached view.
+     *
+     * The returned iterator points to the first entity of the cached view. If
+     * the cached view is empty, the returned iterator will be equal to `end()`.
+     *
+     * @note
+     * Iterators stay true to the order imposed by the cached view, that doesn't
+     * depend on the order of the underlying pools.
+     *
+     * @return An iterator to the first entity of the cached view.
+     */
+    [[nodiscard]] iterator begin() {
+        refresh();
+        return matched.begin();
+    }
+
+    /**
+     * @brief Returns an iterator that is past the last entity of the cached
+     * view.
+     *
+     * The returned iterator points to the entity following the last entity of
+     * the cached view. Attempting to dereference the returned iterator results
+     * in undefined behavior.
+     *
+     * @return An iterator to the entity following the last entity of the
+     * cached view.
+     */
+    [[nodiscard]] iterator end() {
+        refresh();
+        return matched.end();
+    }
+
+    /**
+     * @brief Checks if a cached view contains an entity.
+     * @param entt A valid entity identifier.
+     * @return True if the cached view contains the given entity, false
+     * otherwise.
+     */
+    [[nodiscard]] bool contains(const entity_type entt) {
+        refresh();
+        return matched.contains(entt);
+    }
+
+    /**
+     * @brief Returns the components assigned to the given entity.
+     *
+     * @warning
+     * Attempting to use an invalid component type results in a compilation
+     * error. Attempting to use an entity that doesn't have the requested
+     * components results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * entity doesn't have the requested components.
+     *
+     * @tparam Comp Types of components to get.
+     * @param entt A valid entity identifier.
+     * @return The components assigned to the entity.
+     */
+    template<typename... Comp>
+    [[nodiscard]] decltype(auto) get(const entity_type entt) const {
+        if constexpr(sizeof...(Comp) == 0) {
+            return get<Component...>(entt);
+        } else if constexpr(sizeof...(Comp) == 1) {
+            ENTT_ASSERT((std::get<pool_type<Comp> *>(pools)->contains(entt) && ...));
+            return (std::get<pool_type<Comp> *>(pools)->get(entt), ...);
+        } else {
+            return std::tuple<decltype(get<Comp>({}))...>{get<Comp>(entt)...};
+        }
+    }
+
+    /**
+     * @brief Iterates entities and components and applies the given function
+     * object to them.
+     *
+     * The function object is invoked for each entity. It is provided with the
+     * entity itself and a set of references to non-empty components. The
+     * _constness_ of the components is as requested.<br/>
+     * The signature of the function must be equivalent to one of the following
+     * forms:
+     *
+     * @code{.cpp}
+     * void(const entity_type, Type &...);
+     * void(Type &...);
+     * @endcode
+     *
+     * @note
+     * Empty types aren't explicitly instantiated and therefore they are never
+     * returned during iterations.
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void each(Func func) {
+        refresh();
+        traverse(func, type_list_cat_t<std::conditional_t<is_eto_eligible_v<Component>, type_list<>, type_list<Component>>...>{});
+    }
+
+private:
+    std::tuple<pool_type<Component> *...> pools;
+    std::array<std::pair<std::shared_ptr<log_type>, size_type>, sizeof...(Component)> logs;
+    sparse_set<Entity> matched;
+};
+
+
+}
+
+
+#endif
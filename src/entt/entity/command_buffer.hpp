@@ -0,0 +1,320 @@
+#ifndef ENTT_ENTITY_COMMAND_BUFFER_HPP
+#define ENTT_ENTITY_COMMAND_BUFFER_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../config/config.h"
+#include "../core/type_info.hpp"
+#include "../core/type_traits.hpp"
+#include "entity.hpp"
+#include "fwd.hpp"
+#include "registry.hpp"
+
+
+namespace entt {
+
+
+/**
+ * @brief Deferred command buffer.
+ *
+ * Command buffers record structural changes (creation and destruction of
+ * entities, assignment and removal of components) in a linear buffer and
+ * replay them on a registry later on. They allow worker threads to defer
+ * structural changes while iterating views in parallel, one buffer per thread,
+ * and to apply them all at once from a single thread afterwards.<br/>
+ * Entities created through a command buffer are placeholders until the buffer
+ * is applied. Placeholders can be used with all the other commands of the same
+ * buffer and are replaced with the actual entities during the playback.<br/>
+ * Placeholders have a type of their own and are never mistaken for actual
+ * entities.
+ *
+ * @note
+ * Consecutive commands of the same type that target the same pool are replayed
+ * as a single batch.
+ *
+ * @warning
+ * Command buffers aren't thread-safe. Each thread should record its commands
+ * in a buffer of its own.
+ *
+ * @tparam Entity A valid entity type (see entt_traits for more details).
+ */
+template<typename Entity>
+class basic_command_buffer {
+    using traits_type = entt_traits<Entity>;
+
+    enum class operation: std::uint8_t {
+        create,
+        emplace,
+        remove,
+        destroy
+    };
+
+    struct command {
+        operation op;
+        // placeholders are flagged rather than encoded, they never collide with actual entities
+        bool placeholder;
+        std::size_t pool;
+        Entity entity;
+    };
+
+    struct basic_pending {
+        virtual ~basic_pending() = default;
+        virtual void emplace(basic_registry<Entity> &, const Entity *, const Entity *) = 0;
+        virtual void remove(basic_registry<Entity> &, const Entity *, const Entity *) = 0;
+    };
+
+    template<typename Component>
+    struct pending final: basic_pending {
+        void emplace(basic_registry<Entity> &owner, const Entity *first, const Entity *last) override {
+            const auto length = static_cast<std::size_t>(last - first);
+
+            if constexpr(is_eto_eligible_v<Component>) {
+                owner.template insert<Component>(first, last);
+            } else {
+                // components are consumed in the same order in which they were recorded
+                const auto from = std::make_move_iterator(values.begin() + static_cast<typename decltype(values)::difference_type>(cursor));
+                owner.template insert<Component>(first, last, from, from + static_cast<typename decltype(values)::difference_type>(length));
+            }
+
+            cursor += length;
+        }
+
+        void remove(basic_registry<Entity> &owner, const Entity *first, const Entity *last) override {
+            owner.template remove<Component>(first, last);
+        }
+
+        std::vector<Component> values{};
+        std::size_t cursor{};
+    };
+
+    template<typename Component>
+    [[nodiscard]] std::size_t assure() {
+        const auto id = type_info<Component>::id();
+        std::size_t pos{};
+
+        for(const auto size = pools.size(); pos < size && pools[pos].first != id; ++pos);
+
+        if(pos == pools.size()) {
+            pools.emplace_back(id, std::make_unique<pending<Component>>());
+        }
+
+        return pos;
+    }
+
+    [[nodiscard]] static std::size_t index(const command &cmd) ENTT_NOEXCEPT {
+        return static_cast<std::size_t>(to_integral(cmd.entity));
+    }
+
+    [[nodiscard]] static Entity resolve(const std::vector<Entity> &created, const command &cmd) ENTT_NOEXCEPT {
+        return cmd.placeholder ? created[index(cmd)] : cmd.entity;
+    }
+
+    template<typename Type>
+    void record(const operation op, const std::size_t pool, const Type target) {
+        static_assert(std::is_same_v<Type, Entity> || std::is_same_v<Type, placeholder_type>, "Invalid entity or placeholder");
+
+        if constexpr(std::is_same_v<Type, Entity>) {
+            commands.push_back(command{op, false, pool, target});
+        } else {
+            // placeholders are stored as their position within the buffer
+            ENTT_ASSERT(static_cast<std::size_t>(target) < placeholders);
+            commands.push_back(command{op, true, pool, Entity{static_cast<typename traits_type::entity_type>(target)}});
+        }
+    }
+
+public:
+    /*! @brief Underlying entity identifier. */
+    using entity_type = Entity;
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+    /*! @brief Placeholder for an entity created through a command buffer. */
+    enum class placeholder_type: size_type {};
+
+    /**
+     * @brief Returns the number of commands recorded so far.
+     * @return Number of commands recorded so far.
+     */
+    [[nodiscard]] size_type size() const ENTT_NOEXCEPT {
+        return commands.size();
+    }
+
+    /**
+     * @brief Checks whether a command buffer is empty.
+     * @return True if the command buffer is empty, false otherwise.
+     */
+    [[nodiscard]] bool empty() const ENTT_NOEXCEPT {
+        return commands.empty();
+    }
+
+    /**
+     * @brief Records the creation of a new entity.
+     * @return A placeholder for the entity, valid only within the buffer.
+     */
+    [[nodiscard]] placeholder_type create() {
+        ENTT_ASSERT(placeholders < traits_type::entity_mask);
+        const auto entt = placeholder_type{placeholders++};
+
+        try {
+            record(operation::create, {}, entt);
+        } catch(...) {
+            --placeholders;
+            throw;
+        }
+
+        return entt;
+    }
+
+    /**
+     * @brief Records the assignment of a component to an entity.
+     *
+     * The component is constructed immediately and moved to the registry when
+     * the buffer is applied.
+     *
+     * @tparam Component Type of component to create.
+     * @tparam Type Either the entity type or the placeholder type.
+     * @tparam Args Types of arguments to use to construct the component.
+     * @param entity An entity or a placeholder returned by the buffer.
+     * @param args Parameters to use to initialize the component.
+     */
+    template<typename Component, typename Type, typename... Args>
+    void emplace(const Type entity, Args &&... args) {
+        const auto pos = assure<Component>();
+        auto &values = static_cast<pending<Component> &>(*pools[pos].second).values;
+
+        if constexpr(std::is_aggregate_v<Component>) {
+            values.push_back(Component{std::forward<Args>(args)...});
+        } else {
+            values.emplace_back(std::forward<Args>(args)...);
+        }
+
+        try {
+            record(operation::emplace, pos, entity);
+        } catch(...) {
+            values.pop_back();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Records the removal of a component from an entity.
+     * @tparam Component Type of component to remove.
+     * @tparam Type Either the entity type or the placeholder type.
+     * @param entity An entity or a placeholder returned by the buffer.
+     */
+    template<typename Component, typename Type>
+    void remove(const Type entity) {
+        record(operation::remove, assure<Component>(), entity);
+    }
+
+    /**
+     * @brief Records the destruction of an entity.
+     * @tparam Type Either the entity type or the placeholder type.
+     * @param entity An entity or a placeholder returned by the buffer.
+     */
+    template<typename Type>
+    void destroy(const Type entity) {
+        record(operation::destroy, {}, entity);
+    }
+
+    /**
+     * @brief Replays all the commands on a registry and clears the buffer.
+     *
+     * Commands are replayed in the order in which they were recorded.
+     *
+     * @warning
+     * The commands must be valid for the registry at the time they're
+     * replayed, as if they were invoked directly on it.<br/>
+     * If a command throws, the buffer is cleared and the exception is
+     * propagated. Commands replayed before the one that failed aren't rolled
+     * back.
+     *
+     * @param owner The registry on which to replay the commands.
+     */
+    void apply(basic_registry<entity_type> &owner) {
+        try {
+            std::vector<entity_type> created(placeholders);
+            std::vector<entity_type> batch{};
+
+            for(auto first = commands.cbegin(), last = commands.cend(); first != last;) {
+                auto next = first;
+                for(; next != last && next->op == first->op && next->pool == first->pool; ++next);
+
+                if(first->op == operation::create) {
+                    // placeholders are assigned in order, a run of creations maps to a contiguous range
+                    const auto from = created.begin() + static_cast<typename std::vector<entity_type>::difference_type>(index(*first));
+                    owner.create(from, from + (next - first));
+                } else {
+                    batch.clear();
+
+                    for(auto it = first; it != next; ++it) {
+                        batch.push_back(resolve(created, *it));
+                    }
+
+                    switch(first->op) {
+                    case operation::emplace:
+                        pools[first->pool].second->emplace(owner, batch.data(), batch.data() + batch.size());
+                        break;
+                    case operation::remove:
+                        pools[first->pool].second->remove(owner, batch.data(), batch.data() + batch.size());
+                        break;
+                    default:
+                        owner.destroy(batch.cbegin(), batch.cend());
+                        break;
+                    }
+                }
+
+                first = next;
+            }
+        } catch(...) {
+            // components are partially consumed at this point, the commands cannot be replayed again
+            clear();
+            throw;
+        }
+
+        clear();
+    }
+
+    /**
+     * @brief Replays multiple command buffers on a registry and clears them.
+     *
+     * Buffers are replayed one after the other, in the order in which they
+     * are in the range. The result is therefore deterministic, no matter
+     * which thread filled which buffer first.<br/>
+     * If a buffer throws, the buffers that follow it are left untouched.
+     *
+     * @tparam It Type of input iterator.
+     * @param owner The registry on which to replay the commands.
+     * @param first An iterator to the first buffer of the range to apply.
+     * @param last An iterator past the last buffer of the range to apply.
+     */
+    template<typename It>
+    static void apply(basic_registry<entity_type> &owner, It first, It last) {
+        for(; first != last; ++first) {
+            first->apply(owner);
+        }
+    }
+
+    /*! @brief Discards all the commands recorded so far. */
+    void clear() {
+        commands.clear();
+        pools.clear();
+        placeholders = {};
+    }
+
+private:
+    std::vector<command> commands{};
+    std::vector<std::pair<id_type, std::unique_ptr<basic_pending>>> pools{};
+    size_type placeholders{};
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef ENTT_ENTITY_COMPONENT_HPP
+#define ENTT_ENTITY_COMPONENT_HPP
+
+
+#include <cstddef>
+#include <type_traits>
+#include "../config/config.h"
+#include "fwd.hpp"
+
+
+namespace entt {
+
+
+/*! @brief Commonly used default traits for all types. */
+struct basic_component_traits {
+    /**
+     * @brief Number of objects per page, zero to disable pagination.
+     *
+     * Paginated components are never moved in memory when a pool grows and
+     * therefore pointers and references to them remain valid until the owning
+     * entities are erased. The value must be a power of two.
+     */
+    static constexpr std::size_t page_size = 0u;
+
+    /**
+     * @brief Layout of the sparse array of the pool.
+     *
+     * Hashed sparse arrays are intended for rare components, for which they
+     * require memory proportional to the number of instances rather than to
+     * the range of the identifiers in use.
+     */
+    static constexpr sparse_policy sparse = sparse_policy::paged;
+
+    /**
+     * @brief Deletion policy of the pool.
+     *
+     * Pools that delete in-place leave a hole behind when an entity is erased,
+     * so that the other elements are never moved and the order of the pool is
+     * preserved. Holes are reclaimed when the pool is compacted.
+     */
+    static constexpr deletion_policy deletion = deletion_policy::swap_and_pop;
+
+    /**
+     * @brief Enables change ticks for the pool.
+     *
+     * Pools that track changes store a tick next to each object, updated by the
+     * registry whenever the object is constructed, patched or replaced. Views
+     * can then visit only the objects changed since a given tick.
+     */
+    static constexpr bool track_changes = false;
+};
+
+
+/**
+ * @brief Component traits.
+ *
+ * Users can specialize this class template to change the way a type is stored
+ * by the ECS module of `EnTT`. Specializations are expected to inherit from
+ * `basic_component_traits` and override only the members of interest.
+ *
+ * @tparam Type Type of component.
+ */
+template<typename Type, typename = void>
+struct component_traits: basic_component_traits {
+    static_assert(std::is_same_v<std::decay_t<Type>, Type>, "Unsupported type");
+};
+
+
+/**
+ * @brief Helper variable template.
+ * @tparam Type Type of component.
+ */
+template<typename Type>
+inline constexpr std::size_t component_page_size_v = component_traits<std::remove_const_t<Type>>::page_size;
+
+
+/**
+ * @brief Helper variable template.
+ * @tparam Type Type of component.
+ */
+template<typename Type>
+inline constexpr bool component_in_place_delete_v = (component_traits<std::remove_const_t<Type>>::deletion == deletion_policy::in_place);
+
+
+/**
+ * @brief Helper variable template.
+ * @tparam Type Type of component.
+ */
+template<typename Type>
+inline constexpr bool component_track_changes_v = component_traits<std::remove_const_t<Type>>::track_changes;
+
+
+}
+
+
+#endif
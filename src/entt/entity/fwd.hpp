@@ -2,6 +2,7 @@
 #define ENTT_ENTITY_FWD_HPP
 
 
+#include <cstdint>
 #include "../core/fwd.hpp"
 
 
@@ -20,6 +21,14 @@ template<typename>
 class basic_runtime_view;
 
 
+template<typename, typename...>
+class basic_cached_view;
+
+
+template<typename>
+class basic_change_log;
+
+
 template<typename...>
 class basic_group;
 
@@ -28,6 +37,14 @@ template<typename>
 class basic_observer;
 
 
+template<typename>
+class basic_command_buffer;
+
+
+template<typename>
+class basic_organizer;
+
+
 template <typename>
 struct basic_actor;
 
@@ -48,10 +65,49 @@ template<typename>
 class basic_continuous_loader;
 
 
+/*! @brief Layout of the sparse arrays of sparse sets. */
+enum class sparse_policy: std::uint8_t {
+    /*! @brief Paged sparse array, direct access to the elements. */
+    paged,
+    /*! @brief Open addressing hash table, memory proportional to the size. */
+    hashed
+};
+
+
+/*! @brief Deletion policy of sparse sets. */
+enum class deletion_policy: std::uint8_t {
+    /*! @brief Swap-and-pop deletion policy, the packed array stays tight. */
+    swap_and_pop,
+    /*! @brief In-place deletion policy, holes are left in the packed array. */
+    in_place
+};
+
+
+/*! @brief Operations recorded by pools when statistics are enabled. */
+enum class pool_event: std::uint8_t {
+    /*! @brief Entities assigned to a pool. */
+    emplace,
+    /*! @brief Entities removed from a pool. */
+    erase,
+    /*! @brief Objects patched or replaced. */
+    patch,
+    /*! @brief Objects returned by entity through a registry. */
+    get,
+    /*! @brief Sparse pages allocated, copies of shared pages included. */
+    page,
+    /*! @brief Signals published to at least one listener. */
+    publish
+};
+
+
 /*! @brief Default entity identifier. */
 enum class entity: id_type {};
 
 
+/*! @brief Alias declaration for the type of the change ticks. */
+using tick_type = std::uint64_t;
+
+
 /*! @brief Alias declaration for the most common use case. */
 using registry = basic_registry<entity>;
 
@@ -60,6 +116,14 @@ using registry = basic_registry<entity>;
 using observer = basic_observer<entity>;
 
 
+/*! @brief Alias declaration for the most common use case. */
+using command_buffer = basic_command_buffer<entity>;
+
+
+/*! @brief Alias declaration for the most common use case. */
+using organizer = basic_organizer<entity>;
+
+
 /*! @brief Alias declaration for the most common use case. */
 using handle = basic_handle<entity>;
 
@@ -92,6 +156,18 @@ using view = basic_view<entity, Types...>;
 using runtime_view = basic_runtime_view<entity>;
 
 
+/**
+ * @brief Alias declaration for the most common use case.
+ * @tparam Types Types of components iterated by the cached view.
+ */
+template<typename... Types>
+using cached_view = basic_cached_view<entity, Types...>;
+
+
+/*! @brief Alias declaration for the most common use case. */
+using change_log = basic_change_log<entity>;
+
+
 /**
  * @brief Alias declaration for the most common use case.
  * @tparam Types Types of components iterated by the group.
@@ -3,10 +3,13 @@
 
 
 #include <tuple>
+#include <memory>
+#include <algorithm>
 #include <utility>
 #include <type_traits>
 #include "../config/config.h"
 #include "../core/type_traits.hpp"
+#include "component.hpp"
 #include "entity.hpp"
 #include "fwd.hpp"
 #include "pool.hpp"
@@ -71,6 +74,9 @@ class basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>> {
     template<typename Component>
     using pool_type = pool_t<Entity, Component>;
 
+    template<typename Component>
+    using reference_type = decltype(*std::declval<pool_type<Component> &>().begin());
+
     class group_proxy {
         friend class basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>>;
 
@@ -94,7 +100,7 @@ class basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>> {
             using pointer = void;
             using reference = decltype(std::tuple_cat(
                 std::declval<std::tuple<Entity>>(),
-                std::declval<std::conditional_t<is_eto_eligible_v<Get>, std::tuple<>, std::tuple<Get &>>>()...
+                std::declval<std::conditional_t<is_eto_eligible_v<Get>, std::tuple<>, std::tuple<reference_type<Get>>>>()...
             ));
             using iterator_category = std::input_iterator_tag;
 
@@ -162,13 +168,54 @@ class basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>> {
           pools{&gpool...}
     {}
 
+    template<typename Component>
+    [[nodiscard]] auto chunk_data(const Entity entt) const {
+        if constexpr(std::is_reference_v<reference_type<Component>>) {
+            return std::addressof(std::get<pool_type<Component> *>(pools)->get(entt));
+        } else {
+            // proxy references give access to the arrays of the data members
+            return std::get<pool_type<Component> *>(pools)->get(entt);
+        }
+    }
+
+    template<typename Component>
+    [[nodiscard]] std::size_t contiguous(const Entity entt) const {
+        const auto *cpool = std::get<pool_type<Component> *>(pools);
+        const auto pos = cpool->index(entt);
+
+        if constexpr(is_eto_eligible_v<Component> || component_page_size_v<Component> == 0u) {
+            return cpool->size() - pos;
+        } else {
+            // objects are contiguous only up to the end of the current page
+            return (std::min)(cpool->size() - pos, component_page_size_v<Component> - (pos & (component_page_size_v<Component> - 1u)));
+        }
+    }
+
     template<typename Func, typename... Weak>
-    void traverse(Func func, type_list<Weak...>) const {
-        for(const auto entt: *handler) {
+    void iterate(Func func, type_list<Weak...>) const {
+        const auto *first = handler->data();
+        const auto *last = first + handler->size();
+
+        while(first != last) {
+            const auto base = *(first++);
+            const auto chunk = (std::min)({ contiguous<Get>(base)... });
+            size_type length{1u};
+
+            for(; length < chunk && first != last
+                    && ((*(std::get<pool_type<Get> *>(pools)->data() + std::get<pool_type<Get> *>(pools)->index(base) + length) == *first) && ...);
+                ++length, ++first);
+
+            func(first - length, chunk_data<Weak>(base)..., length);
+        }
+    }
+
+    template<typename Func, typename... Weak>
+    void traverse(Func &func, const std::size_t from, const std::size_t to, type_list<Weak...>) const {
+        for(auto it = handler->begin() + from, last = handler->begin() + to; it != last; ++it) {
             if constexpr(std::is_invocable_v<Func, decltype(get<Weak>({}))...>) {
-                func(std::get<pool_type<Weak> *>(pools)->get(entt)...);
+                func(std::get<pool_type<Weak> *>(pools)->get(*it)...);
             } else {
-                func(entt, std::get<pool_type<Weak> *>(pools)->get(entt)...);
+                func(*it, std::get<pool_type<Weak> *>(pools)->get(*it)...);
             }
         }
     }
@@ -240,11 +287,15 @@ public:
      * Components are in the reverse order as returned by the `begin`/`end`
      * iterators.
      *
+     * @warning
+     * Paginated components aren't stored contiguously. A compilation error
+     * will occur if invoked for them, see `storage::pages` instead.
+     *
      * @tparam Component Type of component in which one is interested.
      * @return A pointer to the array of components.
      */
     template<typename Component>
-    [[nodiscard]] Component * raw() const ENTT_NOEXCEPT {
+    [[nodiscard]] auto raw() const ENTT_NOEXCEPT {
         return std::get<pool_type<Component> *>(pools)->raw();
     }
 
@@ -454,7 +505,90 @@ public:
     template<typename Func>
     void each(Func func) const {
         using get_type_list = type_list_cat_t<std::conditional_t<is_eto_eligible_v<Get>, type_list<>, type_list<Get>>...>;
-        traverse(std::move(func), get_type_list{});
+        traverse(func, 0u, handler->size(), get_type_list{});
+    }
+
+    /**
+     * @brief Iterates entities and components by means of an executor and
+     * applies the given function object to them.
+     *
+     * The entities of the group are split in chunks of the given size and each
+     * chunk is visited by a separate task. The executor is a function object
+     * that accepts a number of tasks and a task to run for each index in the
+     * range `[0, count)`. It must return only once all the tasks have
+     * completed. Its signature must be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(std::size_t count, Task task);
+     * @endcode
+     *
+     * The signature of the function is the same as for `each`. Within a chunk,
+     * entities are visited in the same order as for `each`. Chunks are the same
+     * no matter how many threads are available for a given chunk size.
+     *
+     * @sa each
+     * @sa thread_pool
+     *
+     * @warning
+     * The function object is invoked concurrently from different tasks.
+     * Creating or destroying entities and assigning or removing components
+     * from within the function object results in undefined behavior.
+     *
+     * @tparam Executor Type of executor.
+     * @tparam Func Type of the function object to invoke.
+     * @param executor A valid executor.
+     * @param func A valid function object.
+     * @param chunk Number of entities per chunk.
+     */
+    template<typename Executor, typename Func>
+    void each(Executor &&executor, Func func, const size_type chunk = ENTT_CHUNK_SIZE) const {
+        ENTT_ASSERT(chunk != 0u);
+        using get_type_list = type_list_cat_t<std::conditional_t<is_eto_eligible_v<Get>, type_list<>, type_list<Get>>...>;
+        (internal::prepare_concurrent_access<Get>(*std::get<pool_type<Get> *>(pools)), ...);
+        const auto length = handler->size();
+
+        executor((length + chunk - 1u) / chunk, [this, &func, length, chunk](const std::size_t task) {
+            traverse(func, task * chunk, (std::min)(length, (task + 1u) * chunk), get_type_list{});
+        });
+    }
+
+    /**
+     * @brief Chunked iteration for entities and components
+     *
+     * Chunked iteration returns the packed arrays of entities and components
+     * one chunk at a time along with their sizes, so that they can be visited
+     * by tight loops rather than through a function call per entity.<br/>
+     * The signature of the function must be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(const entity_type *, Type *..., size_type);
+     * @endcode
+     *
+     * The arguments are as follows:
+     *
+     * * A pointer to the entities belonging to the chunk.
+     * * Pointers to the components associated with the returned entities.
+     * * The length of the chunk.
+     *
+     * Note that the callback can be invoked 0 or more times and no guarantee is
+     * given on the order of the elements.<br/>
+     * Entities are returned in chunks as long as their components are laid out
+     * in the same order in all pools.<br/>
+     * Chunks never cross the boundaries of the pages of paginated components.
+     * Components laid out as structures of arrays (see `soa_storage`) are
+     * returned as proxies rather than pointers.
+     *
+     * @note
+     * Empty types aren't explicitly instantiated and therefore they are never
+     * returned during iterations.
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void chunked(Func func) const {
+        using get_type_list = type_list_cat_t<std::conditional_t<is_eto_eligible_v<Get>, type_list<>, type_list<Get>>...>;
+        iterate(std::move(func), get_type_list{});
     }
 
     /**
@@ -610,6 +744,9 @@ class basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>, Owned...> {
     template<typename Component>
     using component_iterator = decltype(std::declval<pool_type<Component>>().begin());
 
+    template<typename Component>
+    using reference_type = decltype(*std::declval<pool_type<Component> &>().begin());
+
     class group_proxy {
         friend class basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>, Owned...>;
 
@@ -636,8 +773,8 @@ class basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>, Owned...> {
             using pointer = void;
             using reference = decltype(std::tuple_cat(
                 std::declval<std::tuple<Entity>>(),
-                std::declval<std::conditional_t<is_eto_eligible_v<Owned>, std::tuple<>, std::tuple<Owned &>>>()...,
-                std::declval<std::conditional_t<is_eto_eligible_v<Get>, std::tuple<>, std::tuple<Get &>>>()...
+                std::declval<std::conditional_t<is_eto_eligible_v<Owned>, std::tuple<>, std::tuple<reference_type<Owned>>>>()...,
+                std::declval<std::conditional_t<is_eto_eligible_v<Get>, std::tuple<>, std::tuple<reference_type<Get>>>>()...
             ));
             using iterator_category = std::input_iterator_tag;
 
@@ -653,8 +790,8 @@ class basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>, Owned...> {
             [[nodiscard]] reference operator*() const ENTT_NOEXCEPT {
                 return std::tuple_cat(
                     std::make_tuple(*it),
-                    std::apply([](auto &&... curr) { return std::forward_as_tuple(*curr...); }, owned),
-                    std::apply([entt = *it](auto &&... curr) { return std::forward_as_tuple(curr->get(entt)...); }, get)
+                    std::apply([](auto &&... curr) { return std::tuple<decltype(*curr)...>{*curr...}; }, owned),
+                    std::apply([entt = *it](auto &&... curr) { return std::tuple<decltype(curr->get(entt))...>{curr->get(entt)...}; }, get)
                 );
             }
 
@@ -727,15 +864,65 @@ class basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>, Owned...> {
 
     basic_group(const std::size_t &extent, pool_type<Owned> &... opool, pool_type<Get> &... gpool) ENTT_NOEXCEPT
         : pools{&opool..., &gpool...},
-          length{&extent}
+          length{&extent},
+          handler{},
+          pending{},
+          partition{}
     {}
 
+    [[nodiscard]] bool fresh() const ENTT_NOEXCEPT {
+        // lazy groups partition their pools only when they are refreshed
+        return !pending || pending->empty();
+    }
+
+    template<typename Component>
+    [[nodiscard]] auto chunk_data(const Entity entt) const {
+        if constexpr(std::is_reference_v<reference_type<Component>>) {
+            return std::addressof(std::get<pool_type<Component> *>(pools)->get(entt));
+        } else {
+            // proxy references give access to the arrays of the data members
+            return std::get<pool_type<Component> *>(pools)->get(entt);
+        }
+    }
+
+    template<typename Component>
+    [[nodiscard]] std::size_t contiguous(const Entity entt) const {
+        const auto *cpool = std::get<pool_type<Component> *>(pools);
+        const auto pos = cpool->index(entt);
+
+        if constexpr(is_eto_eligible_v<Component> || component_page_size_v<Component> == 0u) {
+            return cpool->size() - pos;
+        } else {
+            // objects are contiguous only up to the end of the current page
+            return (std::min)(cpool->size() - pos, component_page_size_v<Component> - (pos & (component_page_size_v<Component> - 1u)));
+        }
+    }
+
+    template<typename Func, typename... Strong, typename... Weak>
+    void iterate(Func func, type_list<Strong...>, type_list<Weak...>) const {
+        const auto *data = std::get<0>(pools)->data();
+
+        for(size_type pos{}; pos < *length;) {
+            const auto base = data[pos];
+            const auto chunk = (std::min)({ *length - pos, contiguous<Owned>(base)..., contiguous<Get>(base)... });
+            size_type count{1u};
+
+            for(; count < chunk
+                    && ((*(std::get<pool_type<Get> *>(pools)->data() + std::get<pool_type<Get> *>(pools)->index(base) + count) == data[pos + count]) && ...);
+                ++count);
+
+            func(data + pos, chunk_data<Strong>(base)..., chunk_data<Weak>(base)..., count);
+            pos += count;
+        }
+    }
+
     template<typename Func, typename... Strong, typename... Weak>
-    void traverse(Func func, type_list<Strong...>, type_list<Weak...>) const {
-        [[maybe_unused]] auto it = std::make_tuple((std::get<pool_type<Strong> *>(pools)->end() - *length)...);
-        [[maybe_unused]] auto data = std::get<0>(pools)->sparse_set<entity_type>::end() - *length;
+    void traverse(Func &func, const std::size_t from, const std::size_t to, type_list<Strong...>, type_list<Weak...>) const {
+        // owned pools share the same layout, positions are the same for all of them
+        [[maybe_unused]] auto it = std::make_tuple((std::get<pool_type<Strong> *>(pools)->end() - (*length - from))...);
+        [[maybe_unused]] auto data = std::get<0>(pools)->sparse_set<entity_type>::end() - (*length - from);
 
-        for(auto next = *length; next; --next) {
+        for(auto next = to - from; next; --next) {
             if constexpr(std::is_invocable_v<Func, decltype(get<Strong>({}))..., decltype(get<Weak>({}))...>) {
                 if constexpr(sizeof...(Weak) == 0) {
                     func(*(std::get<component_iterator<Strong>>(it)++)...);
@@ -760,6 +947,25 @@ public:
     /*! @brief Reversed iterator type. */
     using reverse_iterator = typename sparse_set<Entity>::reverse_iterator;
 
+    /**
+     * @brief Partitions the owned pools of a lazy group, if required.
+     *
+     * Lazy groups record the entities that changed and arrange their pools
+     * only when refreshed, either explicitly or when they're requested again
+     * to the registry. This function does nothing for all the other groups.
+     *
+     * @warning
+     * Lazy groups must be refreshed after their pools change and before using
+     * them.<br/>
+     * An assertion will abort the execution at runtime in debug mode if a lazy
+     * group is used while it has pending changes.
+     */
+    void refresh() {
+        if(partition) {
+            partition(handler);
+        }
+    }
+
     /**
      * @brief Returns the number of existing components of the given type.
      * @tparam Component Type of component of which to return the size.
@@ -775,6 +981,7 @@ public:
      * @return Number of entities that have the given components.
      */
     [[nodiscard]] size_type size() const ENTT_NOEXCEPT {
+        ENTT_ASSERT(fresh());
         return *length;
     }
 
@@ -786,6 +993,7 @@ public:
     template<typename... Component>
     [[nodiscard]] bool empty() const ENTT_NOEXCEPT {
         if constexpr(sizeof...(Component) == 0) {
+            ENTT_ASSERT(fresh());
             return !*length;
         } else {
             return (std::get<pool_type<Component> *>(pools)->empty() && ...);
@@ -806,11 +1014,16 @@ public:
      * Components are in the reverse order as returned by the `begin`/`end`
      * iterators.
      *
+     * @warning
+     * Paginated components aren't stored contiguously. A compilation error
+     * will occur if invoked for them, see `storage::pages` instead.
+     *
      * @tparam Component Type of component in which one is interested.
      * @return A pointer to the array of components.
      */
     template<typename Component>
-    [[nodiscard]] Component * raw() const ENTT_NOEXCEPT {
+    [[nodiscard]] auto raw() const ENTT_NOEXCEPT {
+        ENTT_ASSERT(fresh());
         return std::get<pool_type<Component> *>(pools)->raw();
     }
 
@@ -833,6 +1046,7 @@ public:
      */
     template<typename Component>
     [[nodiscard]] const entity_type * data() const ENTT_NOEXCEPT {
+        ENTT_ASSERT(fresh());
         return std::get<pool_type<Component> *>(pools)->data();
     }
 
@@ -849,6 +1063,7 @@ public:
      * @return A pointer to the array of entities.
      */
     [[nodiscard]] const entity_type * data() const ENTT_NOEXCEPT {
+        ENTT_ASSERT(fresh());
         return std::get<0>(pools)->data();
     }
 
@@ -865,6 +1080,7 @@ public:
      * @return An iterator to the first entity of the group.
      */
     [[nodiscard]] iterator begin() const ENTT_NOEXCEPT {
+        ENTT_ASSERT(fresh());
         return std::get<0>(pools)->sparse_set<entity_type>::end() - *length;
     }
 
@@ -883,6 +1099,7 @@ public:
      * group.
      */
     [[nodiscard]] iterator end() const ENTT_NOEXCEPT {
+        ENTT_ASSERT(fresh());
         return std::get<0>(pools)->sparse_set<entity_type>::end();
     }
 
@@ -899,6 +1116,7 @@ public:
      * @return An iterator to the first entity of the reversed group.
      */
     [[nodiscard]] reverse_iterator rbegin() const ENTT_NOEXCEPT {
+        ENTT_ASSERT(fresh());
         return std::get<0>(pools)->sparse_set<entity_type>::rbegin();
     }
 
@@ -918,6 +1136,7 @@ public:
      * reversed group.
      */
     [[nodiscard]] reverse_iterator rend() const ENTT_NOEXCEPT {
+        ENTT_ASSERT(fresh());
         return std::get<0>(pools)->sparse_set<entity_type>::rbegin() + *length;
     }
 
@@ -967,6 +1186,7 @@ public:
      * @return True if the group contains the given entity, false otherwise.
      */
     [[nodiscard]] bool contains(const entity_type entt) const {
+        ENTT_ASSERT(fresh());
         return std::get<0>(pools)->contains(entt) && (std::get<0>(pools)->index(entt) < (*length));
     }
 
@@ -1024,7 +1244,98 @@ public:
     void each(Func func) const {
         using owned_type_list = type_list_cat_t<std::conditional_t<is_eto_eligible_v<Owned>, type_list<>, type_list<Owned>>...>;
         using get_type_list = type_list_cat_t<std::conditional_t<is_eto_eligible_v<Get>, type_list<>, type_list<Get>>...>;
-        traverse(std::move(func), owned_type_list{}, get_type_list{});
+        ENTT_ASSERT(fresh());
+        traverse(func, 0u, *length, owned_type_list{}, get_type_list{});
+    }
+
+    /**
+     * @brief Iterates entities and components by means of an executor and
+     * applies the given function object to them.
+     *
+     * The entities of the group are split in chunks of the given size and each
+     * chunk is visited by a separate task. Chunks refer to the same positions
+     * in all the owned pools, since they share the same layout.<br/>
+     * The executor is a function object that accepts a number of tasks and a
+     * task to run for each index in the range `[0, count)`. It must return
+     * only once all the tasks have completed. Its signature must be equivalent
+     * to the following:
+     *
+     * @code{.cpp}
+     * void(std::size_t count, Task task);
+     * @endcode
+     *
+     * The signature of the function is the same as for `each`. Within a chunk,
+     * entities are visited in the same order as for `each`. Chunks are the same
+     * no matter how many threads are available for a given chunk size.
+     *
+     * @sa each
+     * @sa thread_pool
+     *
+     * @warning
+     * The function object is invoked concurrently from different tasks.
+     * Creating or destroying entities and assigning or removing components
+     * from within the function object results in undefined behavior.
+     *
+     * @tparam Executor Type of executor.
+     * @tparam Func Type of the function object to invoke.
+     * @param executor A valid executor.
+     * @param func A valid function object.
+     * @param chunk Number of entities per chunk.
+     */
+    template<typename Executor, typename Func>
+    void each(Executor &&executor, Func func, const size_type chunk = ENTT_CHUNK_SIZE) const {
+        ENTT_ASSERT(chunk != 0u);
+        using owned_type_list = type_list_cat_t<std::conditional_t<is_eto_eligible_v<Owned>, type_list<>, type_list<Owned>>...>;
+        using get_type_list = type_list_cat_t<std::conditional_t<is_eto_eligible_v<Get>, type_list<>, type_list<Get>>...>;
+        (internal::prepare_concurrent_access<Owned>(*std::get<pool_type<Owned> *>(pools)), ...);
+        (internal::prepare_concurrent_access<Get>(*std::get<pool_type<Get> *>(pools)), ...);
+        ENTT_ASSERT(fresh());
+        const auto count = *length;
+
+        executor((count + chunk - 1u) / chunk, [this, &func, count, chunk](const std::size_t task) {
+            traverse(func, task * chunk, (std::min)(count, (task + 1u) * chunk), owned_type_list{}, get_type_list{});
+        });
+    }
+
+    /**
+     * @brief Chunked iteration for entities and components
+     *
+     * Chunked iteration returns the packed arrays of entities and components
+     * one chunk at a time along with their sizes, so that they can be visited
+     * by tight loops rather than through a function call per entity.<br/>
+     * The signature of the function must be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(const entity_type *, Type *..., size_type);
+     * @endcode
+     *
+     * The arguments are as follows:
+     *
+     * * A pointer to the entities belonging to the chunk.
+     * * Pointers to the components associated with the returned entities.
+     * * The length of the chunk.
+     *
+     * Note that the callback can be invoked 0 or more times and no guarantee is
+     * given on the order of the elements.<br/>
+     * Owned components are tightly packed, therefore the whole group is returned
+     * as a single chunk as long as it doesn't observe other components.<br/>
+     * Chunks never cross the boundaries of the pages of paginated components.
+     * Components laid out as structures of arrays (see `soa_storage`) are
+     * returned as proxies rather than pointers.
+     *
+     * @note
+     * Empty types aren't explicitly instantiated and therefore they are never
+     * returned during iterations.
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void chunked(Func func) const {
+        using owned_type_list = type_list_cat_t<std::conditional_t<is_eto_eligible_v<Owned>, type_list<>, type_list<Owned>>...>;
+        using get_type_list = type_list_cat_t<std::conditional_t<is_eto_eligible_v<Get>, type_list<>, type_list<Get>>...>;
+        ENTT_ASSERT(fresh());
+        iterate(std::move(func), owned_type_list{}, get_type_list{});
     }
 
     /**
@@ -1041,6 +1352,7 @@ public:
      * @return An iterable object to use to _visit_ the group.
      */
     [[nodiscard]] auto proxy() const ENTT_NOEXCEPT {
+        ENTT_ASSERT(fresh());
         return group_proxy{pools, *length};
     }
 
@@ -1084,6 +1396,7 @@ public:
     template<typename... Component, typename Compare, typename Sort = std_sort, typename... Args>
     void sort(Compare compare, Sort algo = Sort{}, Args &&... args) {
         auto *cpool = std::get<0>(pools);
+        refresh();
 
         if constexpr(sizeof...(Component) == 0) {
             static_assert(std::is_invocable_v<Compare, const entity_type, const entity_type>, "Invalid comparison function");
@@ -1110,6 +1423,9 @@ public:
 private:
     const std::tuple<pool_type<Owned> *..., pool_type<Get> *...> pools;
     const size_type *length;
+    void *handler;
+    const sparse_set<Entity> *pending;
+    void(* partition)(void *);
 };
 
 
@@ -2,10 +2,14 @@
 #define ENTT_ENTITY_HELPER_HPP
 
 
+#include <cstddef>
+#include <functional>
 #include <type_traits>
 #include "../config/config.h"
 #include "../core/type_traits.hpp"
 #include "../signal/delegate.hpp"
+#include "component.hpp"
+#include "entity.hpp"
 #include "registry.hpp"
 #include "fwd.hpp"
 
@@ -131,6 +135,12 @@ void invoke(basic_registry<Entity> &reg, const Entity entt) {
 
 /**
  * @brief Returns the entity associated with a given component.
+ *
+ * @warning
+ * In case of paginated components, the lookup is linear in the number of pages
+ * and the null entity is returned if the component doesn't belong to the
+ * registry.
+ *
  * @tparam Entity A valid entity type (see entt_traits for more details).
  * @tparam Component Type of component.
  * @param reg A registry that contains the given entity and its components.
@@ -139,7 +149,20 @@ void invoke(basic_registry<Entity> &reg, const Entity entt) {
  */
 template<typename Entity, typename Component>
 Entity to_entity(const basic_registry<Entity> &reg, const Component &component) {
-    return *(reg.template data<Component>() + (&component - reg.template raw<Component>()));
+    if constexpr(component_page_size_v<Component> == 0u) {
+        return *(reg.template data<Component>() + (&component - reg.template raw<Component>()));
+    } else {
+        constexpr auto page_size = component_page_size_v<Component>;
+        const auto *pages = reg.template pages<Component>();
+
+        for(std::size_t pos{}, last = reg.template size<Component>(); pos < last; pos += page_size) {
+            if(const auto *page = pages[pos / page_size]; !std::less{}(&component, page) && std::less{}(&component, page + page_size)) {
+                return *(reg.template data<Component>() + pos + (&component - page));
+            }
+        }
+
+        return null;
+    }
 }
 
 
@@ -0,0 +1,353 @@
+#ifndef ENTT_ENTITY_MULTI_STORAGE_HPP
+#define ENTT_ENTITY_MULTI_STORAGE_HPP
+
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../config/config.h"
+#include "../core/algorithm.hpp"
+#include "../core/type_traits.hpp"
+#include "component.hpp"
+#include "entity.hpp"
+#include "sparse_set.hpp"
+
+
+namespace entt {
+
+
+/**
+ * @brief Multi-type storage implementation.
+ *
+ * Objects of different types that are always assigned to and removed from
+ * entities together share a single sparse set, rather than paying for a sparse
+ * set each. Objects of the same type are stored in their own contiguous array
+ * (column layout), in the same order of the entities.<br/>
+ * Registries recognize these storage classes when the pools of all the types
+ * are specialized so as to share them (see `multi_pool`).
+ *
+ * @note
+ * Sparse and deletion policies are those of the first type.
+ *
+ * @warning
+ * Empty types, paginated types and types that track changes aren't
+ * supported.
+ *
+ * @sa storage
+ *
+ * @tparam Entity A valid entity type (see entt_traits for more details).
+ * @tparam Type Types of objects assigned to the entities.
+ */
+template<typename Entity, typename... Type>
+class multi_storage: public sparse_set<Entity> {
+    static_assert(sizeof...(Type) != 0u, "At least one type is required");
+    static_assert(std::is_same_v<type_list<Type...>, type_list_unique_t<type_list<Type...>>>, "Types must be unique");
+    static_assert(((std::is_same_v<Type, std::decay_t<Type>> && !is_eto_eligible_v<Type>) && ...), "Invalid object type");
+    static_assert(((component_page_size_v<Type> == 0u) && ...), "Paginated objects aren't supported");
+    static_assert(!(component_track_changes_v<Type> || ...), "Change ticks aren't supported");
+
+    using first_type = std::tuple_element_t<0u, std::tuple<Type...>>;
+    using underlying_type = sparse_set<Entity>;
+    using alloc_traits = std::allocator_traits<typename underlying_type::allocator_type>;
+
+    static constexpr auto layout = component_traits<first_type>::sparse;
+
+    template<typename Comp>
+    using column_type = std::vector<Comp, typename alloc_traits::template rebind_alloc<Comp>>;
+
+    template<typename Func>
+    void visit(Func func) {
+        std::apply([&func](auto &... column) { (func(column), ...); }, columns);
+    }
+
+protected:
+    /**
+     * @copybrief underlying_type::move_element
+     * @param from Position of the element to move.
+     * @param to Position in which to move the element.
+     */
+    void move_element(const std::size_t from, const std::size_t to) override {
+        visit([from, to](auto &column) { column[to] = std::move(column[from]); });
+    }
+
+    /**
+     * @copybrief underlying_type::truncate
+     * @param length Number of elements to keep.
+     */
+    void truncate(const std::size_t length) override {
+        visit([length](auto &column) { column.erase(column.begin() + length, column.end()); });
+    }
+
+public:
+    /*! @brief Allocator type. */
+    using allocator_type = typename underlying_type::allocator_type;
+    /*! @brief Underlying entity identifier. */
+    using entity_type = Entity;
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+
+    /*! @brief Default constructor. */
+    multi_storage()
+        : multi_storage{allocator_type{}}
+    {}
+
+    /**
+     * @brief Constructs an empty storage with a given allocator.
+     * @param alloc Allocator to use for all memory allocations.
+     */
+    explicit multi_storage(const allocator_type &alloc)
+        : underlying_type{component_traits<first_type>::sparse, component_traits<first_type>::deletion, alloc},
+          columns{column_type<Type>{typename column_type<Type>::allocator_type{alloc}}...}
+    {}
+
+    /**
+     * @brief Forks a storage.
+     *
+     * Pages of the sparse array are shared between the two storage classes and
+     * copied only when either of them modifies them for the first time. The
+     * objects are always copied.
+     *
+     * @param other The instance to fork.
+     */
+    multi_storage(multi_storage &other, fork_t)
+        : underlying_type{other, fork_t{}},
+          columns{other.columns}
+    {}
+
+    /**
+     * @brief Increases the capacity of a storage.
+     *
+     * If the new capacity is greater than the current capacity, new storage is
+     * allocated, otherwise the method does nothing.
+     *
+     * @param cap Desired capacity.
+     */
+    void reserve(const size_type cap) {
+        underlying_type::reserve(cap);
+        visit([cap](auto &column) { column.reserve(cap); });
+    }
+
+    /*! @brief Requests the removal of unused capacity. */
+    void shrink_to_fit() {
+        underlying_type::shrink_to_fit();
+        visit([](auto &column) { column.shrink_to_fit(); });
+    }
+
+    /**
+     * @brief Direct access to the array of objects of a given type.
+     *
+     * The returned pointer is such that range `[raw<Comp>(), raw<Comp>() +
+     * size())` is always a valid range, even if the container is empty.
+     *
+     * @note
+     * Objects are in the reverse order as returned by the `begin`/`end`
+     * iterators of the sparse set.
+     *
+     * @tparam Comp Type of objects to return.
+     * @return A pointer to the array of objects.
+     */
+    template<typename Comp>
+    [[nodiscard]] const Comp * raw() const ENTT_NOEXCEPT {
+        return std::get<column_type<Comp>>(columns).data();
+    }
+
+    /*! @copydoc raw */
+    template<typename Comp>
+    [[nodiscard]] Comp * raw() ENTT_NOEXCEPT {
+        return std::get<column_type<Comp>>(columns).data();
+    }
+
+    /**
+     * @brief Returns the objects of the given types for an entity.
+     *
+     * @warning
+     * Attempting to use an entity that doesn't belong to the storage results in
+     * undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * storage doesn't contain the given entity.
+     *
+     * @tparam Comp Types of objects to return.
+     * @param entt A valid entity identifier.
+     * @return References to the objects associated with the entity.
+     */
+    template<typename... Comp>
+    [[nodiscard]] decltype(auto) get(const entity_type entt) const {
+        if constexpr(sizeof...(Comp) == 1u) {
+            return (std::get<column_type<Comp>>(columns)[underlying_type::template index<layout>(entt)], ...);
+        } else {
+            const auto pos = underlying_type::template index<layout>(entt);
+            return std::tuple<const Comp &...>{std::get<column_type<Comp>>(columns)[pos]...};
+        }
+    }
+
+    /*! @copydoc get */
+    template<typename... Comp>
+    [[nodiscard]] decltype(auto) get(const entity_type entt) {
+        if constexpr(sizeof...(Comp) == 1u) {
+            return (const_cast<Comp &>(std::as_const(*this).template get<Comp>(entt)), ...);
+        } else {
+            const auto pos = underlying_type::template index<layout>(entt);
+            return std::tuple<Comp &...>{std::get<column_type<Comp>>(columns)[pos]...};
+        }
+    }
+
+    /**
+     * @brief Returns a pointer to the object of the given type for an entity.
+     * @tparam Comp Type of object to return.
+     * @param entt A valid entity identifier.
+     * @return The object associated with the entity, if any.
+     */
+    template<typename Comp>
+    [[nodiscard]] const Comp * try_get(const entity_type entt) const {
+        return underlying_type::template contains<layout>(entt) ? std::addressof(get<Comp>(entt)) : nullptr;
+    }
+
+    /*! @copydoc try_get */
+    template<typename Comp>
+    [[nodiscard]] Comp * try_get(const entity_type entt) {
+        return const_cast<Comp *>(std::as_const(*this).template try_get<Comp>(entt));
+    }
+
+    /**
+     * @brief Assigns an entity to a storage and constructs its objects.
+     *
+     * @warning
+     * Attempting to use an entity that already belongs to the storage results
+     * in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * storage already contains the given entity.
+     *
+     * @param entt A valid entity identifier.
+     * @param value The objects to assign to the entity, one for each type.
+     */
+    void emplace(const entity_type entt, Type... value) {
+        const auto length = underlying_type::size();
+        reserve(length + 1u);
+
+        try {
+            (std::get<column_type<Type>>(columns).push_back(std::move(value)), ...);
+            // entity goes after objects in case constructors throw
+            underlying_type::template emplace<layout>(entt);
+        } catch(...) {
+            // columns that already grew are brought back in sync with the packed array
+            truncate(length);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Assigns one or more entities to a storage and constructs their
+     * objects from the given instances.
+     *
+     * @warning
+     * Attempting to assign an entity that already belongs to the storage
+     * results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * storage already contains the given entity.
+     *
+     * @tparam It Type of input iterator.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     * @param value The objects to copy for each entity, one for each type.
+     */
+    template<typename It>
+    void insert(It first, It last, const Type &... value) {
+        const auto length = underlying_type::size();
+        const auto count = static_cast<size_type>(std::distance(first, last));
+        reserve(length + count);
+
+        try {
+            (std::get<column_type<Type>>(columns).insert(std::get<column_type<Type>>(columns).end(), count, value), ...);
+        } catch(...) {
+            truncate(length);
+            throw;
+        }
+
+        // entities go after objects in case constructors throw
+        underlying_type::template insert<layout>(first, last);
+    }
+
+    /**
+     * @brief Swaps entities and objects in the internal packed arrays.
+     *
+     * @warning
+     * Attempting to swap entities that don't belong to the sparse set results
+     * in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * sparse set doesn't contain the given entities.
+     *
+     * @param lhs A valid entity identifier.
+     * @param rhs A valid entity identifier.
+     */
+    void swap(const entity_type lhs, const entity_type rhs) override {
+        const auto from = underlying_type::template index<layout>(lhs);
+        const auto to = underlying_type::template index<layout>(rhs);
+        visit([from, to](auto &column) { std::swap(column[from], column[to]); });
+        underlying_type::swap(lhs, rhs);
+    }
+
+    /**
+     * @brief Sort entities and objects according to the given comparison
+     * function.
+     *
+     * @sa sparse_set::sort
+     *
+     * The comparison function object receives two entities and the objects of
+     * all the types follow them.
+     *
+     * @warning
+     * Storage classes that delete in-place must be compacted before sorting
+     * them.
+     *
+     * @tparam Compare Type of comparison function object.
+     * @tparam Sort Type of sort function object.
+     * @tparam Args Types of arguments to forward to the sort function object.
+     * @param first An iterator to the first element of the range to sort.
+     * @param last An iterator past the last element of the range to sort.
+     * @param compare A valid comparison function object.
+     * @param algo A valid sort function object.
+     * @param args Arguments to forward to the sort function object, if any.
+     */
+    template<typename Compare, typename Sort = std_sort, typename... Args>
+    void sort(typename underlying_type::iterator first, typename underlying_type::iterator last, Compare compare, Sort algo = Sort{}, Args &&... args) {
+        underlying_type::arrange(first, last, [this](const auto lhs, const auto rhs) {
+            const auto pos = underlying_type::template index<layout>(lhs);
+            const auto other = underlying_type::template index<layout>(rhs);
+            visit([pos, other](auto &column) { std::swap(column[pos], column[other]); });
+        }, std::move(compare), std::move(algo), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Returns the memory footprint of a storage.
+     * @return The memory footprint of the storage.
+     */
+    [[nodiscard]] pool_footprint footprint() const override {
+        auto info = underlying_type::footprint();
+
+        std::apply([&info](const auto &... column) {
+            ((info.instances += column.size() * sizeof(typename std::decay_t<decltype(column)>::value_type)), ...);
+            ((info.reserved += column.capacity() * sizeof(typename std::decay_t<decltype(column)>::value_type)), ...);
+        }, columns);
+
+        return info;
+    }
+
+    /*! @brief Clears a storage. */
+    void clear() {
+        underlying_type::clear();
+        visit([](auto &column) { column.clear(); });
+    }
+
+private:
+    std::tuple<column_type<Type>...> columns;
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,489 @@
+#ifndef ENTT_ENTITY_ORGANIZER_HPP
+#define ENTT_ENTITY_ORGANIZER_HPP
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../config/config.h"
+#include "../core/fwd.hpp"
+#include "../core/type_info.hpp"
+#include "../core/type_traits.hpp"
+#include "fwd.hpp"
+#include "helper.hpp"
+#include "registry.hpp"
+
+
+namespace entt {
+
+
+/**
+ * @cond TURN_OFF_DOXYGEN
+ * Internal details not to be documented.
+ */
+
+
+namespace internal {
+
+
+template<typename Type, typename Entity>
+struct resource_traits {
+    using ro = std::conditional_t<std::is_const_v<Type>, type_list<std::remove_const_t<Type>>, type_list<>>;
+    using rw = std::conditional_t<std::is_const_v<Type>, type_list<>, type_list<Type>>;
+    static constexpr bool ro_all = false;
+    static constexpr bool rw_all = false;
+
+    static void prepare(basic_registry<Entity> &) {}
+
+    [[nodiscard]] static Type & get(basic_registry<Entity> &owner) {
+        return owner.template ctx<std::remove_const_t<Type>>();
+    }
+};
+
+
+template<typename Entity>
+struct resource_traits<basic_registry<Entity>, Entity> {
+    using ro = type_list<>;
+    using rw = type_list<>;
+    static constexpr bool ro_all = false;
+    static constexpr bool rw_all = true;
+
+    static void prepare(basic_registry<Entity> &) {}
+
+    [[nodiscard]] static basic_registry<Entity> & get(basic_registry<Entity> &owner) {
+        return owner;
+    }
+};
+
+
+template<typename Entity>
+struct resource_traits<const basic_registry<Entity>, Entity> {
+    using ro = type_list<>;
+    using rw = type_list<>;
+    static constexpr bool ro_all = true;
+    static constexpr bool rw_all = false;
+
+    static void prepare(basic_registry<Entity> &) {}
+
+    [[nodiscard]] static const basic_registry<Entity> & get(basic_registry<Entity> &owner) {
+        return owner;
+    }
+};
+
+
+template<typename Entity, typename... Exclude, typename... Component>
+struct resource_traits<basic_view<Entity, exclude_t<Exclude...>, Component...>, Entity> {
+    using ro = type_list_cat_t<type_list<Exclude...>, typename resource_traits<Component, Entity>::ro...>;
+    using rw = type_list_cat_t<typename resource_traits<Component, Entity>::rw...>;
+    static constexpr bool ro_all = false;
+    static constexpr bool rw_all = false;
+
+    static void prepare(basic_registry<Entity> &owner) {
+        static_cast<void>(owner.template view<Component...>(exclude<Exclude...>));
+    }
+
+    [[nodiscard]] static as_view<false, Entity> get(basic_registry<Entity> &owner) {
+        return as_view{owner};
+    }
+};
+
+
+template<typename Entity, typename... Exclude, typename... Get, typename... Owned>
+struct resource_traits<basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>, Owned...>, Entity> {
+    using ro = type_list_cat_t<type_list<Exclude...>, typename resource_traits<Owned, Entity>::ro..., typename resource_traits<Get, Entity>::ro...>;
+    using rw = type_list_cat_t<typename resource_traits<Owned, Entity>::rw..., typename resource_traits<Get, Entity>::rw...>;
+    static constexpr bool ro_all = false;
+    static constexpr bool rw_all = false;
+
+    static void prepare(basic_registry<Entity> &owner) {
+        static_cast<void>(owner.template group<Owned...>(entt::get<Get...>, exclude<Exclude...>));
+    }
+
+    [[nodiscard]] static as_group<false, Entity> get(basic_registry<Entity> &owner) {
+        return as_group{owner};
+    }
+};
+
+
+template<typename Entity, typename... Type>
+struct resource_traits<const basic_view<Entity, Type...>, Entity>: resource_traits<basic_view<Entity, Type...>, Entity> {};
+
+
+template<typename Entity, typename... Type>
+struct resource_traits<const basic_group<Entity, Type...>, Entity>: resource_traits<basic_group<Entity, Type...>, Entity> {};
+
+
+template<typename Ret, typename... Args>
+type_list<Args...> function_arguments(Ret(*)(Args...));
+
+
+template<typename Ret, typename Class, typename... Args>
+type_list<Args...> function_arguments(Ret(Class:: *)(Args...));
+
+
+template<typename Ret, typename Class, typename... Args>
+type_list<Args...> function_arguments(Ret(Class:: *)(Args...) const);
+
+
+}
+
+
+/**
+ * Internal details not to be documented.
+ * @endcond TURN_OFF_DOXYGEN
+ */
+
+
+/**
+ * @brief Utility class for creating an execution graph of systems.
+ *
+ * Systems are functions or member functions that declare what they access by
+ * means of their arguments:
+ *
+ * * Views and groups, where constant components are read and all the other
+ *   components are written. Excluded components are read.
+ * * Constant references to registries, that read all the components.
+ * * References to registries, that write all the components and therefore
+ *   never run along with other systems.
+ * * References to any other type, that are context variables of the registry
+ *   and are read or written according to their constness.
+ *
+ * Two systems conflict if one of them writes a type that the other one either
+ * reads or writes. Conflicting systems run in the order in which they were
+ * added to the organizer, while all the others can run concurrently.
+ *
+ * @tparam Entity A valid entity type (see entt_traits for more details).
+ */
+template<typename Entity>
+class basic_organizer {
+    using callback_type = void(const void *, basic_registry<Entity> &);
+    using prepare_type = void(basic_registry<Entity> &);
+
+    struct system_data {
+        const char *name;
+        const void *payload;
+        callback_type *callback;
+        prepare_type *prepare;
+        std::vector<id_type> ro;
+        std::vector<id_type> rw;
+        bool ro_all;
+        bool rw_all;
+    };
+
+    template<typename... Type>
+    [[nodiscard]] static std::vector<id_type> to_ids(type_list<Type...>) {
+        std::vector<id_type> ids{type_info<Type>::id()...};
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return ids;
+    }
+
+    [[nodiscard]] static bool overlap(const std::vector<id_type> &lhs, const std::vector<id_type> &rhs) {
+        return std::any_of(lhs.cbegin(), lhs.cend(), [&rhs](const auto id) { return std::binary_search(rhs.cbegin(), rhs.cend(), id); });
+    }
+
+    [[nodiscard]] static bool conflicts(const system_data &lhs, const system_data &rhs) {
+        return lhs.rw_all || rhs.rw_all
+            || (lhs.ro_all && !rhs.rw.empty()) || (rhs.ro_all && !lhs.rw.empty())
+            || overlap(lhs.rw, rhs.rw) || overlap(lhs.rw, rhs.ro) || overlap(lhs.ro, rhs.rw);
+    }
+
+    template<typename... Type>
+    void track(const char *name, const void *payload, callback_type *callback, type_list<Type...>) {
+        using ro_type = type_list_cat_t<typename internal::resource_traits<Type, Entity>::ro...>;
+        using rw_type = type_list_cat_t<typename internal::resource_traits<Type, Entity>::rw...>;
+
+        system_data data{
+            name,
+            payload,
+            callback,
+            +[]([[maybe_unused]] basic_registry<Entity> &owner) { (internal::resource_traits<Type, Entity>::prepare(owner), ...); },
+            to_ids(ro_type{}),
+            to_ids(rw_type{}),
+            (internal::resource_traits<Type, Entity>::ro_all || ...),
+            (internal::resource_traits<Type, Entity>::rw_all || ...)
+        };
+
+        // types that are also written aren't read only
+        data.ro.erase(std::remove_if(data.ro.begin(), data.ro.end(), [&data](const auto id) { return std::binary_search(data.rw.cbegin(), data.rw.cend(), id); }), data.ro.end());
+        systems.push_back(std::move(data));
+        vertices.clear();
+    }
+
+    template<typename Type>
+    [[nodiscard]] static decltype(auto) resource(basic_registry<Entity> &owner) {
+        return internal::resource_traits<std::remove_reference_t<Type>, Entity>::get(owner);
+    }
+
+    template<typename... Args>
+    [[nodiscard]] static auto to_resources(type_list<Args...>) {
+        return type_list<std::remove_reference_t<Args>...>{};
+    }
+
+public:
+    /*! @brief Underlying entity identifier. */
+    using entity_type = Entity;
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+    /*! @brief Raw type of the function of a system. */
+    using function_type = callback_type;
+
+    /*! @brief Vertex of an execution graph. */
+    class vertex {
+        friend class basic_organizer;
+
+    public:
+        /**
+         * @brief Returns the name assigned to the system, if any.
+         * @return The name of the system, if any.
+         */
+        [[nodiscard]] const char * name() const ENTT_NOEXCEPT {
+            return system->name;
+        }
+
+        /**
+         * @brief Returns the function of the system.
+         * @return The function of the system.
+         */
+        [[nodiscard]] function_type * callback() const ENTT_NOEXCEPT {
+            return system->callback;
+        }
+
+        /**
+         * @brief Returns the payload passed to the function of the system.
+         * @return The payload of the system, if any.
+         */
+        [[nodiscard]] const void * data() const ENTT_NOEXCEPT {
+            return system->payload;
+        }
+
+        /**
+         * @brief Returns the number of types read by the system.
+         * @return Number of types read by the system.
+         */
+        [[nodiscard]] size_type ro_count() const ENTT_NOEXCEPT {
+            return system->ro.size();
+        }
+
+        /**
+         * @brief Returns the number of types written by the system.
+         * @return Number of types written by the system.
+         */
+        [[nodiscard]] size_type rw_count() const ENTT_NOEXCEPT {
+            return system->rw.size();
+        }
+
+        /**
+         * @brief Checks whether a system doesn't depend on any other system.
+         * @return True if the system has no parents, false otherwise.
+         */
+        [[nodiscard]] bool top_level() const ENTT_NOEXCEPT {
+            return !parents;
+        }
+
+        /**
+         * @brief Returns the number of systems that run before this one.
+         * @return Number of systems that run immediately before this one.
+         */
+        [[nodiscard]] size_type in_degree() const ENTT_NOEXCEPT {
+            return parents;
+        }
+
+        /**
+         * @brief Returns the systems that run after this one.
+         * @return Positions of the systems that depend on this one.
+         */
+        [[nodiscard]] const std::vector<size_type> & children() const ENTT_NOEXCEPT {
+            return edges;
+        }
+
+        /**
+         * @brief Creates the pools and groups used by the system, if required.
+         * @param owner A valid registry.
+         */
+        void prepare(basic_registry<entity_type> &owner) const {
+            system->prepare(owner);
+        }
+
+    private:
+        const system_data *system{};
+        std::vector<size_type> edges{};
+        size_type parents{};
+    };
+
+    /**
+     * @brief Adds a free function to the set of systems.
+     * @tparam Candidate Function to add.
+     * @tparam Req Additional types accessed by the system, if any.
+     * @param name Optional name to assign to the system.
+     */
+    template<auto Candidate, typename... Req>
+    void emplace(const char *name = nullptr) {
+        using args_type = decltype(internal::function_arguments(Candidate));
+
+        callback_type *callback = +[](const void *, basic_registry<entity_type> &owner) {
+            invoke_free<Candidate>(owner, args_type{});
+        };
+
+        track(name, nullptr, callback, type_list_cat_t<decltype(to_resources(args_type{})), type_list<Req...>>{});
+    }
+
+    /**
+     * @brief Adds a member function to the set of systems.
+     * @tparam Candidate Member function to add.
+     * @tparam Req Additional types accessed by the system, if any.
+     * @tparam Type Type of class to which the member function belongs.
+     * @param instance A valid instance of the given type.
+     * @param name Optional name to assign to the system.
+     */
+    template<auto Candidate, typename... Req, typename Type>
+    void emplace(Type &instance, const char *name = nullptr) {
+        static_assert(std::is_member_function_pointer_v<decltype(Candidate)>, "Invalid pointer to non-static member function");
+        using args_type = decltype(internal::function_arguments(Candidate));
+
+        callback_type *callback = +[](const void *payload, basic_registry<entity_type> &owner) {
+            invoke_member<Candidate, Type>(payload, owner, args_type{});
+        };
+
+        track(name, &instance, callback, type_list_cat_t<decltype(to_resources(args_type{})), type_list<Req...>>{});
+    }
+
+    /**
+     * @brief Adds a function to the set of systems.
+     *
+     * The function receives the payload and the registry and its accesses are
+     * those declared by means of the given types. Types are components, views,
+     * groups or any of the other types that a system can accept.
+     *
+     * @tparam Req Types accessed by the system.
+     * @param func A valid function.
+     * @param payload Optional data to pass to the function.
+     * @param name Optional name to assign to the system.
+     */
+    template<typename... Req>
+    void emplace(function_type *func, const void *payload = nullptr, const char *name = nullptr) {
+        ENTT_ASSERT(func);
+        track(name, payload, func, type_list<Req...>{});
+    }
+
+    /**
+     * @brief Returns the execution graph of the systems.
+     *
+     * Vertices are in the same order in which systems were added to the
+     * organizer. The graph is cached and rebuilt only when new systems are
+     * added.
+     *
+     * @return The vertices of the execution graph.
+     */
+    [[nodiscard]] const std::vector<vertex> & graph() {
+        if(vertices.size() != systems.size()) {
+            vertices.resize(systems.size());
+            roots.clear();
+
+            for(size_type pos{}; pos < systems.size(); ++pos) {
+                vertices[pos].system = &systems[pos];
+
+                for(size_type next = pos + 1u; next < systems.size(); ++next) {
+                    if(conflicts(systems[pos], systems[next])) {
+                        vertices[pos].edges.push_back(next);
+                        ++vertices[next].parents;
+                    }
+                }
+
+                if(!vertices[pos].parents) {
+                    roots.push_back(pos);
+                }
+            }
+
+            counters = std::make_unique<std::atomic<size_type>[]>(systems.size());
+        }
+
+        return vertices;
+    }
+
+    /**
+     * @brief Runs all the systems sequentially.
+     *
+     * Systems run in the same order in which they were added.
+     *
+     * @param owner A valid registry.
+     */
+    void run(basic_registry<entity_type> &owner) {
+        for(auto &&vtx: graph()) {
+            vtx.prepare(owner);
+            vtx.callback()(vtx.data(), owner);
+        }
+    }
+
+    /**
+     * @brief Runs all the systems by means of a pool of threads.
+     *
+     * Systems that don't conflict run concurrently. Pools and groups are
+     * created upfront on the calling thread.<br/>
+     * The pool must offer a `run` member function with the same semantics as
+     * that of `thread_pool`.
+     *
+     * @sa thread_pool
+     *
+     * @warning
+     * Systems mustn't create or destroy entities nor assign or remove
+     * components, unless they take a non-const registry as an argument.
+     *
+     * @tparam Pool Type of pool of threads.
+     * @param owner A valid registry.
+     * @param pool A valid pool of threads.
+     */
+    template<typename Pool>
+    void run(basic_registry<entity_type> &owner, Pool &pool) {
+        const auto &nodes = graph();
+
+        for(size_type pos{}; pos < nodes.size(); ++pos) {
+            nodes[pos].prepare(owner);
+            counters[pos] = nodes[pos].in_degree();
+        }
+
+        pool.run(roots.cbegin(), roots.cend(), [this, &owner, &nodes](const size_type pos, auto spawn) {
+            nodes[pos].callback()(nodes[pos].data(), owner);
+
+            for(const auto child: nodes[pos].children()) {
+                if(--counters[child] == 0u) {
+                    spawn(child);
+                }
+            }
+        });
+    }
+
+    /*! @brief Erases all the systems. */
+    void clear() {
+        systems.clear();
+        vertices.clear();
+        roots.clear();
+        counters.reset();
+    }
+
+private:
+    template<auto Candidate, typename... Args>
+    static void invoke_free(basic_registry<entity_type> &owner, type_list<Args...>) {
+        Candidate(resource<Args>(owner)...);
+    }
+
+    template<auto Candidate, typename Type, typename... Args>
+    static void invoke_member(const void *payload, basic_registry<entity_type> &owner, type_list<Args...>) {
+        (static_cast<Type *>(const_cast<void *>(payload))->*Candidate)(resource<Args>(owner)...);
+    }
+
+    std::vector<system_data> systems{};
+    std::vector<vertex> vertices{};
+    std::vector<size_type> roots{};
+    std::unique_ptr<std::atomic<size_type>[]> counters{};
+};
+
+
+}
+
+
+#endif
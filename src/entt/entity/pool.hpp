@@ -5,10 +5,12 @@
 #include <iterator>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include "../config/config.h"
 #include "../core/type_traits.hpp"
 #include "../signal/sigh.hpp"
 #include "fwd.hpp"
+#include "multi_storage.hpp"
 #include "storage.hpp"
 
 
@@ -17,11 +19,17 @@ namespace entt {
 
 /**
  * @brief Default pool implementation.
+ *
+ * The underlying storage can be replaced by any class that offers the same
+ * interface of `storage`, as an example to lay out objects in a different way
+ * (see `soa_storage`).
+ *
  * @tparam Entity A valid entity type (see entt_traits for more details).
  * @tparam Type Type of objects assigned to the entities.
+ * @tparam Storage Type of the underlying storage.
  */
-template<typename Entity, typename Type>
-struct default_pool final: storage<Entity, Type> {
+template<typename Entity, typename Type, typename Storage = storage<Entity, Type>>
+struct default_pool final: Storage {
     static_assert(std::is_same_v<Type, std::decay_t<Type>>, "Invalid object type");
 
     /*! @brief Type of the objects associated with the entities. */
@@ -29,6 +37,23 @@ struct default_pool final: storage<Entity, Type> {
     /*! @brief Underlying entity identifier. */
     using entity_type = Entity;
 
+    /*! @brief Inherited constructors, allocator-aware ones included. */
+    using Storage::Storage;
+
+    /*! @brief Default constructor. */
+    default_pool() = default;
+
+    /**
+     * @brief Copy constructor, listeners aren't copied.
+     * @param other The instance to copy from.
+     */
+    default_pool(const default_pool &other)
+        : Storage{other}
+    {}
+
+    /*! @brief Default move constructor. */
+    default_pool(default_pool &&) = default;
+
     /**
     * @brief Returns a sink object.
     *
@@ -51,6 +76,30 @@ struct default_pool final: storage<Entity, Type> {
         return sink{construction};
     }
 
+    /**
+    * @brief Returns a sink object for batches of entities.
+    *
+    * The sink returned by this function can be used to receive notifications
+    * whenever new instances are created and assigned to one or more entities
+    * at once.<br/>
+    * The function type for a listener is equivalent to:
+    *
+    * @code{.cpp}
+    * void(basic_registry<Entity> &, const Entity *first, const Entity *last);
+    * @endcode
+    *
+    * Listeners are invoked once for each call to `emplace` or `insert`,
+    * **after** the objects have been assigned to the entities and **before**
+    * the listeners of the `on_construct` sink are invoked.
+    *
+    * @sa sink
+    *
+    * @return A temporary sink object.
+    */
+    [[nodiscard]] auto on_construct_batch() ENTT_NOEXCEPT {
+        return sink{construction_batch};
+    }
+
     /**
     * @brief Returns a sink object for the given type.
     *
@@ -94,6 +143,30 @@ struct default_pool final: storage<Entity, Type> {
         return sink{destruction};
     }
 
+    /**
+    * @brief Returns a sink object for batches of entities.
+    *
+    * The sink returned by this function can be used to receive notifications
+    * whenever instances are removed from one or more entities at once and thus
+    * destroyed.<br/>
+    * The function type for a listener is equivalent to:
+    *
+    * @code{.cpp}
+    * void(basic_registry<Entity> &, const Entity *first, const Entity *last);
+    * @endcode
+    *
+    * Listeners are invoked once for each call to `erase`, **after** the
+    * listeners of the `on_destroy` sink and **before** the objects have been
+    * removed from the entities.
+    *
+    * @sa sink
+    *
+    * @return A temporary sink object.
+    */
+    [[nodiscard]] auto on_destroy_batch() ENTT_NOEXCEPT {
+        return sink{destruction_batch};
+    }
+
     /**
     * @brief Assigns an entity to a pool.
     *
@@ -115,8 +188,18 @@ struct default_pool final: storage<Entity, Type> {
     */
     template<typename... Args>
     decltype(auto) emplace(basic_registry<entity_type> &owner, const entity_type entity, Args &&... args) {
-        storage<entity_type, Type>::emplace(entity, std::forward<Args>(args)...);
-        construction.publish(owner, entity);
+        Storage::emplace(entity, std::forward<Args>(args)...);
+
+        if constexpr(ENTT_SIGNATURE_ENABLED) {
+            owner.template track<object_type>(entity, true);
+        }
+
+        if constexpr(component_track_changes_v<object_type>) {
+            this->stamp(entity, owner.next_tick());
+        }
+
+        publish(construction_batch, owner, &entity, &entity + 1);
+        publish(construction, owner, entity);
 
         if constexpr(!is_eto_eligible_v<object_type>) {
             return this->get(entity);
@@ -137,11 +220,62 @@ struct default_pool final: storage<Entity, Type> {
     */
     template<typename It, typename... Args>
     void insert(basic_registry<entity_type> &owner, It first, It last, Args &&... args) {
-        storage<entity_type, object_type>::insert(first, last, std::forward<Args>(args)...);
+        Storage::insert(first, last, std::forward<Args>(args)...);
+        notify(owner, first, last);
+    }
+
+    /**
+    * @brief Assigns multiple entities to a pool without notifying anyone.
+    *
+    * Objects are value-initialized. The registry isn't aware of the new
+    * objects and listeners aren't notified until `notify` is invoked for the
+    * same range of entities.
+    *
+    * @warning
+    * Attempting to use the pool with the registry before invoking `notify`
+    * results in undefined behavior.
+    *
+    * @tparam It Type of input iterator.
+    * @param first An iterator to the first element of the range of entities.
+    * @param last An iterator past the last element of the range of entities.
+    */
+    template<typename It>
+    void append(It first, It last) {
+        Storage::insert(first, last);
+    }
+
+    /**
+    * @brief Updates the registry and notifies listeners after multiple
+    * entities have been assigned to a pool.
+    *
+    * @sa append
+    *
+    * @tparam It Type of input iterator.
+    * @param owner The registry that issued the request.
+    * @param first An iterator to the first element of the range of entities.
+    * @param last An iterator past the last element of the range of entities.
+    */
+    template<typename It>
+    void notify(basic_registry<entity_type> &owner, It first, It last) {
+        if constexpr(component_track_changes_v<object_type>) {
+            const auto tick = owner.next_tick();
+
+            for(auto it = first; it != last; ++it) {
+                this->stamp(*it, tick);
+            }
+        }
+
+        if constexpr(ENTT_SIGNATURE_ENABLED) {
+            for(auto it = first; it != last; ++it) {
+                owner.template track<object_type>(*it, true);
+            }
+        }
+
+        publish(construction_batch, owner, first, last);
 
         if(!construction.empty()) {
             for(; first != last; ++first) {
-                construction.publish(owner, *first);
+                publish(construction, owner, *first);
             }
         }
     }
@@ -159,34 +293,49 @@ struct default_pool final: storage<Entity, Type> {
     * @param entity A valid entity identifier.
     */
     void erase(basic_registry<entity_type> &owner, const entity_type entity) {
-        destruction.publish(owner, entity);
-        storage<entity_type, object_type>::erase(entity);
+        publish(destruction, owner, entity);
+        publish(destruction_batch, owner, &entity, &entity + 1);
+
+        if constexpr(ENTT_SIGNATURE_ENABLED) {
+            owner.template track<object_type>(entity, false);
+        }
+
+        Storage::erase(entity);
     }
 
     /**
     * @brief Removes multiple entities from a pool.
     *
+    * Listeners are notified for all the entities first, then the objects are
+    * removed in a single batch.
+    *
     * @see remove
     *
-    * @tparam It Type of input iterator.
+    * @tparam It Type of forward iterator.
     * @param owner The registry that issued the request.
     * @param first An iterator to the first element of the range of entities.
     * @param last An iterator past the last element of the range of entities.
     */
     template<typename It>
     void erase(basic_registry<entity_type> &owner, It first, It last) {
-        if(std::distance(first, last) == std::distance(this->begin(), this->end())) {
-            if(!destruction.empty()) {
-                for(; first != last; ++first) {
-                    destruction.publish(owner, *first);
-                }
+        if(!destruction.empty()) {
+            for(auto it = first; it != last; ++it) {
+                publish(destruction, owner, *it);
             }
+        }
+
+        publish(destruction_batch, owner, first, last);
 
+        if constexpr(ENTT_SIGNATURE_ENABLED) {
+            for(auto it = first; it != last; ++it) {
+                owner.template track<object_type>(*it, false);
+            }
+        }
+
+        if(std::distance(first, last) == std::distance(this->begin(), this->end())) {
             this->clear();
         } else {
-            for(; first != last; ++first) {
-                this->erase(owner, *first);
-            }
+            Storage::erase(first, last);
         }
     }
 
@@ -218,11 +367,18 @@ struct default_pool final: storage<Entity, Type> {
     */
     template<typename... Func>
     decltype(auto) patch(basic_registry<entity_type> &owner, const entity_type entity, [[maybe_unused]] Func &&... func) {
+        this->record(pool_event::patch);
+
         if constexpr(is_eto_eligible_v<object_type>) {
-            update.publish(owner, entity);
+            publish(update, owner, entity);
         } else {
             (std::forward<Func>(func)(this->get(entity)), ...);
-            update.publish(owner, entity);
+
+            if constexpr(component_track_changes_v<object_type>) {
+                this->stamp(entity, owner.next_tick());
+            }
+
+            publish(update, owner, entity);
             return this->get(entity);
         }
     }
@@ -250,12 +406,540 @@ struct default_pool final: storage<Entity, Type> {
     }
 
 private:
+    void publish(sigh<void(basic_registry<entity_type> &, const entity_type)> &signal, basic_registry<entity_type> &owner, const entity_type entity) {
+        if constexpr(ENTT_POOL_STATS_ENABLED) {
+            this->record(pool_event::publish, !signal.empty());
+        }
+
+        signal.publish(owner, entity);
+    }
+
+    template<typename It>
+    void publish(sigh<void(basic_registry<entity_type> &, const entity_type *, const entity_type *)> &signal, basic_registry<entity_type> &owner, It first, It last) {
+        if(!signal.empty()) {
+            this->record(pool_event::publish);
+
+            if constexpr(std::is_convertible_v<It, const entity_type *>) {
+                signal.publish(owner, first, last);
+            } else {
+                // listeners expect a contiguous range of entities
+                using alloc_type = typename std::allocator_traits<decltype(this->get_allocator())>::template rebind_alloc<entity_type>;
+                const std::vector<entity_type, alloc_type> batch(first, last, alloc_type{this->get_allocator()});
+                signal.publish(owner, batch.data(), batch.data() + batch.size());
+            }
+        }
+    }
+
     sigh<void(basic_registry<entity_type> &, const entity_type)> construction{};
     sigh<void(basic_registry<entity_type> &, const entity_type)> destruction{};
     sigh<void(basic_registry<entity_type> &, const entity_type)> update{};
+    sigh<void(basic_registry<entity_type> &, const entity_type *, const entity_type *)> construction_batch{};
+    sigh<void(basic_registry<entity_type> &, const entity_type *, const entity_type *)> destruction_batch{};
 };
 
 
+/**
+ * @cond TURN_OFF_DOXYGEN
+ * Internal details not to be documented.
+ */
+
+
+namespace internal {
+
+
+template<typename, typename... Type>
+struct multi_pool_instance;
+
+
+template<typename, typename = void>
+struct is_multi_pool: std::false_type {};
+
+
+template<typename Pool>
+struct is_multi_pool<Pool, std::void_t<typename Pool::member_list>>: std::true_type {};
+
+
+template<typename Component, typename Pool>
+void prepare_concurrent_access([[maybe_unused]] Pool &cpool) {
+    // pages shared with forked registries are copied upfront rather than concurrently
+    if constexpr(!std::is_const_v<Pool> && !is_eto_eligible_v<std::remove_const_t<Component>> && component_page_size_v<std::remove_const_t<Component>> != 0u) {
+        static_cast<void>(cpool.pages());
+    }
+}
+
+
+}
+
+
+/**
+ * Internal details not to be documented.
+ * @endcond
+ */
+
+
+/**
+ * @brief Pool for a type that shares its storage with other types.
+ *
+ * Pools of all the types that share a `multi_storage` must be specialized so as
+ * to refer to the same list of members, in the same order:
+ *
+ * @code{.cpp}
+ * template<typename Entity>
+ * struct entt::pool<Entity, position> {
+ *     using type = entt::multi_pool<Entity, position, position, rotation>;
+ * };
+ * @endcode
+ *
+ * Registries create a single instance of the storage the first time a pool is
+ * requested for any of the members and return it for all of them.<br/>
+ * Members are assigned to and removed from entities together. Assigning one of
+ * them to an entity value-initializes all the others and removing one of them
+ * removes all the others. Signals of all the members are triggered in both
+ * cases.
+ *
+ * @warning
+ * Members share the order of their entities. Therefore, owning more than one
+ * of them with groups (either the same group or different ones) or sorting a
+ * member owned by a group through another member results in undefined
+ * behavior.
+ *
+ * @tparam Entity A valid entity type (see entt_traits for more details).
+ * @tparam Type Type of objects assigned to the entities.
+ * @tparam Member Types of objects that share the same storage.
+ */
+template<typename Entity, typename Type, typename... Member>
+struct multi_pool: virtual multi_storage<Entity, Member...> {
+    static_assert((std::is_same_v<Type, Member> || ...), "Type must be a member");
+
+    /*! @brief Members of the same storage publish the signals of each other. */
+    template<typename, typename, typename...>
+    friend struct multi_pool;
+
+    /*! @brief Type of the objects associated with the entities. */
+    using object_type = Type;
+    /*! @brief Underlying entity identifier. */
+    using entity_type = Entity;
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+    /*! @brief Type of the storage shared by the members. */
+    using storage_type = multi_storage<Entity, Member...>;
+    /*! @brief Type of the pool that contains the pools of all the members. */
+    using instance_type = internal::multi_pool_instance<Entity, Member...>;
+    /*! @brief Types of objects that share the same storage. */
+    using member_list = type_list<Member...>;
+    /*! @brief Random access iterator type. */
+    using iterator = std::reverse_iterator<Type *>;
+    /*! @brief Constant random access iterator type. */
+    using const_iterator = std::reverse_iterator<const Type *>;
+
+private:
+    template<typename Func>
+    void members(Func func) {
+        auto &instance = static_cast<instance_type &>(*this);
+        (func(static_cast<multi_pool<Entity, Member, Member...> &>(instance)), ...);
+    }
+
+    template<typename Other, typename... Args>
+    [[nodiscard]] static Other make([[maybe_unused]] Args &&... args) {
+        if constexpr(!std::is_same_v<Other, Type>) {
+            return Other{};
+        } else if constexpr(std::is_aggregate_v<Type>) {
+            return Type{std::forward<Args>(args)...};
+        } else {
+            return Type(std::forward<Args>(args)...);
+        }
+    }
+
+public:
+    /*! @brief Default constructor. */
+    multi_pool() = default;
+
+    /*! @brief Pools share their storage and thus aren't copyable. */
+    multi_pool(const multi_pool &) = delete;
+
+    /*! @brief Pools share their storage and thus aren't copyable. */
+    multi_pool & operator=(const multi_pool &) = delete;
+
+    /**
+     * @brief Direct access to the array of objects.
+     * @return A pointer to the array of objects.
+     */
+    [[nodiscard]] const Type * raw() const ENTT_NOEXCEPT {
+        return storage_type::template raw<Type>();
+    }
+
+    /*! @copydoc raw */
+    [[nodiscard]] Type * raw() ENTT_NOEXCEPT {
+        return storage_type::template raw<Type>();
+    }
+
+    /**
+     * @brief Returns an iterator to the beginning.
+     * @return An iterator to the first instance of the internal array.
+     */
+    [[nodiscard]] const_iterator cbegin() const ENTT_NOEXCEPT {
+        return const_iterator{raw() + storage_type::size()};
+    }
+
+    /*! @copydoc cbegin */
+    [[nodiscard]] const_iterator begin() const ENTT_NOEXCEPT {
+        return cbegin();
+    }
+
+    /*! @copydoc begin */
+    [[nodiscard]] iterator begin() ENTT_NOEXCEPT {
+        return iterator{raw() + storage_type::size()};
+    }
+
+    /**
+     * @brief Returns an iterator to the end.
+     * @return An iterator to the element following the last instance of the
+     * internal array.
+     */
+    [[nodiscard]] const_iterator cend() const ENTT_NOEXCEPT {
+        return const_iterator{raw()};
+    }
+
+    /*! @copydoc cend */
+    [[nodiscard]] const_iterator end() const ENTT_NOEXCEPT {
+        return cend();
+    }
+
+    /*! @copydoc end */
+    [[nodiscard]] iterator end() ENTT_NOEXCEPT {
+        return iterator{raw()};
+    }
+
+    /**
+     * @brief Returns the object associated with an entity.
+     * @param entt A valid entity identifier.
+     * @return The object associated with the entity.
+     */
+    [[nodiscard]] const Type & get(const entity_type entt) const {
+        return storage_type::template get<Type>(entt);
+    }
+
+    /*! @copydoc get */
+    [[nodiscard]] Type & get(const entity_type entt) {
+        return storage_type::template get<Type>(entt);
+    }
+
+    /**
+     * @brief Returns a pointer to the object associated with an entity, if any.
+     * @param entt A valid entity identifier.
+     * @return The object associated with the entity, if any.
+     */
+    [[nodiscard]] const Type * try_get(const entity_type entt) const {
+        return storage_type::template try_get<Type>(entt);
+    }
+
+    /*! @copydoc try_get */
+    [[nodiscard]] Type * try_get(const entity_type entt) {
+        return storage_type::template try_get<Type>(entt);
+    }
+
+    /*! @copydoc default_pool::on_construct */
+    [[nodiscard]] auto on_construct() ENTT_NOEXCEPT {
+        return sink{construction};
+    }
+
+    /*! @copydoc default_pool::on_update */
+    [[nodiscard]] auto on_update() ENTT_NOEXCEPT {
+        return sink{update};
+    }
+
+    /*! @copydoc default_pool::on_destroy */
+    [[nodiscard]] auto on_destroy() ENTT_NOEXCEPT {
+        return sink{destruction};
+    }
+
+    /*! @copydoc default_pool::on_construct_batch */
+    [[nodiscard]] auto on_construct_batch() ENTT_NOEXCEPT {
+        return sink{construction_batch};
+    }
+
+    /*! @copydoc default_pool::on_destroy_batch */
+    [[nodiscard]] auto on_destroy_batch() ENTT_NOEXCEPT {
+        return sink{destruction_batch};
+    }
+
+    /**
+     * @brief Assigns an entity to a pool and to the pools of all the members.
+     *
+     * The object is initialized with the arguments provided, the objects of
+     * the other members are value-initialized.
+     *
+     * @tparam Args Types of arguments to use to construct the object.
+     * @param owner The registry that issued the request.
+     * @param entity A valid entity identifier.
+     * @param args Parameters to use to initialize the object.
+     * @return A reference to the newly created object.
+     */
+    template<typename... Args>
+    Type & emplace(basic_registry<entity_type> &owner, const entity_type entity, Args &&... args) {
+        storage_type::emplace(entity, make<Member>(std::forward<Args>(args)...)...);
+
+        if constexpr(ENTT_SIGNATURE_ENABLED) {
+            (owner.template track<Member>(entity, true), ...);
+        }
+
+        members([&owner, &entity](auto &&cpool) {
+            cpool.publish(cpool.construction_batch, owner, &entity, &entity + 1);
+            cpool.publish(cpool.construction, owner, entity);
+        });
+        return get(entity);
+    }
+
+    /**
+     * @brief Assigns multiple entities to a pool and to the pools of all the
+     * members.
+     *
+     * @sa emplace
+     *
+     * @tparam It Type of input iterator.
+     * @param owner The registry that issued the request.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     * @param value An instance of the object to copy.
+     */
+    template<typename It>
+    void insert(basic_registry<entity_type> &owner, It first, It last, const Type &value = {}) {
+        storage_type::insert(first, last, [&value]() -> decltype(auto) {
+            if constexpr(std::is_same_v<Member, Type>) {
+                return value;
+            } else {
+                return Member{};
+            }
+        }()...);
+
+        notify(owner, first, last);
+    }
+
+    /**
+     * @brief Assigns multiple entities to a pool and to the pools of all the
+     * members and copies the objects from a given range.
+     *
+     * @sa emplace
+     *
+     * @tparam EIt Type of input iterator.
+     * @tparam CIt Type of input iterator.
+     * @param owner The registry that issued the request.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     * @param from An iterator to the first element of the range of objects.
+     * @param to An iterator past the last element of the range of objects.
+     */
+    template<typename EIt, typename CIt>
+    void insert(basic_registry<entity_type> &owner, EIt first, EIt last, CIt from, CIt to) {
+        const auto offset = storage_type::size();
+        storage_type::insert(first, last, Member{}...);
+        std::copy(from, to, raw() + offset);
+        notify(owner, first, last);
+    }
+
+    /**
+     * @brief Removes an entity from a pool and from the pools of all the
+     * members.
+     * @param owner The registry that issued the request.
+     * @param entity A valid entity identifier.
+     */
+    void erase(basic_registry<entity_type> &owner, const entity_type entity) {
+        members([&owner, &entity](auto &&cpool) {
+            cpool.publish(cpool.destruction, owner, entity);
+            cpool.publish(cpool.destruction_batch, owner, &entity, &entity + 1);
+        });
+
+        if constexpr(ENTT_SIGNATURE_ENABLED) {
+            (owner.template track<Member>(entity, false), ...);
+        }
+
+        storage_type::erase(entity);
+    }
+
+    /**
+     * @brief Removes multiple entities from a pool and from the pools of all
+     * the members.
+     *
+     * @sa erase
+     *
+     * @tparam It Type of forward iterator.
+     * @param owner The registry that issued the request.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     */
+    template<typename It>
+    void erase(basic_registry<entity_type> &owner, It first, It last) {
+        for(auto it = first; it != last; ++it) {
+            members([&owner, entt = *it](auto &&cpool) { cpool.publish(cpool.destruction, owner, entt); });
+
+            if constexpr(ENTT_SIGNATURE_ENABLED) {
+                (owner.template track<Member>(*it, false), ...);
+            }
+        }
+
+        members([&owner, first, last](auto &&cpool) { cpool.publish(cpool.destruction_batch, owner, first, last); });
+
+        if(std::distance(first, last) == std::distance(begin(), end())) {
+            storage_type::clear();
+        } else {
+            storage_type::erase(first, last);
+        }
+    }
+
+    /*! @copydoc default_pool::patch */
+    template<typename... Func>
+    Type & patch(basic_registry<entity_type> &owner, const entity_type entity, Func &&... func) {
+        this->record(pool_event::patch);
+        (std::forward<Func>(func)(get(entity)), ...);
+        publish(update, owner, entity);
+        return get(entity);
+    }
+
+    /*! @copydoc default_pool::replace */
+    Type & replace(basic_registry<entity_type> &owner, const entity_type entity, Type value) {
+        return patch(owner, entity, [&value](auto &&curr) { curr = std::move(value); });
+    }
+
+    /**
+     * @brief Sort entities and the objects of all the members according to the
+     * given comparison function.
+     *
+     * @sa storage::sort
+     *
+     * @tparam Compare Type of comparison function object.
+     * @tparam Sort Type of sort function object.
+     * @tparam Args Types of arguments to forward to the sort function object.
+     * @param first An iterator to the first element of the range to sort.
+     * @param last An iterator past the last element of the range to sort.
+     * @param compare A valid comparison function object.
+     * @param algo A valid sort function object.
+     * @param args Arguments to forward to the sort function object, if any.
+     */
+    template<typename Compare, typename Sort = std_sort, typename... Args>
+    void sort(iterator first, iterator last, Compare compare, Sort algo = Sort{}, Args &&... args) {
+        const auto from = sparse_set<Entity>::begin() + std::distance(begin(), first);
+        const auto to = from + std::distance(first, last);
+
+        if constexpr(std::is_invocable_v<Compare, const Type &, const Type &>) {
+            storage_type::sort(from, to, [this, compare = std::move(compare)](const auto lhs, const auto rhs) {
+                return compare(std::as_const(*this).get(lhs), std::as_const(*this).get(rhs));
+            }, std::move(algo), std::forward<Args>(args)...);
+        } else {
+            storage_type::sort(from, to, std::move(compare), std::move(algo), std::forward<Args>(args)...);
+        }
+    }
+
+    /*! @copydoc default_pool::append */
+    template<typename It>
+    void append(It first, It last) {
+        storage_type::insert(first, last, Member{}...);
+    }
+
+    /**
+     * @brief Updates the registry and notifies listeners after multiple
+     * entities have been assigned to a pool and to the pools of all the
+     * members.
+     *
+     * @sa append
+     *
+     * @tparam It Type of input iterator.
+     * @param owner The registry that issued the request.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     */
+    template<typename It>
+    void notify(basic_registry<entity_type> &owner, It first, It last) {
+        if constexpr(ENTT_SIGNATURE_ENABLED) {
+            for(auto it = first; it != last; ++it) {
+                (owner.template track<Member>(*it, true), ...);
+            }
+        }
+
+        members([&owner, first, last](auto &&cpool) {
+            cpool.publish(cpool.construction_batch, owner, first, last);
+
+            for(auto it = first; it != last; ++it) {
+                cpool.publish(cpool.construction, owner, *it);
+            }
+        });
+    }
+
+private:
+    void publish(sigh<void(basic_registry<entity_type> &, const entity_type)> &signal, basic_registry<entity_type> &owner, const entity_type entity) {
+        if constexpr(ENTT_POOL_STATS_ENABLED) {
+            this->record(pool_event::publish, !signal.empty());
+        }
+
+        signal.publish(owner, entity);
+    }
+
+    template<typename It>
+    void publish(sigh<void(basic_registry<entity_type> &, const entity_type *, const entity_type *)> &signal, basic_registry<entity_type> &owner, It first, It last) {
+        if(!signal.empty()) {
+            this->record(pool_event::publish);
+
+            if constexpr(std::is_convertible_v<It, const entity_type *>) {
+                signal.publish(owner, first, last);
+            } else {
+                // listeners expect a contiguous range of entities
+                using alloc_type = typename std::allocator_traits<decltype(this->get_allocator())>::template rebind_alloc<entity_type>;
+                const std::vector<entity_type, alloc_type> batch(first, last, alloc_type{this->get_allocator()});
+                signal.publish(owner, batch.data(), batch.data() + batch.size());
+            }
+        }
+    }
+
+    sigh<void(basic_registry<entity_type> &, const entity_type)> construction{};
+    sigh<void(basic_registry<entity_type> &, const entity_type)> destruction{};
+    sigh<void(basic_registry<entity_type> &, const entity_type)> update{};
+    sigh<void(basic_registry<entity_type> &, const entity_type *, const entity_type *)> construction_batch{};
+    sigh<void(basic_registry<entity_type> &, const entity_type *, const entity_type *)> destruction_batch{};
+};
+
+
+/**
+ * @cond TURN_OFF_DOXYGEN
+ * Internal details not to be documented.
+ */
+
+
+namespace internal {
+
+
+template<typename Entity, typename... Type>
+struct multi_pool_instance final: multi_pool<Entity, Type, Type...>... {
+    using storage_type = multi_storage<Entity, Type...>;
+    using allocator_type = typename storage_type::allocator_type;
+
+    multi_pool_instance()
+        : multi_pool_instance{allocator_type{}}
+    {}
+
+    explicit multi_pool_instance(const allocator_type &alloc)
+        : storage_type{alloc}
+    {}
+
+    // copies the shared storage, listeners aren't copied
+    multi_pool_instance(const multi_pool_instance &other)
+        : storage_type{other}
+    {}
+
+    // forks the shared storage, listeners aren't copied
+    multi_pool_instance(multi_pool_instance &other, fork_t)
+        : storage_type{other, fork_t{}}
+    {}
+};
+
+
+}
+
+
+/**
+ * Internal details not to be documented.
+ * @endcond
+ */
+
+
 /**
  * @brief Applies component-to-pool conversion and defines the resulting type as
  * the member typedef type.
@@ -3,9 +3,12 @@
 
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -14,6 +17,8 @@
 #include "../core/algorithm.hpp"
 #include "../core/fwd.hpp"
 #include "../core/type_info.hpp"
+#include "cached_view.hpp"
+#include "component.hpp"
 #include "entity.hpp"
 #include "fwd.hpp"
 #include "group.hpp"
@@ -28,6 +33,25 @@
 namespace entt {
 
 
+/**
+ * @brief Memory footprint of a registry.
+ *
+ * Sizes are in bytes, unless otherwise specified.
+ */
+struct registry_footprint {
+    /*! @brief Overall footprint of the pools, each one counted once. */
+    pool_footprint pools{};
+    /*! @brief Bytes used to track the pools of the registry. */
+    std::size_t lookup{};
+    /*! @brief Bytes allocated for entities, signatures and the list of live entities. */
+    std::size_t entities{};
+    /*! @brief Bytes allocated for groups and their handlers. */
+    std::size_t groups{};
+    /*! @brief Bytes allocated for the context variables. */
+    std::size_t vars{};
+};
+
+
 /**
  * @brief Fast and reliable entity-component system.
  *
@@ -40,12 +64,33 @@ namespace entt {
  */
 template<typename Entity>
 class basic_registry {
+    /*! @brief Default pools keep the signatures of the entities up to date. */
+    template<typename, typename, typename>
+    friend struct default_pool;
+
+    /*! @brief Pools that share their storage keep the signatures up to date. */
+    template<typename, typename, typename...>
+    friend struct multi_pool;
+
     using traits_type = entt_traits<Entity>;
+    using alloc_traits = std::allocator_traits<typename sparse_set<Entity>::allocator_type>;
+
+    template<typename Type>
+    using alloc_type = typename alloc_traits::template rebind_alloc<Type>;
+
+    // the list of alive entities is kept only on demand, an empty type takes its place otherwise
+    using living_type = std::conditional_t<ENTT_ALIVE_LIST_ENABLED, sparse_set<Entity>, std::tuple<>>;
+
+    using mask_type = std::size_t;
+    static constexpr auto mask_digits = static_cast<std::size_t>(std::numeric_limits<mask_type>::digits);
 
     struct pool_data {
         id_type type_id{};
-        std::unique_ptr<sparse_set<Entity>> pool{};
-        void(* erase)(sparse_set<Entity> &, basic_registry &, const Entity);
+        std::shared_ptr<sparse_set<Entity>> pool{};
+        // pools can share their sparse set, the typed pointer cannot be recovered from it
+        void *instance{};
+        void(* erase)(void *, basic_registry &, const Entity){};
+        void(* fork)(basic_registry &, basic_registry &){};
     };
 
     template<typename...>
@@ -54,37 +99,107 @@ class basic_registry {
     template<typename... Exclude, typename... Get, typename... Owned>
     struct group_handler<exclude_t<Exclude...>, get_t<Get...>, Owned...> {
         static_assert(std::conjunction_v<std::is_same<Owned, std::decay_t<Owned>>..., std::is_same<Get, std::decay_t<Get>>..., std::is_same<Exclude, std::decay_t<Exclude>>...>, "One or more component types are invalid");
-        std::conditional_t<sizeof...(Owned) == 0, sparse_set<Entity>, std::size_t> current{};
+        std::conditional_t<sizeof...(Owned) == 0, sparse_set<Entity>, std::size_t> current;
+        sparse_set<Entity> dirty;
+        std::tuple<pool_t<Entity, Owned> *..., pool_t<Entity, Get> *..., pool_t<Entity, Exclude> *...> pools;
+        bool lazy;
+
+        group_handler([[maybe_unused]] const typename alloc_traits::allocator_type &alloc)
+            : current{[&alloc]() {
+                  if constexpr(sizeof...(Owned) == 0) {
+                      return sparse_set<Entity>{alloc};
+                  } else {
+                      return std::size_t{};
+                  }
+              }()},
+              dirty{alloc},
+              pools{},
+              lazy{}
+        {}
+
+        void defer(const Entity *first, const Entity *last) {
+            for(; first != last; ++first) {
+                if(!dirty.contains(*first)) {
+                    dirty.emplace(*first);
+                }
+            }
+        }
+
+        void refresh() {
+            [[maybe_unused]] auto &cpool = *std::get<0>(pools);
+
+            for(const auto entt: dirty) {
+                const auto is_valid = (std::get<pool_t<Entity, Owned> *>(pools)->contains(entt) && ...)
+                        && (std::get<pool_t<Entity, Get> *>(pools)->contains(entt) && ...)
+                        && (!std::get<pool_t<Entity, Exclude> *>(pools)->contains(entt) && ...);
+
+                if(is_valid != (cpool.contains(entt) && (cpool.index(entt) < current))) {
+                    const auto pos = is_valid ? current++ : --current;
+                    (std::get<pool_t<Entity, Owned> *>(pools)->swap(std::get<pool_t<Entity, Owned> *>(pools)->data()[pos], entt), ...);
+                }
+            }
+
+            dirty.clear();
+        }
 
         template<typename Component>
-        void maybe_valid_if(basic_registry &owner, const Entity entt) {
+        void maybe_valid_if(basic_registry &owner, const Entity *first, const Entity *last) {
+            if constexpr(sizeof...(Owned) != 0) {
+                if(lazy) {
+                    defer(first, last);
+                    return;
+                }
+            }
+
+            // pools are looked up once for the whole batch
             [[maybe_unused]] const auto cpools = std::forward_as_tuple(owner.assure<Owned>()...);
+            [[maybe_unused]] const auto gpools = std::forward_as_tuple(owner.assure<Get>()...);
+            [[maybe_unused]] const auto epools = std::forward_as_tuple(owner.assure<Exclude>()...);
 
-            const auto is_valid = ((std::is_same_v<Component, Owned> || std::get<pool_t<Entity, Owned> &>(cpools).contains(entt)) && ...)
-                    && ((std::is_same_v<Component, Get> || owner.assure<Get>().contains(entt)) && ...)
-                    && ((std::is_same_v<Component, Exclude> || !owner.assure<Exclude>().contains(entt)) && ...);
+            for(; first != last; ++first) {
+                const auto entt = *first;
 
-            if constexpr(sizeof...(Owned) == 0) {
-                if(is_valid && !current.contains(entt)) {
-                    current.emplace(entt);
-                }
-            } else {
-                if(is_valid && !(std::get<0>(cpools).index(entt) < current)) {
-                    const auto pos = current++;
-                    (std::get<pool_t<Entity, Owned> &>(cpools).swap(std::get<pool_t<Entity, Owned> &>(cpools).data()[pos], entt), ...);
+                const auto is_valid = ((std::is_same_v<Component, Owned> || std::get<pool_t<Entity, Owned> &>(cpools).contains(entt)) && ...)
+                        && ((std::is_same_v<Component, Get> || std::get<pool_t<Entity, Get> &>(gpools).contains(entt)) && ...)
+                        && ((std::is_same_v<Component, Exclude> || !std::get<pool_t<Entity, Exclude> &>(epools).contains(entt)) && ...);
+
+                if constexpr(sizeof...(Owned) == 0) {
+                    if(is_valid && !current.contains(entt)) {
+                        current.emplace(entt);
+                    }
+                } else {
+                    if(is_valid && !(std::get<0>(cpools).index(entt) < current)) {
+                        const auto pos = current++;
+                        (std::get<pool_t<Entity, Owned> &>(cpools).swap(std::get<pool_t<Entity, Owned> &>(cpools).data()[pos], entt), ...);
+                    }
                 }
             }
         }
 
-        void discard_if([[maybe_unused]] basic_registry &owner, const Entity entt) {
-            if constexpr(sizeof...(Owned) == 0) {
-                if(current.contains(entt)) {
-                    current.erase(entt);
+        template<typename Component>
+        void discard_if([[maybe_unused]] basic_registry &owner, const Entity *first, const Entity *last) {
+            // owned components must leave the group before they are removed from their pools
+            if constexpr(sizeof...(Owned) != 0 && !(std::is_same_v<Component, Owned> || ...)) {
+                if(lazy) {
+                    defer(first, last);
+                    return;
                 }
-            } else {
-                if(const auto cpools = std::forward_as_tuple(owner.assure<Owned>()...); std::get<0>(cpools).contains(entt) && (std::get<0>(cpools).index(entt) < current)) {
-                    const auto pos = --current;
-                    (std::get<pool_t<Entity, Owned> &>(cpools).swap(std::get<pool_t<Entity, Owned> &>(cpools).data()[pos], entt), ...);
+            }
+
+            [[maybe_unused]] const auto cpools = std::forward_as_tuple(owner.assure<Owned>()...);
+
+            for(; first != last; ++first) {
+                const auto entt = *first;
+
+                if constexpr(sizeof...(Owned) == 0) {
+                    if(current.contains(entt)) {
+                        current.erase(entt);
+                    }
+                } else {
+                    if(std::get<0>(cpools).contains(entt) && (std::get<0>(cpools).index(entt) < current)) {
+                        const auto pos = --current;
+                        (std::get<pool_t<Entity, Owned> &>(cpools).swap(std::get<pool_t<Entity, Owned> &>(cpools).data()[pos], entt), ...);
+                    }
                 }
             }
         }
@@ -92,21 +207,327 @@ class basic_registry {
 
     struct group_data {
         std::size_t size;
-        std::unique_ptr<void, void(*)(void *)> group;
+        std::shared_ptr<void> group;
         bool (* owned)(const id_type) ENTT_NOEXCEPT;
         bool (* get)(const id_type) ENTT_NOEXCEPT;
         bool (* exclude)(const id_type) ENTT_NOEXCEPT;
+        std::size_t (* footprint)(const void *);
+        bool lazy;
     };
 
-    struct variable_data {
+    struct log_data {
         id_type type_id;
-        std::unique_ptr<void, void(*)(void *)> value;
+        std::shared_ptr<basic_change_log<Entity>> log;
     };
 
-    template<typename Component>
-    [[nodiscard]] const pool_t<Entity, Component> & assure() const {
-        const sparse_set<entity_type> *curr;
+    class lookup_table {
+        using value_type = std::pair<id_type, std::size_t>;
+        using container_type = std::vector<value_type, alloc_type<value_type>>;
+
+        static void place(container_type &table, const value_type &elem) {
+            auto pos = elem.first & (table.size() - 1u);
+            for(; table[pos].second; pos = (pos + 1u) & (table.size() - 1u));
+            table[pos] = elem;
+        }
+
+        [[nodiscard]] std::size_t probe(const id_type id) const ENTT_NOEXCEPT {
+            // open addressing with linear probing, slots store positions plus one
+            auto pos = id & (table.size() - 1u);
+            for(; table[pos].second && table[pos].first != id; pos = (pos + 1u) & (table.size() - 1u));
+            return pos;
+        }
+
+    public:
+        explicit lookup_table(const typename alloc_traits::allocator_type &alloc)
+            : table{alloc_type<value_type>{alloc}},
+              count{}
+        {}
+
+        [[nodiscard]] std::size_t footprint() const ENTT_NOEXCEPT {
+            return table.capacity() * sizeof(value_type);
+        }
+
+        [[nodiscard]] std::size_t find(const id_type id, const std::size_t missing) const ENTT_NOEXCEPT {
+            if(table.empty()) {
+                return missing;
+            }
+
+            const auto &elem = table[probe(id)];
+            return elem.second ? (elem.second - 1u) : missing;
+        }
+
+        void insert(const id_type id, const std::size_t index) {
+            // the load factor never exceeds one half
+            if(table.size() < 2u * (count + 1u)) {
+                container_type other(table.empty() ? std::size_t{16u} : (table.size() * 2u), value_type{}, table.get_allocator());
+
+                for(auto &&elem: table) {
+                    if(elem.second) {
+                        place(other, elem);
+                    }
+                }
+
+                table.swap(other);
+            }
+
+            auto &elem = table[probe(id)];
+            count += !elem.second;
+            elem = value_type{id, index + 1u};
+        }
+
+        void erase(const id_type id) {
+            if(!table.empty()) {
+                if(auto pos = probe(id); table[pos].second) {
+                    const auto mask = table.size() - 1u;
+                    table[pos] = value_type{};
+                    --count;
+
+                    // backward shift deletion, the following elements are moved closer to their home slots
+                    for(auto next = (pos + 1u) & mask; table[next].second; next = (next + 1u) & mask) {
+                        if(((next - (table[next].first & mask)) & mask) >= ((next - pos) & mask)) {
+                            table[pos] = table[next];
+                            table[next] = value_type{};
+                            pos = next;
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        container_type table;
+        std::size_t count;
+    };
+
+    class context_data {
+        // small variables are constructed in fixed-size slots allocated in pages
+        union slot_type {
+            slot_type *next;
+            alignas(std::max_align_t) std::byte data[4u * sizeof(std::max_align_t)];
+        };
+
+        static constexpr std::size_t page_slots = 32u;
+
+        struct variable_data {
+            id_type type_id;
+            void *value;
+            void(* release)(context_data &, void *);
+            std::size_t size;
+        };
+
+        template<typename Type>
+        static constexpr bool is_small_v = (sizeof(Type) <= sizeof(slot_type)) && (alignof(Type) <= alignof(slot_type));
+
+        [[nodiscard]] void * acquire() {
+            if(free) {
+                return std::exchange(free, free->next);
+            }
+
+            if(pages.empty() || !(next < page_slots)) {
+                alloc_type<slot_type> alloc{allocator};
+                pages.push_back(std::allocator_traits<alloc_type<slot_type>>::allocate(alloc, page_slots));
+                next = {};
+            }
+
+            return pages.back() + next++;
+        }
+
+        void recycle(void *slot) ENTT_NOEXCEPT {
+            free = ::new (slot) slot_type{free};
+        }
+
+        template<typename Type, typename... Args>
+        [[nodiscard]] Type * construct(Args &&... args) {
+            if constexpr(is_small_v<Type>) {
+                void *slot = acquire();
+
+                try {
+                    return ::new (slot) Type{std::forward<Args>(args)...};
+                } catch(...) {
+                    recycle(slot);
+                    throw;
+                }
+            } else {
+                alloc_type<Type> alloc{allocator};
+                Type *instance = std::allocator_traits<alloc_type<Type>>::allocate(alloc, 1u);
+
+                try {
+                    return ::new (static_cast<void *>(instance)) Type{std::forward<Args>(args)...};
+                } catch(...) {
+                    std::allocator_traits<alloc_type<Type>>::deallocate(alloc, instance, 1u);
+                    throw;
+                }
+            }
+        }
+
+        template<typename Type>
+        static void destroy(context_data &ctx, void *value) {
+            static_cast<Type *>(value)->~Type();
+
+            if constexpr(is_small_v<Type>) {
+                ctx.recycle(value);
+            } else {
+                alloc_type<Type> alloc{ctx.allocator};
+                std::allocator_traits<alloc_type<Type>>::deallocate(alloc, static_cast<Type *>(value), 1u);
+            }
+        }
+
+        void release() {
+            for(auto pos = vars.size(); pos; --pos) {
+                vars[pos - 1u].release(*this, vars[pos - 1u].value);
+            }
+
+            alloc_type<slot_type> alloc{allocator};
+
+            for(auto *page: pages) {
+                std::allocator_traits<alloc_type<slot_type>>::deallocate(alloc, page, page_slots);
+            }
+
+            vars.clear();
+            pages.clear();
+            free = nullptr;
+            next = {};
+        }
+
+    public:
+        explicit context_data(const typename alloc_traits::allocator_type &alloc)
+            : allocator{alloc},
+              vars{alloc_type<variable_data>{alloc}},
+              index{alloc},
+              pages{alloc_type<slot_type *>{alloc}},
+              free{},
+              next{}
+        {}
+
+        context_data(context_data &&other) ENTT_NOEXCEPT
+            : allocator{std::move(other.allocator)},
+              vars{std::move(other.vars)},
+              index{std::move(other.index)},
+              pages{std::move(other.pages)},
+              free{std::exchange(other.free, nullptr)},
+              next{std::exchange(other.next, std::size_t{})}
+        {
+            other.vars.clear();
+            other.pages.clear();
+        }
+
+        ~context_data() {
+            release();
+        }
+
+        context_data & operator=(context_data &&other) ENTT_NOEXCEPT {
+            ENTT_ASSERT(alloc_traits::propagate_on_container_move_assignment::value || allocator == other.allocator);
 
+            if(this != &other) {
+                release();
+
+                if constexpr(alloc_traits::propagate_on_container_move_assignment::value) {
+                    allocator = std::move(other.allocator);
+                }
+
+                vars = std::move(other.vars);
+                index = std::move(other.index);
+                pages = std::move(other.pages);
+                free = std::exchange(other.free, nullptr);
+                next = std::exchange(other.next, std::size_t{});
+                other.vars.clear();
+                other.pages.clear();
+            }
+
+            return *this;
+        }
+
+        template<typename Type, typename... Args>
+        Type & emplace(Args &&... args) {
+            erase(type_info<Type>::id());
+            Type *instance = construct<Type>(std::forward<Args>(args)...);
+
+            try {
+                vars.push_back(variable_data{type_info<Type>::id(), instance, &destroy<Type>, is_small_v<Type> ? std::size_t{} : sizeof(Type)});
+                index.insert(type_info<Type>::id(), vars.size() - 1u);
+            } catch(...) {
+                if(!vars.empty() && vars.back().value == instance) {
+                    vars.pop_back();
+                }
+
+                destroy<Type>(*this, instance);
+                throw;
+            }
+
+            return *instance;
+        }
+
+        void erase(const id_type id) {
+            if(const auto pos = index.find(id, vars.size()); pos != vars.size()) {
+                vars[pos].release(*this, vars[pos].value);
+                index.erase(id);
+
+                if(const auto last = vars.size() - 1u; pos != last) {
+                    vars[pos] = vars[last];
+                    index.insert(vars[pos].type_id, pos);
+                }
+
+                vars.pop_back();
+            }
+        }
+
+        [[nodiscard]] const void * find(const id_type id) const ENTT_NOEXCEPT {
+            const auto pos = index.find(id, vars.size());
+            return pos == vars.size() ? nullptr : vars[pos].value;
+        }
+
+        [[nodiscard]] std::size_t footprint() const ENTT_NOEXCEPT {
+            // small variables live in pages, the others are allocated one at a time
+            auto bytes = pages.size() * page_slots * sizeof(slot_type) + pages.capacity() * sizeof(slot_type *) + vars.capacity() * sizeof(variable_data) + index.footprint();
+
+            for(auto &&elem: vars) {
+                bytes += elem.size;
+            }
+
+            return bytes;
+        }
+
+        template<typename Func>
+        void each(Func func) const {
+            for(auto pos = vars.size(); pos; --pos) {
+                func(vars[pos - 1u].type_id);
+            }
+        }
+
+    private:
+        typename alloc_traits::allocator_type allocator;
+        std::vector<variable_data, alloc_type<variable_data>> vars;
+        lookup_table index;
+        std::vector<slot_type *, alloc_type<slot_type *>> pages;
+        slot_type *free;
+        std::size_t next;
+    };
+
+    template<typename Type, typename... Args>
+    [[nodiscard]] std::shared_ptr<Type> allocate(Args &&... args) const {
+        using traits = std::allocator_traits<alloc_type<Type>>;
+        alloc_type<Type> alloc{allocator};
+        Type *instance = traits::allocate(alloc, 1u);
+
+        try {
+            ::new (static_cast<void *>(instance)) Type{std::forward<Args>(args)...};
+        } catch(...) {
+            traits::deallocate(alloc, instance, 1u);
+            throw;
+        }
+
+        return std::shared_ptr<Type>{instance, [alloc](Type *ptr) mutable {
+            ptr->~Type();
+            traits::deallocate(alloc, ptr, 1u);
+        }, allocator};
+    }
+
+    [[nodiscard]] std::size_t find_pool(const id_type id) const ENTT_NOEXCEPT {
+        return lookup.find(id, pools.size());
+    }
+
+    template<typename Component>
+    [[nodiscard]] std::size_t locate() const {
         if constexpr(ENTT_FAST_PATH(has_type_index_v<Component>)) {
             const auto index = type_index<Component>::value();
 
@@ -114,30 +535,154 @@ class basic_registry {
                 pools.resize(size_type(index+1u));
             }
 
-            if(auto &&pdata = pools[index]; !pdata.pool) {
-                pdata.type_id = type_info<Component>::id();
-                pdata.pool.reset(new pool_t<Entity, Component>{});
-                pdata.erase = +[](sparse_set<Entity> &cpool, basic_registry &owner, const Entity entt) {
-                    static_cast<pool_t<Entity, Component> &>(cpool).erase(owner, entt);
-                };
+            return index;
+        } else {
+            const auto pos = find_pool(type_info<Component>::id());
+
+            if(pos == pools.size()) {
+                pools.emplace_back().type_id = type_info<Component>::id();
+                lookup.insert(type_info<Component>::id(), pos);
+            }
+
+            return pos;
+        }
+    }
+
+    template<typename Component, typename Type>
+    void bind(const std::shared_ptr<Type> &instance) const {
+        const auto pos = locate<Component>();
+        auto &pdata = pools[pos];
+        lookup.insert(type_info<Component>::id(), pos);
+        pdata.type_id = type_info<Component>::id();
+        pdata.pool = instance;
+        pdata.instance = static_cast<pool_t<Entity, Component> *>(instance.get());
+        pdata.erase = +[](void *cpool, basic_registry &owner, const Entity entt) {
+            static_cast<pool_t<Entity, Component> *>(cpool)->erase(owner, entt);
+        };
+
+        if constexpr(is_forkable<Component>()) {
+            pdata.fork = +[](basic_registry &from, basic_registry &to) {
+                to.template fork_pool<Component>(from);
+            };
+        }
+    }
+
+    template<typename Type, typename... Member>
+    void bind_members(const std::shared_ptr<Type> &instance, type_list<Member...>) const {
+        // members of a multi-type storage share the same instance
+        (bind<Member>(instance), ...);
+    }
+
+    template<typename... Member>
+    [[nodiscard]] static constexpr bool is_forkable(type_list<Member...>) {
+        return (std::is_copy_constructible_v<Member> && ...);
+    }
+
+    template<typename Component>
+    [[nodiscard]] static constexpr bool is_forkable() {
+        using pool_type = pool_t<Entity, Component>;
+
+        if constexpr(internal::is_multi_pool<pool_type>::value) {
+            return is_forkable(typename pool_type::member_list{});
+        } else {
+            return std::is_copy_constructible_v<Component> && std::is_copy_constructible_v<pool_type>;
+        }
+    }
+
+    template<typename Component>
+    void fork_pool(basic_registry &from) {
+        using pool_type = pool_t<Entity, Component>;
+        auto &cpool = from.assure<Component>();
+
+        if constexpr(internal::is_multi_pool<pool_type>::value) {
+            using instance_type = typename pool_type::instance_type;
+
+            // the first member visited forks the shared instance on behalf of all the others
+            if(!pools[locate<Component>()].pool) {
+                bind_members(allocate<instance_type>(static_cast<instance_type &>(cpool), fork_t{}), typename pool_type::member_list{});
             }
+        } else if constexpr(std::is_constructible_v<pool_type, pool_type &, fork_t>) {
+            bind<Component>(allocate<pool_type>(cpool, fork_t{}));
+        } else {
+            // storage classes that don't share their pages are copied
+            bind<Component>(allocate<pool_type>(std::as_const(cpool)));
+        }
+    }
 
-            curr = pools[index].pool.get();
+    template<typename Component, typename Pool>
+    [[nodiscard]] static auto spawned([[maybe_unused]] Pool &cpool, [[maybe_unused]] const std::size_t pos) {
+        if constexpr(is_eto_eligible_v<Component>) {
+            return std::tuple<>{};
         } else {
-            if(const auto it = std::find_if(pools.cbegin(), pools.cend(), [id = type_info<Component>::id()](const auto &pdata) { return id == pdata.type_id; }); it == pools.cend()) {
-                curr = pools.emplace_back(pool_data{
-                    type_info<Component>::id(),
-                    std::unique_ptr<sparse_set<entity_type>>{new pool_t<Entity, Component>{}},
-                    +[](sparse_set<Entity> &cpool, basic_registry &owner, const Entity entt) {
-                        static_cast<pool_t<Entity, Component> &>(cpool).erase(owner, entt);
-                    }
-                }).pool.get();
-            } else {
-                curr = it->pool.get();
+            // iterators walk the pools backwards, the object in position pos comes pos + 1 steps before the end
+            const auto it = cpool.end() - static_cast<typename std::iterator_traits<decltype(cpool.end())>::difference_type>(pos + 1u);
+            return std::tuple<decltype(*it)>{*it};
+        }
+    }
+
+    template<typename... Component, std::size_t... Index, typename It, typename Func>
+    void spawn(std::index_sequence<Index...>, It first, It last, Func &func) {
+        const auto cpools = std::forward_as_tuple(assure<Component>()...);
+        const std::array<const sparse_set<Entity> *, sizeof...(Index)> shared{&static_cast<const sparse_set<Entity> &>(std::get<Index>(cpools))...};
+        const std::array<std::size_t, sizeof...(Index)> offset{std::get<Index>(cpools).size()...};
+
+        // members of a multi-type storage are assigned and notified at once
+        const auto unique = [&shared](const std::size_t index) {
+            return std::find(shared.cbegin(), shared.cbegin() + index, shared[index]) == (shared.cbegin() + index);
+        };
+
+        try {
+            ((unique(Index) ? std::get<Index>(cpools).append(first, last) : void()), ...);
+
+            auto curr = first;
+
+            for(std::size_t pos{}; curr != last; ++curr, ++pos) {
+                std::apply(func, std::tuple_cat(std::tuple<const entity_type>{*curr}, spawned<Component>(std::get<Index>(cpools), offset[Index] + pos)...));
             }
+        } catch(...) {
+            // listeners haven't seen the components yet, they're dropped silently along with the entities
+            const auto rollback = [first, last](sparse_set<Entity> &cpool, const std::size_t length) {
+                if(cpool.size() != length) {
+                    cpool.erase(first, last);
+                }
+            };
+
+            ((unique(Index) ? rollback(std::get<Index>(cpools), offset[Index]) : void()), ...);
+            destroy(first, last);
+            throw;
         }
 
-        return *static_cast<const pool_t<Entity, Component> *>(curr);
+        ((unique(Index) ? std::get<Index>(cpools).notify(*this, first, last) : void()), ...);
+    }
+
+    template<typename Component>
+    void make_pool() const {
+        using pool_type = pool_t<Entity, Component>;
+
+        if constexpr(internal::is_multi_pool<pool_type>::value) {
+            using instance_type = typename pool_type::instance_type;
+            bind_members(allocate<instance_type>(allocator), typename pool_type::member_list{});
+        } else if constexpr(std::is_constructible_v<pool_type, const typename alloc_traits::allocator_type &>) {
+            bind<Component>(allocate<pool_type>(allocator));
+        } else {
+            bind<Component>(allocate<pool_type>());
+        }
+    }
+
+    template<typename Component>
+    [[nodiscard]] std::size_t slot() const {
+        const auto index = locate<Component>();
+
+        if(!pools[index].pool) {
+            make_pool<Component>();
+        }
+
+        return index;
+    }
+
+    template<typename Component>
+    [[nodiscard]] const pool_t<Entity, Component> & assure() const {
+        return *static_cast<const pool_t<Entity, Component> *>(pools[slot<Component>()].instance);
     }
 
     template<typename Component>
@@ -145,10 +690,85 @@ class basic_registry {
         return const_cast<pool_t<Entity, Component> &>(std::as_const(*this).template assure<Component>());
     }
 
+    [[nodiscard]] bool in_signature(const Entity entt, const std::size_t index) const {
+        const auto pos = size_type(to_integral(entt) & traits_type::entity_mask) * stride + index / mask_digits;
+        return (index < stride * mask_digits) && (pos < signatures.size()) && (signatures[pos] & (mask_type{1u} << (index % mask_digits)));
+    }
+
+    template<typename Func>
+    void signature_each(const Entity entt, Func func) const {
+        if(const auto row = size_type(to_integral(entt) & traits_type::entity_mask) * stride; row < signatures.size()) {
+            // pools are visited from the last to the first one, as if there were no signatures
+            for(auto word = stride; word; --word) {
+                for(auto bits = signatures[row + word - 1u], index = word * mask_digits; bits; --index) {
+                    if(const auto bit = mask_type{1u} << ((index - 1u) % mask_digits); bits & bit) {
+                        bits ^= bit;
+                        func(index - 1u);
+                    }
+                }
+            }
+        }
+    }
+
+    template<typename Component>
+    void track([[maybe_unused]] const Entity entt, [[maybe_unused]] const bool value) {
+        if constexpr(ENTT_SIGNATURE_ENABLED) {
+            const auto index = slot<Component>();
+            const auto row = size_type(to_integral(entt) & traits_type::entity_mask);
+
+            if(value) {
+                if(const auto length = index / mask_digits + 1u; stride < length) {
+                    // masks are stored in rows, a longer one is required for the new pool
+                    std::vector<mask_type, alloc_type<mask_type>> other(entities.size() * length, mask_type{}, alloc_type<mask_type>{allocator});
+
+                    for(size_type pos{}; pos * stride < signatures.size(); ++pos) {
+                        std::copy_n(signatures.data() + pos * stride, stride, other.data() + pos * length);
+                    }
+
+                    signatures.swap(other);
+                    stride = length;
+                } else if(!(row * stride < signatures.size())) {
+                    signatures.resize(entities.size() * stride);
+                }
+
+                signatures[row * stride + index / mask_digits] |= (mask_type{1u} << (index % mask_digits));
+            } else if(in_signature(entt, index)) {
+                signatures[row * stride + index / mask_digits] &= ~(mask_type{1u} << (index % mask_digits));
+            }
+        }
+    }
+
+    template<typename Component>
+    [[nodiscard]] std::shared_ptr<basic_change_log<Entity>> assure_log() {
+        const auto id = type_info<Component>::id();
+
+        if(auto it = std::find_if(logs.cbegin(), logs.cend(), [id](const auto &ldata) { return ldata.type_id == id; }); it != logs.cend()) {
+            return it->log;
+        }
+
+        // logs are shared by all the cached views that iterate a given type
+        auto &&ldata = logs.emplace_back(log_data{id, allocate<basic_change_log<Entity>>(allocator)});
+        on_construct_batch<Component>().template connect<&basic_change_log<Entity>::record>(*ldata.log);
+        on_destroy_batch<Component>().template connect<&basic_change_log<Entity>::record>(*ldata.log);
+        return ldata.log;
+    }
+
+    tick_type next_tick() ENTT_NOEXCEPT {
+        return ++clock;
+    }
+
+    Entity revive(const Entity entt) {
+        if constexpr(ENTT_ALIVE_LIST_ENABLED) {
+            living.emplace(entt);
+        }
+
+        return entt;
+    }
+
     Entity generate_identifier() {
         // traits_type::entity_mask is reserved to allow for null identifiers
         ENTT_ASSERT(static_cast<typename traits_type::entity_type>(entities.size()) < traits_type::entity_mask);
-        return entities.emplace_back(entity_type{static_cast<typename traits_type::entity_type>(entities.size())});
+        return revive(entities.emplace_back(entity_type{static_cast<typename traits_type::entity_type>(entities.size())}));
     }
 
     Entity recycle_identifier() {
@@ -156,10 +776,125 @@ class basic_registry {
         const auto curr = to_integral(destroyed);
         const auto version = to_integral(entities[curr]) & (traits_type::version_mask << traits_type::entity_shift);
         destroyed = entity_type{to_integral(entities[curr]) & traits_type::entity_mask};
-        return entities[curr] = entity_type{curr | version};
+        --available;
+        return revive(entities[curr] = entity_type{curr | version});
+    }
+
+    template<typename... Owned, typename... Get, typename... Exclude>
+    [[nodiscard]] basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>, Owned...> group(get_t<Get...>, exclude_t<Exclude...>, const bool deferred) {
+        static_assert(sizeof...(Owned) + sizeof...(Get) > 0, "Exclusion-only views are not supported");
+        static_assert(sizeof...(Owned) + sizeof...(Get) + sizeof...(Exclude) > 1, "Single component groups are not allowed");
+        static_assert(!(component_in_place_delete_v<Owned> || ...), "In-place deletion is not supported for owned types");
+
+        using handler_type = group_handler<exclude_t<Exclude...>, get_t<std::decay_t<Get>...>, std::decay_t<Owned>...>;
+
+        const auto cpools = std::forward_as_tuple(assure<std::decay_t<Owned>>()..., assure<std::decay_t<Get>>()...);
+        constexpr auto size = sizeof...(Owned) + sizeof...(Get) + sizeof...(Exclude);
+        handler_type *handler = nullptr;
+
+        if(auto it = std::find_if(groups.cbegin(), groups.cend(), [size](const auto &gdata) {
+            return gdata.size == size
+                && (gdata.owned(type_info<std::decay_t<Owned>>::id()) && ...)
+                && (gdata.get(type_info<std::decay_t<Get>>::id()) && ...)
+                && (gdata.exclude(type_info<Exclude>::id()) && ...);
+        }); it != groups.cend())
+        {
+            handler = static_cast<handler_type *>(it->group.get());
+        }
+
+        if(!handler) {
+            group_data candidate = {
+                size,
+                allocate<handler_type>(allocator),
+                []([[maybe_unused]] const id_type ctype) ENTT_NOEXCEPT { return ((ctype == type_info<std::decay_t<Owned>>::id()) || ...); },
+                []([[maybe_unused]] const id_type ctype) ENTT_NOEXCEPT { return ((ctype == type_info<std::decay_t<Get>>::id()) || ...); },
+                []([[maybe_unused]] const id_type ctype) ENTT_NOEXCEPT { return ((ctype == type_info<Exclude>::id()) || ...); },
+                []([[maybe_unused]] const void *instance) {
+                    const auto info = static_cast<const handler_type *>(instance)->dirty.footprint();
+
+                    if constexpr(sizeof...(Owned) == 0) {
+                        const auto extra = static_cast<const handler_type *>(instance)->current.footprint();
+                        return sizeof(handler_type) + info.reserved + info.sparse + extra.reserved + extra.sparse;
+                    } else {
+                        return sizeof(handler_type) + info.reserved + info.sparse;
+                    }
+                },
+                deferred
+            };
+
+            handler = static_cast<handler_type *>(candidate.group.get());
+            handler->pools = std::make_tuple(&assure<std::decay_t<Owned>>()..., &assure<std::decay_t<Get>>()..., &assure<Exclude>()...);
+
+            const void *maybe_valid_if = nullptr;
+            const void *discard_if = nullptr;
+
+            if constexpr(sizeof...(Owned) == 0) {
+                groups.push_back(std::move(candidate));
+            } else {
+                ENTT_ASSERT(std::all_of(groups.cbegin(), groups.cend(), [size](const auto &gdata) {
+                    const auto overlapping = (0u + ... + gdata.owned(type_info<std::decay_t<Owned>>::id()));
+                    const auto sz = overlapping + (0u + ... + gdata.get(type_info<std::decay_t<Get>>::id())) + (0u + ... + gdata.exclude(type_info<Exclude>::id()));
+                    return !overlapping || ((sz == size) || (sz == gdata.size));
+                }));
+
+                // lazy groups cannot be nested, their owned pools aren't partitioned until accessed
+                ENTT_ASSERT(std::none_of(groups.cbegin(), groups.cend(), [deferred](const auto &gdata) {
+                    return (deferred || gdata.lazy) && (0u + ... + gdata.owned(type_info<std::decay_t<Owned>>::id()));
+                }));
+
+                const auto next = std::find_if_not(groups.cbegin(), groups.cend(), [size](const auto &gdata) {
+                    return !(0u + ... + gdata.owned(type_info<std::decay_t<Owned>>::id())) || (size > gdata.size);
+                });
+
+                const auto prev = std::find_if(std::make_reverse_iterator(next), groups.crend(), [](const auto &gdata) {
+                    return (0u + ... + gdata.owned(type_info<std::decay_t<Owned>>::id()));
+                });
+
+                maybe_valid_if = (next == groups.cend() ? maybe_valid_if : next->group.get());
+                discard_if = (prev == groups.crend() ? discard_if : prev->group.get());
+                groups.insert(next, std::move(candidate));
+            }
+
+            (on_construct_batch<std::decay_t<Owned>>().before(maybe_valid_if).template connect<&handler_type::template maybe_valid_if<std::decay_t<Owned>>>(*handler), ...);
+            (on_construct_batch<std::decay_t<Get>>().before(maybe_valid_if).template connect<&handler_type::template maybe_valid_if<std::decay_t<Get>>>(*handler), ...);
+            (on_destroy_batch<Exclude>().before(maybe_valid_if).template connect<&handler_type::template maybe_valid_if<Exclude>>(*handler), ...);
+
+            (on_destroy_batch<std::decay_t<Owned>>().before(discard_if).template connect<&handler_type::template discard_if<std::decay_t<Owned>>>(*handler), ...);
+            (on_destroy_batch<std::decay_t<Get>>().before(discard_if).template connect<&handler_type::template discard_if<std::decay_t<Get>>>(*handler), ...);
+            (on_construct_batch<Exclude>().before(discard_if).template connect<&handler_type::template discard_if<Exclude>>(*handler), ...);
+
+            if constexpr(sizeof...(Owned) == 0) {
+                for(const auto entity: view<Owned..., Get...>(exclude<Exclude...>)) {
+                    handler->current.emplace(entity);
+                }
+            } else {
+                // we cannot iterate backwards because we want to leave behind valid entities in case of owned types
+                const auto *first = std::get<0>(cpools).data();
+                handler->template maybe_valid_if<std::tuple_element_t<0, std::tuple<std::decay_t<Owned>...>>>(*this, first, first + std::get<0>(cpools).size());
+            }
+
+            handler->lazy = deferred;
+        }
+
+        if constexpr(sizeof...(Owned) == 0) {
+            return { handler->current, std::get<pool_t<Entity, std::decay_t<Get>> &>(cpools)... };
+        } else {
+            basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>, Owned...> elem{handler->current, std::get<pool_t<Entity, std::decay_t<Owned>> &>(cpools)... , std::get<pool_t<Entity, std::decay_t<Get>> &>(cpools)...};
+
+            if(handler->lazy) {
+                elem.handler = handler;
+                elem.pending = &handler->dirty;
+                elem.partition = [](void *instance) { static_cast<handler_type *>(instance)->refresh(); };
+                elem.refresh();
+            }
+
+            return elem;
+        }
     }
 
 public:
+    /*! @brief Allocator type. */
+    using allocator_type = typename alloc_traits::allocator_type;
     /*! @brief Underlying entity identifier. */
     using entity_type = Entity;
     /*! @brief Underlying version type. */
@@ -168,7 +903,39 @@ public:
     using size_type = std::size_t;
 
     /*! @brief Default constructor. */
-    basic_registry() = default;
+    basic_registry()
+        : basic_registry{allocator_type{}}
+    {}
+
+    /**
+     * @brief Constructs an empty registry with a given allocator.
+     *
+     * The allocator is used for all the internal data structures, that is
+     * pools, sparse pages, groups and context variables.
+     *
+     * @param alloc Allocator to use for all memory allocations.
+     */
+    explicit basic_registry(const allocator_type &alloc)
+        : allocator{alloc},
+          groups{alloc_type<group_data>{alloc}},
+          logs{alloc_type<log_data>{alloc}},
+          pools{alloc_type<pool_data>{alloc}},
+          lookup{alloc},
+          entities{alloc},
+          vars{alloc},
+          signatures{alloc_type<mask_type>{alloc}},
+          stride{},
+          clock{},
+          living{[&alloc]() {
+              if constexpr(ENTT_ALIVE_LIST_ENABLED) {
+                  return living_type{alloc};
+              } else {
+                  return living_type{};
+              }
+          }()},
+          available{},
+          destroyed{null}
+    {}
 
     /*! @brief Default move constructor. */
     basic_registry(basic_registry &&) = default;
@@ -176,6 +943,77 @@ public:
     /*! @brief Default move assignment operator. @return This registry. */
     basic_registry & operator=(basic_registry &&) = default;
 
+    /**
+     * @brief Returns the associated allocator.
+     * @return The associated allocator.
+     */
+    [[nodiscard]] allocator_type get_allocator() const ENTT_NOEXCEPT {
+        return allocator;
+    }
+
+    /**
+     * @brief Forks a registry.
+     *
+     * The fork contains the same entities and components of the original
+     * registry. The two registries are independent from each other from now
+     * on, however pages of paginated components (see `component_traits`) and
+     * pages of the sparse arrays are shared between them until either of the
+     * two modifies them for the first time. Everything else is copied.<br/>
+     * This makes forking a registry relatively cheap, as long as the most part
+     * of the components are paginated and most pages aren't touched later on.
+     *
+     * @note
+     * Non-const access to a component counts as a modification, regardless of
+     * whether the component is actually changed.
+     *
+     * @warning
+     * Groups, listeners and context variables aren't forked.<br/>
+     * Forking updates the bookkeeping of the shared pages of the registry,
+     * therefore it isn't safe to fork the same registry from multiple threads
+     * at once. The two registries can be used on different threads afterwards.
+     *
+     * @throw std::logic_error If any of the components isn't copy
+     * constructible. The registry is left untouched in this case.
+     *
+     * @return A fork of the registry.
+     */
+    [[nodiscard]] basic_registry fork() {
+        for(auto &&pdata: pools) {
+            if(pdata.pool && !pdata.fork) {
+                throw std::logic_error{"Non-copyable components can't be forked"};
+            }
+        }
+
+        basic_registry other{allocator};
+
+        // pools keep their positions, so that signatures are still valid
+        other.pools.resize(pools.size());
+        other.lookup = lookup;
+
+        for(auto pos = pools.size(); pos; --pos) {
+            other.pools[pos - 1u].type_id = pools[pos - 1u].type_id;
+        }
+
+        for(auto &&pdata: pools) {
+            if(pdata.pool) {
+                pdata.fork(*this, other);
+            }
+        }
+
+        other.entities = entities;
+        other.signatures = signatures;
+        other.stride = stride;
+        other.clock = clock;
+        other.available = available;
+        other.destroyed = destroyed;
+
+        if constexpr(ENTT_ALIVE_LIST_ENABLED) {
+            other.living = living_type{living, fork_t{}};
+        }
+
+        return other;
+    }
+
     /**
      * @brief Prepares a pool for the given type if required.
      * @tparam Component Type of component for which to prepare a pool.
@@ -208,15 +1046,24 @@ public:
      * @brief Returns the number of entities still in use.
      * @return Number of entities still in use.
      */
-    [[nodiscard]] size_type alive() const {
-        auto sz = entities.size();
-        auto curr = destroyed;
-
-        for(; curr != null; --sz) {
-            curr = entities[to_integral(curr) & traits_type::entity_mask];
-        }
+    [[nodiscard]] size_type alive() const ENTT_NOEXCEPT {
+        return entities.size() - available;
+    }
 
-        return sz;
+    /**
+     * @brief Returns the current value of the change clock.
+     *
+     * The clock is advanced every time a component whose pool tracks changes
+     * is constructed, patched or replaced, and the new value is stored as the
+     * change tick of the component. Systems store the value returned by this
+     * function and use it later to visit only the components changed since.
+     *
+     * @sa component_traits
+     *
+     * @return The current value of the change clock.
+     */
+    [[nodiscard]] tick_type tick() const ENTT_NOEXCEPT {
+        return clock;
     }
 
     /**
@@ -270,6 +1117,29 @@ public:
         (assure<Component>().shrink_to_fit(), ...);
     }
 
+    /**
+     * @brief Reclaims the holes left behind by in-place deletions.
+     *
+     * Pools of components that delete by swap-and-pop are left untouched. The
+     * relative order of the elements in a pool is preserved.
+     *
+     * @sa sparse_set::compact
+     *
+     * @tparam Component Types of components to compact, all pools otherwise.
+     */
+    template<typename... Component>
+    void compact() {
+        if constexpr(sizeof...(Component) == 0) {
+            for(auto &&pdata: pools) {
+                if(pdata.pool) {
+                    pdata.pool->compact();
+                }
+            }
+        } else {
+            (assure<Component>().compact(), ...);
+        }
+    }
+
     /**
      * @brief Checks whether the registry or the pools of the given components
      * are empty.
@@ -304,18 +1174,50 @@ public:
      * Empty components aren't explicitly instantiated. Therefore, this function
      * isn't available for them. A compilation error will occur if invoked.
      *
+     * @warning
+     * Paginated components aren't stored contiguously. A compilation error
+     * will occur if invoked for them, see `pages` instead.
+     *
      * @tparam Component Type of component in which one is interested.
      * @return A pointer to the array of components of the given type.
      */
     template<typename Component>
-    [[nodiscard]] const Component * raw() const {
+    [[nodiscard]] auto raw() const {
         return assure<Component>().raw();
     }
 
     /*! @copydoc raw */
     template<typename Component>
-    [[nodiscard]] Component * raw() {
-        return const_cast<Component *>(std::as_const(*this).template raw<Component>());
+    [[nodiscard]] auto raw() {
+        return assure<Component>().raw();
+    }
+
+    /**
+     * @brief Direct access to the pages of a pool of paginated components.
+     *
+     * @sa storage::pages
+     *
+     * @tparam Component Type of component in which one is interested.
+     * @return A pointer to the array of pages of the given type.
+     */
+    template<typename Component>
+    [[nodiscard]] auto pages() const {
+        return assure<Component>().pages();
+    }
+
+    /**
+     * @copybrief pages
+     *
+     * Pages shared with forked registries are copied before they're returned.
+     *
+     * @sa storage::pages
+     *
+     * @tparam Component Type of component in which one is interested.
+     * @return A pointer to the array of pages of the given type.
+     */
+    template<typename Component>
+    [[nodiscard]] auto pages() {
+        return assure<Component>().pages();
     }
 
     /**
@@ -434,16 +1336,18 @@ public:
             for(auto pos = entities.size(); pos < req; ++pos) {
                 entities.emplace_back(destroyed);
                 destroyed = entity_type{static_cast<typename traits_type::entity_type>(pos)};
+                ++available;
             }
 
-            entt = entities.emplace_back(hint);
+            entt = revive(entities.emplace_back(hint));
         } else if(const auto curr = (to_integral(entities[req]) & traits_type::entity_mask); req == curr) {
             entt = create();
         } else {
             auto *it = &destroyed;
             for(; (to_integral(*it) & traits_type::entity_mask) != req; it = &entities[to_integral(*it) & traits_type::entity_mask]);
             *it = entity_type{curr | (to_integral(*it) & (traits_type::version_mask << traits_type::entity_shift))};
-            entt = entities[req] = hint;
+            --available;
+            entt = revive(entities[req] = hint);
         }
 
         return entt;
@@ -489,12 +1393,20 @@ public:
         ENTT_ASSERT(std::all_of(pools.cbegin(), pools.cend(), [](auto &&pdata) { return !pdata.pool || pdata.pool->empty(); }));
         entities.assign(first, last);
         destroyed = null;
+        available = {};
+
+        if constexpr(ENTT_ALIVE_LIST_ENABLED) {
+            living.clear();
+        }
 
         for(std::size_t pos{}, end = entities.size(); pos < end; ++pos) {
             if((to_integral(entities[pos]) & traits_type::entity_mask) != pos) {
                 const auto version = to_integral(entities[pos]) & (traits_type::version_mask << traits_type::entity_shift);
                 entities[pos] = entity_type{to_integral(destroyed) | version};
                 destroyed = entity_type{static_cast<typename traits_type::entity_type>(pos)};
+                ++available;
+            } else {
+                revive(entities[pos]);
             }
         }
     }
@@ -526,10 +1438,16 @@ public:
      */
     void destroy(const entity_type entity, const version_type version) {
         remove_all(entity);
+
+        if constexpr(ENTT_ALIVE_LIST_ENABLED) {
+            living.erase(entity);
+        }
+
         // lengthens the implicit list of destroyed entities
         const auto entt = to_integral(entity) & traits_type::entity_mask;
         entities[entt] = entity_type{to_integral(destroyed) | (typename traits_type::entity_type{version} << traits_type::entity_shift)};
         destroyed = entity_type{entt};
+        ++available;
     }
 
     /**
@@ -596,19 +1514,71 @@ public:
      *
      * @sa emplace
      *
-     * @tparam Component Type of component to create.
-     * @tparam EIt Type of input iterator.
-     * @tparam CIt Type of input iterator.
-     * @param first An iterator to the first element of the range of entities.
-     * @param last An iterator past the last element of the range of entities.
-     * @param from An iterator to the first element of the range of components.
-     * @param to An iterator past the last element of the range of components.
+     * @tparam Component Type of component to create.
+     * @tparam EIt Type of input iterator.
+     * @tparam CIt Type of input iterator.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     * @param from An iterator to the first element of the range of components.
+     * @param to An iterator past the last element of the range of components.
+     */
+    template<typename Component, typename EIt, typename CIt>
+    void insert(EIt first, EIt last, CIt from, CIt to) {
+        static_assert(std::is_constructible_v<Component, typename std::iterator_traits<CIt>::value_type>, "Invalid value type");
+        ENTT_ASSERT(std::all_of(first, last, [this](const auto entity) { return valid(entity); }));
+        assure<Component>().insert(*this, first, last, from, to);
+    }
+
+    /**
+     * @brief Creates new entities and assigns them the given components.
+     *
+     * Components are value-initialized and appended to their pools in a single
+     * pass, pool by pool. Then the function object is invoked once for each
+     * entity to initialize them. Its signature must be equivalent to the
+     * following:
+     *
+     * @code{.cpp}
+     * void(const Entity, Component &...);
+     * @endcode
+     *
+     * Empty types aren't explicitly instantiated and therefore they are never
+     * returned.<br/>
+     * Listeners are notified only after all the components have been assigned
+     * and initialized. Therefore, groups take the new entities in with a single
+     * pass, no matter how many of their types are assigned.<br/>
+     * If the function object throws, the components assigned so far are
+     * removed without notifying listeners, the new entities are destroyed and
+     * the exception is propagated to the caller.
+     *
+     * @tparam Component Types of components to assign.
+     * @tparam It Type of forward iterator.
+     * @tparam Func Type of the function object to invoke.
+     * @param first An iterator to the first element of the range to generate.
+     * @param last An iterator past the last element of the range to generate.
+     * @param func A valid function object.
+     */
+    template<typename... Component, typename It, typename Func>
+    void spawn(It first, It last, Func func) {
+        static_assert(sizeof...(Component) != 0u, "Invalid list of components");
+        static_assert(std::conjunction_v<std::is_same<Component, std::decay_t<Component>>...>, "Invalid component type");
+        create(first, last);
+        spawn<Component...>(std::index_sequence_for<Component...>{}, first, last, func);
+    }
+
+    /**
+     * @brief Creates new entities and assigns them the given components.
+     *
+     * @sa spawn
+     *
+     * @tparam Component Types of components to assign.
+     * @tparam Func Type of the function object to invoke.
+     * @param count Number of entities to create.
+     * @param func A valid function object.
      */
-    template<typename Component, typename EIt, typename CIt>
-    void insert(EIt first, EIt last, CIt from, CIt to) {
-        static_assert(std::is_constructible_v<Component, typename std::iterator_traits<CIt>::value_type>, "Invalid value type");
-        ENTT_ASSERT(std::all_of(first, last, [this](const auto entity) { return valid(entity); }));
-        assure<Component>().insert(*this, first, last, from, to);
+    template<typename... Component, typename Func>
+    void spawn(const size_type count, Func func) {
+        std::vector<entity_type, alloc_type<entity_type>> batch(count, entity_type{}, alloc_type<entity_type>{allocator});
+        spawn<Component...>(batch.data(), batch.data() + batch.size(), std::move(func));
     }
 
     /**
@@ -784,9 +1754,19 @@ public:
     void remove_all(const entity_type entity) {
         ENTT_ASSERT(valid(entity));
 
-        for(auto pos = pools.size(); pos; --pos) {
-            if(auto &pdata = pools[pos-1]; pdata.pool && pdata.pool->contains(entity)) {
-                pdata.erase(*pdata.pool, *this, entity);
+        if constexpr(ENTT_SIGNATURE_ENABLED) {
+            signature_each(entity, [this, entity](const auto index) {
+                // members of a multi-type storage are removed all at once
+                if(in_signature(entity, index)) {
+                    auto &pdata = pools[index];
+                    pdata.erase(pdata.instance, *this, entity);
+                }
+            });
+        } else {
+            for(auto pos = pools.size(); pos; --pos) {
+                if(auto &pdata = pools[pos-1]; pdata.pool && pdata.pool->contains(entity)) {
+                    pdata.erase(pdata.instance, *this, entity);
+                }
             }
         }
     }
@@ -806,7 +1786,12 @@ public:
     template<typename... Component>
     [[nodiscard]] bool has(const entity_type entity) const {
         ENTT_ASSERT(valid(entity));
-        return (assure<Component>().contains(entity) && ...);
+
+        if constexpr(ENTT_SIGNATURE_ENABLED) {
+            return (in_signature(entity, slot<Component>()) && ...);
+        } else {
+            return (assure<Component>().contains(entity) && ...);
+        }
     }
 
     /**
@@ -825,7 +1810,12 @@ public:
     template<typename... Component>
     [[nodiscard]] bool any(const entity_type entity) const {
         ENTT_ASSERT(valid(entity));
-        return (assure<Component>().contains(entity) || ...);
+
+        if constexpr(ENTT_SIGNATURE_ENABLED) {
+            return (in_signature(entity, slot<Component>()) || ...);
+        } else {
+            return (assure<Component>().contains(entity) || ...);
+        }
     }
 
     /**
@@ -847,9 +1837,11 @@ public:
         ENTT_ASSERT(valid(entity));
 
         if constexpr(sizeof...(Component) == 1) {
-            return (assure<Component>().get(entity), ...);
+            const auto &cpool = assure<Component...>();
+            cpool.record(pool_event::get);
+            return cpool.get(entity);
         } else {
-            return std::forward_as_tuple(get<Component>(entity)...);
+            return std::tuple<decltype(get<Component>({}))...>{get<Component>(entity)...};
         }
     }
 
@@ -859,9 +1851,11 @@ public:
         ENTT_ASSERT(valid(entity));
 
         if constexpr(sizeof...(Component) == 1) {
-            return (assure<Component>().get(entity), ...);
+            auto &cpool = assure<Component...>();
+            cpool.record(pool_event::get);
+            return cpool.get(entity);
         } else {
-            return std::forward_as_tuple(get<Component>(entity)...);
+            return std::tuple<decltype(get<Component>({}))...>{get<Component>(entity)...};
         }
     }
 
@@ -893,7 +1887,13 @@ public:
     [[nodiscard]] decltype(auto) get_or_emplace(const entity_type entity, Args &&... args) {
         ENTT_ASSERT(valid(entity));
         auto &cpool = assure<Component>();
-        return cpool.contains(entity) ? cpool.get(entity) : cpool.emplace(*this, entity, std::forward<Args>(args)...);
+
+        if(cpool.contains(entity)) {
+            cpool.record(pool_event::get);
+            return cpool.get(entity);
+        }
+
+        return cpool.emplace(*this, entity, std::forward<Args>(args)...);
     }
 
     /**
@@ -913,7 +1913,9 @@ public:
         ENTT_ASSERT(valid(entity));
 
         if constexpr(sizeof...(Component) == 1) {
-            return (assure<Component>().try_get(entity), ...);
+            const auto &cpool = assure<Component...>();
+            cpool.record(pool_event::get);
+            return cpool.try_get(entity);
         } else {
             return std::make_tuple(try_get<Component>(entity)...);
         }
@@ -925,7 +1927,9 @@ public:
         ENTT_ASSERT(valid(entity));
 
         if constexpr(sizeof...(Component) == 1) {
-            return (assure<Component>().try_get(entity), ...);
+            auto &cpool = assure<Component...>();
+            cpool.record(pool_event::get);
+            return cpool.try_get(entity);
         } else {
             return std::make_tuple(try_get<Component>(entity)...);
         }
@@ -942,6 +1946,8 @@ public:
             each([this](const auto entity) { this->destroy(entity); });
         } else {
             ([this](auto &&cpool) {
+                // tombstones aren't valid entities, get rid of them first
+                cpool.compact();
                 cpool.erase(*this, cpool.sparse_set<entity_type>::begin(), cpool.sparse_set<entity_type>::end());
             }(assure<Component>()), ...);
         }
@@ -957,16 +1963,22 @@ public:
      * void(const Entity);
      * @endcode
      *
-     * This function is fairly slow and should not be used frequently. However,
-     * it's useful for iterating all the entities still in use, regardless of
-     * their components.
+     * This function is fairly slow and should not be used frequently, unless
+     * `ENTT_USE_ALIVE_LIST` is defined. However, it's useful for iterating all
+     * the entities still in use, regardless of their components.<br/>
+     * The entity currently returned can be safely destroyed from within the
+     * function object.
      *
      * @tparam Func Type of the function object to invoke.
      * @param func A valid function object.
      */
     template<typename Func>
     void each(Func func) const {
-        if(destroyed == null) {
+        if constexpr(ENTT_ALIVE_LIST_ENABLED) {
+            for(const auto entt: living) {
+                func(entt);
+            }
+        } else if(!available) {
             for(auto pos = entities.size(); pos; --pos) {
                 func(entities[pos-1]);
             }
@@ -986,7 +1998,13 @@ public:
      */
     [[nodiscard]] bool orphan(const entity_type entity) const {
         ENTT_ASSERT(valid(entity));
-        return std::none_of(pools.cbegin(), pools.cend(), [entity](auto &&pdata) { return pdata.pool && pdata.pool->contains(entity); });
+
+        if constexpr(ENTT_SIGNATURE_ENABLED) {
+            const auto row = size_type(to_integral(entity) & traits_type::entity_mask) * stride;
+            return !(row < signatures.size()) || std::all_of(signatures.cbegin() + row, signatures.cbegin() + row + stride, [](const auto bits) { return !bits; });
+        } else {
+            return std::none_of(pools.cbegin(), pools.cend(), [entity](auto &&pdata) { return pdata.pool && pdata.pool->contains(entity); });
+        }
     }
 
     /**
@@ -1039,6 +2057,32 @@ public:
         return assure<Component>().on_construct();
     }
 
+    /**
+     * @brief Returns a sink object for the given component.
+     *
+     * The sink returned by this function can be used to receive notifications
+     * whenever new instances of the given component are created and assigned
+     * to one or more entities at once.<br/>
+     * The function type for a listener is equivalent to:
+     *
+     * @code{.cpp}
+     * void(basic_registry<Entity> &, const Entity *first, const Entity *last);
+     * @endcode
+     *
+     * Listeners are invoked once for each call to `emplace` or `insert` (and
+     * similar), **after** the components have been assigned to the entities
+     * and **before** the listeners of the `on_construct` sink are invoked.
+     *
+     * @sa sink
+     *
+     * @tparam Component Type of component of which to get the sink.
+     * @return A temporary sink object.
+     */
+    template<typename Component>
+    [[nodiscard]] auto on_construct_batch() {
+        return assure<Component>().on_construct_batch();
+    }
+
     /**
      * @brief Returns a sink object for the given component.
      *
@@ -1087,6 +2131,32 @@ public:
         return assure<Component>().on_destroy();
     }
 
+    /**
+     * @brief Returns a sink object for the given component.
+     *
+     * The sink returned by this function can be used to receive notifications
+     * whenever instances of the given component are removed from one or more
+     * entities at once and thus destroyed.<br/>
+     * The function type for a listener is equivalent to:
+     *
+     * @code{.cpp}
+     * void(basic_registry<Entity> &, const Entity *first, const Entity *last);
+     * @endcode
+     *
+     * Listeners are invoked once for each call to `remove` (and similar),
+     * **after** the listeners of the `on_destroy` sink and **before** the
+     * components have been removed from the entities.
+     *
+     * @sa sink
+     *
+     * @tparam Component Type of component of which to get the sink.
+     * @return A temporary sink object.
+     */
+    template<typename Component>
+    [[nodiscard]] auto on_destroy_batch() {
+        return assure<Component>().on_destroy_batch();
+    }
+
     /**
      * @brief Returns a view for the given components.
      *
@@ -1132,6 +2202,31 @@ public:
         return { assure<std::decay_t<Component>>()..., assure<Exclude>()... };
     }
 
+    /**
+     * @brief Returns a cached view for the given components.
+     *
+     * Cached views keep the list of the entities that have all the given
+     * components and update it lazily, from the change logs of the pools.<br/>
+     * Change logs are created the first time a cached view needs them and are
+     * shared with all the other cached views that iterate the same types. Pools
+     * that aren't iterated by any cached view don't record their changes.
+     *
+     * @note
+     * Contrary to views and groups, cached views are meant to be stored and
+     * reused. Creating a cached view requires to collect all the entities that
+     * have the given components.
+     *
+     * @sa basic_cached_view
+     *
+     * @tparam Component Type of components used to construct the cached view.
+     * @return A newly created cached view.
+     */
+    template<typename... Component>
+    [[nodiscard]] basic_cached_view<Entity, Component...> cached_view() {
+        static_assert(sizeof...(Component) > 1, "Single component cached views are not supported");
+        return { assure<std::decay_t<Component>>()..., assure_log<std::decay_t<Component>>()..., allocator };
+    }
+
     /**
      * @brief Returns a runtime view for the given components.
      *
@@ -1166,13 +2261,13 @@ public:
         std::vector<const sparse_set<Entity> *> filter(std::distance(from, to));
 
         std::transform(first, last, component.begin(), [this](const auto ctype) {
-            const auto it = std::find_if(pools.cbegin(), pools.cend(), [ctype](auto &&pdata) { return pdata.pool && pdata.type_id == ctype; });
-            return it == pools.cend() ? nullptr : it->pool.get();
+            const auto pos = find_pool(ctype);
+            return pos == pools.size() ? nullptr : pools[pos].pool.get();
         });
 
         std::transform(from, to, filter.begin(), [this](const auto ctype) {
-            const auto it = std::find_if(pools.cbegin(), pools.cend(), [ctype](auto &&pdata) { return pdata.pool && pdata.type_id == ctype; });
-            return it == pools.cend() ? nullptr : it->pool.get();
+            const auto pos = find_pool(ctype);
+            return pos == pools.size() ? nullptr : pools[pos].pool.get();
         });
 
         return { std::move(component), std::move(filter) };
@@ -1207,86 +2302,43 @@ public:
      */
     template<typename... Owned, typename... Get, typename... Exclude>
     [[nodiscard]] basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>, Owned...> group(get_t<Get...>, exclude_t<Exclude...> = {}) {
-        static_assert(sizeof...(Owned) + sizeof...(Get) > 0, "Exclusion-only views are not supported");
-        static_assert(sizeof...(Owned) + sizeof...(Get) + sizeof...(Exclude) > 1, "Single component groups are not allowed");
-
-        using handler_type = group_handler<exclude_t<Exclude...>, get_t<std::decay_t<Get>...>, std::decay_t<Owned>...>;
-
-        const auto cpools = std::forward_as_tuple(assure<std::decay_t<Owned>>()..., assure<std::decay_t<Get>>()...);
-        constexpr auto size = sizeof...(Owned) + sizeof...(Get) + sizeof...(Exclude);
-        handler_type *handler = nullptr;
-
-        if(auto it = std::find_if(groups.cbegin(), groups.cend(), [size](const auto &gdata) {
-            return gdata.size == size
-                && (gdata.owned(type_info<std::decay_t<Owned>>::id()) && ...)
-                && (gdata.get(type_info<std::decay_t<Get>>::id()) && ...)
-                && (gdata.exclude(type_info<Exclude>::id()) && ...);
-        }); it != groups.cend())
-        {
-            handler = static_cast<handler_type *>(it->group.get());
-        }
-
-        if(!handler) {
-            group_data candidate = {
-                size,
-                { new handler_type{}, [](void *instance) { delete static_cast<handler_type *>(instance); } },
-                []([[maybe_unused]] const id_type ctype) ENTT_NOEXCEPT { return ((ctype == type_info<std::decay_t<Owned>>::id()) || ...); },
-                []([[maybe_unused]] const id_type ctype) ENTT_NOEXCEPT { return ((ctype == type_info<std::decay_t<Get>>::id()) || ...); },
-                []([[maybe_unused]] const id_type ctype) ENTT_NOEXCEPT { return ((ctype == type_info<Exclude>::id()) || ...); },
-            };
-
-            handler = static_cast<handler_type *>(candidate.group.get());
-
-            const void *maybe_valid_if = nullptr;
-            const void *discard_if = nullptr;
-
-            if constexpr(sizeof...(Owned) == 0) {
-                groups.push_back(std::move(candidate));
-            } else {
-                ENTT_ASSERT(std::all_of(groups.cbegin(), groups.cend(), [size](const auto &gdata) {
-                    const auto overlapping = (0u + ... + gdata.owned(type_info<std::decay_t<Owned>>::id()));
-                    const auto sz = overlapping + (0u + ... + gdata.get(type_info<std::decay_t<Get>>::id())) + (0u + ... + gdata.exclude(type_info<Exclude>::id()));
-                    return !overlapping || ((sz == size) || (sz == gdata.size));
-                }));
-
-                const auto next = std::find_if_not(groups.cbegin(), groups.cend(), [size](const auto &gdata) {
-                    return !(0u + ... + gdata.owned(type_info<std::decay_t<Owned>>::id())) || (size > gdata.size);
-                });
-
-                const auto prev = std::find_if(std::make_reverse_iterator(next), groups.crend(), [](const auto &gdata) {
-                    return (0u + ... + gdata.owned(type_info<std::decay_t<Owned>>::id()));
-                });
-
-                maybe_valid_if = (next == groups.cend() ? maybe_valid_if : next->group.get());
-                discard_if = (prev == groups.crend() ? discard_if : prev->group.get());
-                groups.insert(next, std::move(candidate));
-            }
-
-            (on_construct<std::decay_t<Owned>>().before(maybe_valid_if).template connect<&handler_type::template maybe_valid_if<std::decay_t<Owned>>>(*handler), ...);
-            (on_construct<std::decay_t<Get>>().before(maybe_valid_if).template connect<&handler_type::template maybe_valid_if<std::decay_t<Get>>>(*handler), ...);
-            (on_destroy<Exclude>().before(maybe_valid_if).template connect<&handler_type::template maybe_valid_if<Exclude>>(*handler), ...);
-
-            (on_destroy<std::decay_t<Owned>>().before(discard_if).template connect<&handler_type::discard_if>(*handler), ...);
-            (on_destroy<std::decay_t<Get>>().before(discard_if).template connect<&handler_type::discard_if>(*handler), ...);
-            (on_construct<Exclude>().before(discard_if).template connect<&handler_type::discard_if>(*handler), ...);
-
-            if constexpr(sizeof...(Owned) == 0) {
-                for(const auto entity: view<Owned..., Get...>(exclude<Exclude...>)) {
-                    handler->current.emplace(entity);
-                }
-            } else {
-                // we cannot iterate backwards because we want to leave behind valid entities in case of owned types
-                for(auto *first = std::get<0>(cpools).data(), *last = first + std::get<0>(cpools).size(); first != last; ++first) {
-                    handler->template maybe_valid_if<std::tuple_element_t<0, std::tuple<std::decay_t<Owned>...>>>(*this, *first);
-                }
-            }
-        }
+        return group<Owned...>(get_t<Get...>{}, exclude<Exclude...>, false);
+    }
 
-        if constexpr(sizeof...(Owned) == 0) {
-            return { handler->current, std::get<pool_t<Entity, std::decay_t<Get>> &>(cpools)... };
-        } else {
-            return { handler->current, std::get<pool_t<Entity, std::decay_t<Owned>> &>(cpools)... , std::get<pool_t<Entity, std::decay_t<Get>> &>(cpools)... };
-        }
+    /**
+     * @brief Returns a lazy group for the given components.
+     *
+     * Lazy groups don't arrange their owned pools every time a component is
+     * assigned or removed. Instead, they record the entities that changed and
+     * partition the pools in a single pass the next time they're refreshed, be
+     * it by requesting them again to the registry or by invoking `refresh` on
+     * a group returned previously. Therefore, entities that churn several
+     * components between two refreshes are moved at most once.<br/>
+     * Owned components are still removed from the group immediately, before
+     * they leave their pools. Otherwise, lazy groups offer the same guarantees
+     * of the other groups at the time they're queried.
+     *
+     * @note
+     * The first request for a group decides whether it's lazy or not. Later
+     * requests return the same group, no matter what policy they ask for.
+     *
+     * @warning
+     * Lazy groups cannot share owned types with other groups, nor can they be
+     * nested.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case of
+     * overlapping groups.
+     *
+     * @sa group
+     *
+     * @tparam Owned Types of components owned by the group.
+     * @tparam Get Types of components observed by the group.
+     * @tparam Exclude Types of components used to filter the group.
+     * @return A newly created group.
+     */
+    template<typename... Owned, typename... Get, typename... Exclude>
+    [[nodiscard]] basic_group<Entity, exclude_t<Exclude...>, get_t<Get...>, Owned...> group(get_t<Get...>, exclude_t<Exclude...>, lazy_t) {
+        static_assert(sizeof...(Owned) != 0, "Lazy maintenance is only supported for owning groups");
+        return group<Owned...>(get_t<Get...>{}, exclude<Exclude...>, true);
     }
 
     /**
@@ -1394,6 +2446,9 @@ public:
      * necessarily the type of the one passed along with the other parameters to
      * this member function.
      *
+     * Pools of components that delete in-place are compacted before sorting
+     * them.
+     *
      * @warning
      * Pools of components owned by a group cannot be sorted.<br/>
      * An assertion will abort the execution at runtime in debug mode in case
@@ -1411,9 +2466,48 @@ public:
     void sort(Compare compare, Sort algo = Sort{}, Args &&... args) {
         ENTT_ASSERT(sortable<Component>());
         auto &cpool = assure<Component>();
+        cpool.compact();
         cpool.sort(cpool.begin(), cpool.end(), std::move(compare), std::move(algo), std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief Sorts the pool of entities for the given component according to
+     * the integral keys extracted from the components.
+     *
+     * This is an alternative to `sort` for large pools, that sorts the keys by
+     * means of a radix sort and then moves entities and components in their
+     * final positions in a single pass. The signature of the _getter_ should be
+     * equivalent to the following, where `Key` is an unsigned integral type:
+     *
+     * @code{.cpp}
+     * Key(const Component &);
+     * @endcode
+     *
+     * An executor can be provided to sort the keys on multiple threads (see
+     * `radix_sort` for more details). Iterating the pool returns components in
+     * ascending order of keys afterwards.<br/>
+     * Pools of components that delete in-place are compacted before sorting
+     * them.
+     *
+     * @warning
+     * Pools of components owned by a group cannot be sorted.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case
+     * the pool is owned by a group.
+     *
+     * @tparam Component Type of components to sort.
+     * @tparam Getter Type of _getter_ function object.
+     * @tparam Executor Type of executor, if any.
+     * @param getter A valid _getter_ function object.
+     * @param executor A valid executor, if any.
+     */
+    template<typename Component, typename Getter, typename... Executor>
+    void sort_by_key(Getter getter, Executor &&... executor) {
+        ENTT_ASSERT(sortable<Component>());
+        auto &cpool = assure<Component>();
+        cpool.compact();
+        cpool.sort_by_key(std::move(getter), std::forward<Executor>(executor)...);
+    }
+
     /**
      * @brief Sorts two pools of components in the same way.
      *
@@ -1439,7 +2533,9 @@ public:
      * * All the entities in `A` that are not in `B` are returned in no
      *   particular order after all the other entities.
      *
-     * Any subsequent change to `B` won't affect the order in `A`.
+     * Any subsequent change to `B` won't affect the order in `A`.<br/>
+     * Pools of components that delete in-place are compacted before sorting
+     * them.
      *
      * @warning
      * Pools of components owned by a group cannot be sorted.<br/>
@@ -1452,7 +2548,9 @@ public:
     template<typename To, typename From>
     void sort() {
         ENTT_ASSERT(sortable<To>());
-        assure<To>().respect(assure<From>());
+        auto &cpool = assure<To>();
+        cpool.compact();
+        cpool.respect(assure<From>());
     }
 
     /**
@@ -1478,9 +2576,13 @@ public:
      */
     template<typename Func>
     void visit(entity_type entity, Func func) const {
-        for(auto pos = pools.size(); pos; --pos) {
-            if(const auto &pdata = pools[pos-1]; pdata.pool && pdata.pool->contains(entity)) {
-                func(pdata.type_id);
+        if constexpr(ENTT_SIGNATURE_ENABLED) {
+            signature_each(entity, [this, &func](const auto index) { func(pools[index].type_id); });
+        } else {
+            for(auto pos = pools.size(); pos; --pos) {
+                if(const auto &pdata = pools[pos-1]; pdata.pool && pdata.pool->contains(entity)) {
+                    func(pdata.type_id);
+                }
             }
         }
     }
@@ -1514,6 +2616,126 @@ public:
         }
     }
 
+    /**
+     * @brief Visits the pools of a registry and returns their memory footprint.
+     *
+     * The signature of the function should be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(const id_type, const pool_footprint &);
+     * @endcode
+     *
+     * Pools are returned along with the identifiers of their components.
+     *
+     * @sa visit
+     * @sa type_info
+     *
+     * @warning
+     * Components that share their storage (see `multi_pool`) share their
+     * footprint as well, which is therefore returned once for each of them.
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void footprint(Func func) const {
+        for(auto pos = pools.size(); pos; --pos) {
+            if(const auto &pdata = pools[pos-1]; pdata.pool) {
+                func(pdata.type_id, pdata.pool->footprint());
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the overall memory footprint of a registry.
+     *
+     * Sizes don't include the registry itself. Pools that share their storage
+     * are counted once.
+     *
+     * @return The memory footprint of the registry.
+     */
+    [[nodiscard]] registry_footprint footprint() const {
+        registry_footprint info{};
+
+        for(auto pos = pools.size(); pos; --pos) {
+            const auto &pdata = pools[pos-1];
+
+            if(const auto *cpool = pdata.pool.get(); cpool && std::none_of(pools.cbegin() + pos, pools.cend(), [cpool](const auto &other) { return other.pool.get() == cpool; })) {
+                const auto curr = cpool->footprint();
+                info.pools.packed += curr.packed;
+                info.pools.instances += curr.instances;
+                info.pools.reserved += curr.reserved;
+                info.pools.sparse += curr.sparse;
+                info.pools.pages += curr.pages;
+                info.pools.used_pages += curr.used_pages;
+            }
+        }
+
+        info.lookup = pools.capacity() * sizeof(pool_data) + lookup.footprint();
+        info.entities = entities.capacity() * sizeof(entity_type) + signatures.capacity() * sizeof(mask_type);
+
+        if constexpr(ENTT_ALIVE_LIST_ENABLED) {
+            const auto alive = living.footprint();
+            info.entities += alive.reserved + alive.sparse;
+        }
+        info.groups = groups.capacity() * sizeof(group_data);
+        info.vars = vars.footprint();
+
+        for(auto &&gdata: groups) {
+            info.groups += gdata.footprint(gdata.group.get());
+        }
+
+        return info;
+    }
+
+    /**
+     * @brief Returns the number of operations recorded by the pool of a given
+     * component.
+     *
+     * Counters are updated only if `ENTT_USE_POOL_STATS` is defined, they are
+     * always zero otherwise.
+     *
+     * @sa pool_stats
+     *
+     * @tparam Component Type of component in which one is interested.
+     * @return The number of operations recorded so far.
+     */
+    template<typename Component>
+    [[nodiscard]] pool_stats stats() const {
+        return assure<Component>().stats();
+    }
+
+    /**
+     * @brief Visits the pools of a registry and returns the number of
+     * operations recorded by each of them.
+     *
+     * The signature of the function should be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(const id_type, const pool_stats &);
+     * @endcode
+     *
+     * Pools are returned along with the identifiers of their components.
+     *
+     * @sa visit
+     * @sa type_info
+     *
+     * @warning
+     * Components that share their storage (see `multi_pool`) share their
+     * counters as well, which are therefore returned once for each of them.
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void stats(Func func) const {
+        for(auto pos = pools.size(); pos; --pos) {
+            if(const auto &pdata = pools[pos-1]; pdata.pool) {
+                func(pdata.type_id, pdata.pool->stats());
+            }
+        }
+    }
+
     /**
      * @brief Binds an object to the context of the registry.
      *
@@ -1527,9 +2749,7 @@ public:
      */
     template<typename Type, typename... Args>
     Type & set(Args &&... args) {
-        unset<Type>();
-        vars.push_back(variable_data{type_info<Type>::id(), { new Type{std::forward<Args>(args)...}, [](void *instance) { delete static_cast<Type *>(instance); } }});
-        return *static_cast<Type *>(vars.back().value.get());
+        return vars.template emplace<Type>(std::forward<Args>(args)...);
     }
 
     /**
@@ -1538,9 +2758,7 @@ public:
      */
     template<typename Type>
     void unset() {
-        vars.erase(std::remove_if(vars.begin(), vars.end(), [](auto &&var) {
-            return var.type_id == type_info<Type>::id();
-        }), vars.end());
+        vars.erase(type_info<Type>::id());
     }
 
     /**
@@ -1568,8 +2786,7 @@ public:
      */
     template<typename Type>
     [[nodiscard]] const Type * try_ctx() const {
-        auto it = std::find_if(vars.cbegin(), vars.cend(), [](auto &&var) { return var.type_id == type_info<Type>::id(); });
-        return it == vars.cend() ? nullptr : static_cast<const Type *>(it->value.get());
+        return static_cast<const Type *>(vars.find(type_info<Type>::id()));
     }
 
     /*! @copydoc try_ctx */
@@ -1625,17 +2842,23 @@ public:
      */
     template<typename Func>
     void ctx(Func func) const {
-        for(auto pos = vars.size(); pos; --pos) {
-            func(vars[pos-1].type_id);
-        }
+        vars.each(std::move(func));
     }
 
 private:
-    std::vector<group_data> groups{};
-    mutable std::vector<pool_data> pools{};
-    std::vector<entity_type> entities{};
-    std::vector<variable_data> vars{};
-    entity_type destroyed{null};
+    allocator_type allocator;
+    std::vector<group_data, alloc_type<group_data>> groups;
+    std::vector<log_data, alloc_type<log_data>> logs;
+    mutable std::vector<pool_data, alloc_type<pool_data>> pools;
+    mutable lookup_table lookup;
+    std::vector<entity_type, allocator_type> entities;
+    context_data vars;
+    std::vector<mask_type, alloc_type<mask_type>> signatures;
+    size_type stride;
+    tick_type clock;
+    living_type living;
+    size_type available;
+    entity_type destroyed;
 };
 
 
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <type_traits>
 #include "../config/config.h"
+#include "entity.hpp"
 #include "sparse_set.hpp"
 #include "fwd.hpp"
 
@@ -238,6 +239,52 @@ public:
         }
     }
 
+    /**
+     * @brief Chunked iteration for entities.
+     *
+     * Chunked iteration returns the entities one chunk at a time along with
+     * the sizes of the chunks. Entities within a chunk are laid out in the
+     * same order in all pools, therefore their components can be visited by
+     * tight loops once the position of the first entity is known.<br/>
+     * The signature of the function should be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(const entity_type *, size_type);
+     * @endcode
+     *
+     * Note that the callback can be invoked 0 or more times and no guarantee is
+     * given on the order of the elements.
+     *
+     * @warning
+     * Runtime views know nothing about the types of the components. Chunks may
+     * therefore cross the boundaries of the pages of paginated components.
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void chunked(Func func) const {
+        if(valid()) {
+            const auto *data = pools.front()->data();
+            const auto last = pools.front()->size();
+
+            for(size_type pos{}; pos < last;) {
+                if(data[pos] != null && contains(data[pos])) {
+                    size_type length{1u};
+
+                    for(; pos + length < last && data[pos + length] != null && contains(data[pos + length])
+                            && std::all_of(pools.cbegin() + 1, pools.cend(), [base = data[pos], next = data[pos + length], length](const auto *curr) { return curr->index(next) == curr->index(base) + length; });
+                        ++length);
+
+                    func(data + pos, length);
+                    pos += length;
+                } else {
+                    ++pos;
+                }
+            }
+        }
+    }
+
 private:
     std::vector<const sparse_set<Entity> *> pools;
     std::vector<const sparse_set<Entity> *> filter;
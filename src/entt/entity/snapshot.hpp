@@ -41,7 +41,8 @@ class basic_snapshot {
         while(first != last) {
             const auto entt = *(first++);
 
-            if(reg->template has<Component>(entt)) {
+            // tombstones left behind by in-place deletions aren't valid entities
+            if(entt != null && reg->template has<Component>(entt)) {
                 if constexpr(std::is_empty_v<Component>) {
                     archive(entt);
                 } else {
@@ -58,7 +59,7 @@ class basic_snapshot {
 
         while(begin != last) {
             const auto entt = *(begin++);
-            ((reg->template has<Component>(entt) ? ++size[Indexes] : size[Indexes]), ...);
+            ((entt != null && reg->template has<Component>(entt) ? ++size[Indexes] : size[Indexes]), ...);
         }
 
         (get<Component>(archive, size[Indexes], first, last), ...);
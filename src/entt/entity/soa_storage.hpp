@@ -0,0 +1,636 @@
+#ifndef ENTT_ENTITY_SOA_STORAGE_HPP
+#define ENTT_ENTITY_SOA_STORAGE_HPP
+
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../config/config.h"
+#include "../core/algorithm.hpp"
+#include "../core/type_traits.hpp"
+#include "component.hpp"
+#include "entity.hpp"
+#include "sparse_set.hpp"
+
+
+namespace entt {
+
+
+/**
+ * @brief Proxy reference to an object split among multiple arrays.
+ *
+ * A proxy reference stores a pointer to each of the data members of an object
+ * that is laid out as a structure of arrays. Pointers refer to the arrays of
+ * the given members, therefore they can also be used to visit the members of
+ * the following objects.
+ *
+ * @tparam Type Type of object, possibly const qualified.
+ * @tparam Member Pointers to the data members of the object.
+ */
+template<typename Type, auto... Member>
+class soa_reference {
+    template<auto Field>
+    using field_type = std::remove_reference_t<decltype(std::declval<Type &>().*Field)>;
+
+    template<auto Field>
+    [[nodiscard]] static constexpr std::size_t index_of() ENTT_NOEXCEPT {
+        std::size_t pos{};
+        static_cast<void>(((std::is_same_v<integral_constant<Field>, integral_constant<Member>> || (++pos, false)) || ...));
+        return pos;
+    }
+
+public:
+    /*! @brief Type of the referenced object. */
+    using value_type = std::remove_const_t<Type>;
+
+    /**
+     * @brief Constructs a proxy reference from a set of pointers.
+     * @param field Pointers to the data members of the referenced object.
+     */
+    soa_reference(field_type<Member> *... field) ENTT_NOEXCEPT
+        : fields{field...}
+    {}
+
+    /*! @brief Default copy constructor. */
+    soa_reference(const soa_reference &) ENTT_NOEXCEPT = default;
+
+    /**
+     * @brief Assigns the members of another object to the referenced one.
+     * @param other The proxy reference from which to copy the members.
+     * @return This proxy reference.
+     */
+    const soa_reference & operator=(const soa_reference &other) const {
+        return (*this = static_cast<value_type>(other));
+    }
+
+    /**
+     * @brief Assigns the members of an object to the referenced one.
+     * @param value The object from which to copy the members.
+     * @return This proxy reference.
+     */
+    const soa_reference & operator=(value_type value) const {
+        std::apply([&value](auto *... field) { ((*field = std::move(value.*Member)), ...); }, fields);
+        return *this;
+    }
+
+    /**
+     * @brief Gathers the members of the referenced object in a new instance.
+     * @return A copy of the referenced object.
+     */
+    operator value_type() const {
+        return std::apply([](auto *... field) {
+            value_type value{};
+            ((value.*Member = *field), ...);
+            return value;
+        }, fields);
+    }
+
+    /**
+     * @brief Returns a data member of the referenced object.
+     * @tparam Field Pointer to the data member to return.
+     * @return A reference to the data member.
+     */
+    template<auto Field>
+    [[nodiscard]] field_type<Field> & get() const ENTT_NOEXCEPT {
+        return *data<Field>();
+    }
+
+    /**
+     * @brief Direct access to the array of a data member.
+     *
+     * The returned pointer refers to the member of the referenced object in the
+     * array of all the members of the same type. Therefore, it can be used to
+     * visit the members of the objects that follow the referenced one.
+     *
+     * @tparam Field Pointer to the data member to return.
+     * @return A pointer to the data member.
+     */
+    template<auto Field>
+    [[nodiscard]] field_type<Field> * data() const ENTT_NOEXCEPT {
+        static_assert(index_of<Field>() < sizeof...(Member), "Invalid data member");
+        return std::get<index_of<Field>()>(fields);
+    }
+
+private:
+    std::tuple<field_type<Member> *...> fields;
+};
+
+
+/**
+ * @brief Structure of arrays storage implementation.
+ *
+ * Data members of the objects are stored in separate contiguous arrays, one for
+ * each member. This layout is intended for aggregates of which only a few
+ * members are accessed at a time during iterations, since loops then stream
+ * only the data they actually use.<br/>
+ * Objects don't exist as such within the storage. Therefore, functions that
+ * usually return references to objects return proxy references (see
+ * `soa_reference`) instead. Pointers to the arrays of members are available
+ * through the same proxy references.
+ *
+ * @warning
+ * Objects must be default constructible and all their data members must be
+ * listed. Those that aren't listed aren't stored by the storage.
+ *
+ * @sa storage
+ *
+ * @tparam Entity A valid entity type (see entt_traits for more details).
+ * @tparam Type Type of objects assigned to the entities.
+ * @tparam Member Pointers to the data members of the objects.
+ */
+template<typename Entity, typename Type, auto... Member>
+class soa_storage: public sparse_set<Entity, typename std::allocator_traits<ENTT_ALLOCATOR<Type>>::template rebind_alloc<Entity>> {
+    static_assert(sizeof...(Member) != 0u, "At least one data member is required");
+    static_assert((std::is_same_v<member_class_t<decltype(Member)>, Type> && ...), "Invalid data member");
+    static_assert(component_page_size_v<Type> == 0u, "Paginated objects aren't supported");
+
+    static constexpr auto layout = component_traits<Type>::sparse;
+
+    using traits_type = entt_traits<Entity>;
+    using alloc_traits = std::allocator_traits<ENTT_ALLOCATOR<Type>>;
+    using underlying_type = sparse_set<Entity, typename alloc_traits::template rebind_alloc<Entity>>;
+
+    template<auto Field>
+    using field_container = std::vector<
+        std::remove_reference_t<decltype(std::declval<Type &>().*Field)>,
+        typename alloc_traits::template rebind_alloc<std::remove_reference_t<decltype(std::declval<Type &>().*Field)>>
+    >;
+
+    using container_type = std::tuple<field_container<Member>...>;
+
+    template<bool Const>
+    class soa_iterator final {
+        friend class soa_storage;
+
+        using instance_type = std::conditional_t<Const, const container_type, container_type>;
+        using index_type = typename traits_type::difference_type;
+
+        soa_iterator(instance_type &ref, const index_type idx) ENTT_NOEXCEPT
+            : instances{&ref}, index{idx}
+        {}
+
+    public:
+        using difference_type = index_type;
+        using value_type = Type;
+        using pointer = void;
+        using reference = soa_reference<std::conditional_t<Const, const Type, Type>, Member...>;
+        using iterator_category = std::random_access_iterator_tag;
+
+        soa_iterator() ENTT_NOEXCEPT = default;
+
+        soa_iterator & operator++() ENTT_NOEXCEPT {
+            return --index, *this;
+        }
+
+        soa_iterator operator++(int) ENTT_NOEXCEPT {
+            soa_iterator orig = *this;
+            return ++(*this), orig;
+        }
+
+        soa_iterator & operator--() ENTT_NOEXCEPT {
+            return ++index, *this;
+        }
+
+        soa_iterator operator--(int) ENTT_NOEXCEPT {
+            soa_iterator orig = *this;
+            return operator--(), orig;
+        }
+
+        soa_iterator & operator+=(const difference_type value) ENTT_NOEXCEPT {
+            index -= value;
+            return *this;
+        }
+
+        soa_iterator operator+(const difference_type value) const ENTT_NOEXCEPT {
+            soa_iterator copy = *this;
+            return (copy += value);
+        }
+
+        soa_iterator & operator-=(const difference_type value) ENTT_NOEXCEPT {
+            return (*this += -value);
+        }
+
+        soa_iterator operator-(const difference_type value) const ENTT_NOEXCEPT {
+            return (*this + -value);
+        }
+
+        difference_type operator-(const soa_iterator &other) const ENTT_NOEXCEPT {
+            return other.index - index;
+        }
+
+        [[nodiscard]] reference operator[](const difference_type value) const ENTT_NOEXCEPT {
+            const auto pos = size_type(index-value-1);
+            return std::apply([pos](auto &... field) { return reference{field.data() + pos...}; }, *instances);
+        }
+
+        [[nodiscard]] bool operator==(const soa_iterator &other) const ENTT_NOEXCEPT {
+            return other.index == index;
+        }
+
+        [[nodiscard]] bool operator!=(const soa_iterator &other) const ENTT_NOEXCEPT {
+            return !(*this == other);
+        }
+
+        [[nodiscard]] bool operator<(const soa_iterator &other) const ENTT_NOEXCEPT {
+            return index > other.index;
+        }
+
+        [[nodiscard]] bool operator>(const soa_iterator &other) const ENTT_NOEXCEPT {
+            return index < other.index;
+        }
+
+        [[nodiscard]] bool operator<=(const soa_iterator &other) const ENTT_NOEXCEPT {
+            return !(*this > other);
+        }
+
+        [[nodiscard]] bool operator>=(const soa_iterator &other) const ENTT_NOEXCEPT {
+            return !(*this < other);
+        }
+
+        [[nodiscard]] reference operator*() const ENTT_NOEXCEPT {
+            return operator[](0);
+        }
+
+    private:
+        instance_type *instances;
+        index_type index;
+    };
+
+    template<typename Func>
+    void visit(Func func) {
+        std::apply([&func](auto &... field) { (func(field), ...); }, instances);
+    }
+
+protected:
+    /**
+     * @copybrief underlying_type::move_element
+     * @param from Position of the element to move.
+     * @param to Position in which to move the element.
+     */
+    void move_element(const std::size_t from, const std::size_t to) override {
+        visit([from, to](auto &field) { field[to] = std::move(field[from]); });
+    }
+
+    /**
+     * @copybrief underlying_type::truncate
+     * @param length Number of elements to keep.
+     */
+    void truncate(const std::size_t length) override {
+        visit([length](auto &field) { field.erase(field.begin() + length, field.end()); });
+    }
+
+public:
+    /*! @brief Allocator type. */
+    using allocator_type = typename alloc_traits::allocator_type;
+    /*! @brief Type of the objects associated with the entities. */
+    using object_type = Type;
+    /*! @brief Underlying entity identifier. */
+    using entity_type = Entity;
+    /*! @brief Unsigned integer type. */
+    using size_type = std::size_t;
+    /*! @brief Proxy reference type. */
+    using reference = soa_reference<Type, Member...>;
+    /*! @brief Constant proxy reference type. */
+    using const_reference = soa_reference<const Type, Member...>;
+    /*! @brief Random access iterator type. */
+    using iterator = soa_iterator<false>;
+    /*! @brief Constant random access iterator type. */
+    using const_iterator = soa_iterator<true>;
+
+    /*! @brief Default constructor. */
+    soa_storage()
+        : soa_storage{allocator_type{}}
+    {}
+
+    /**
+     * @brief Constructs an empty storage with a given allocator.
+     * @param alloc Allocator to use for all memory allocations.
+     */
+    explicit soa_storage(const allocator_type &alloc)
+        : underlying_type{component_traits<Type>::sparse, component_traits<Type>::deletion, typename underlying_type::allocator_type{alloc}},
+          instances{field_container<Member>{typename field_container<Member>::allocator_type{alloc}}...}
+    {}
+
+    /**
+     * @brief Returns the associated allocator.
+     * @return The associated allocator.
+     */
+    [[nodiscard]] allocator_type get_allocator() const ENTT_NOEXCEPT {
+        return allocator_type{underlying_type::get_allocator()};
+    }
+
+    /**
+     * @brief Increases the capacity of a storage.
+     *
+     * If the new capacity is greater than the current capacity, new storage is
+     * allocated, otherwise the method does nothing.
+     *
+     * @param cap Desired capacity.
+     */
+    void reserve(const size_type cap) {
+        underlying_type::reserve(cap);
+        visit([cap](auto &field) { field.reserve(cap); });
+    }
+
+    /*! @brief Requests the removal of unused capacity. */
+    void shrink_to_fit() {
+        underlying_type::shrink_to_fit();
+        visit([](auto &field) { field.shrink_to_fit(); });
+    }
+
+    /**
+     * @brief Direct access to the arrays of data members.
+     *
+     * The returned proxy reference refers to the first element of each array.
+     * Therefore, the range `[raw().template data<Field>(), raw().template
+     * data<Field>() + size())` is always a valid range for any listed member,
+     * even if the container is empty.
+     *
+     * @note
+     * Members are in the reverse order as returned by the `begin`/`end`
+     * iterators.
+     *
+     * @return A proxy reference to the arrays of data members.
+     */
+    [[nodiscard]] const_reference raw() const ENTT_NOEXCEPT {
+        return std::apply([](auto &... field) { return const_reference{field.data()...}; }, instances);
+    }
+
+    /*! @copydoc raw */
+    [[nodiscard]] reference raw() ENTT_NOEXCEPT {
+        return std::apply([](auto &... field) { return reference{field.data()...}; }, instances);
+    }
+
+    /**
+     * @brief Returns an iterator to the beginning.
+     *
+     * The returned iterator points to the first instance of the internal
+     * arrays. If the storage is empty, the returned iterator will be equal to
+     * `end()`.
+     *
+     * @return An iterator to the first instance of the internal arrays.
+     */
+    [[nodiscard]] const_iterator cbegin() const ENTT_NOEXCEPT {
+        const typename traits_type::difference_type pos = underlying_type::size();
+        return const_iterator{instances, pos};
+    }
+
+    /*! @copydoc cbegin */
+    [[nodiscard]] const_iterator begin() const ENTT_NOEXCEPT {
+        return cbegin();
+    }
+
+    /*! @copydoc begin */
+    [[nodiscard]] iterator begin() ENTT_NOEXCEPT {
+        const typename traits_type::difference_type pos = underlying_type::size();
+        return iterator{instances, pos};
+    }
+
+    /**
+     * @brief Returns an iterator to the end.
+     *
+     * The returned iterator points to the element following the last instance
+     * of the internal arrays. Attempting to dereference the returned iterator
+     * results in undefined behavior.
+     *
+     * @return An iterator to the element following the last instance of the
+     * internal arrays.
+     */
+    [[nodiscard]] const_iterator cend() const ENTT_NOEXCEPT {
+        return const_iterator{instances, {}};
+    }
+
+    /*! @copydoc cend */
+    [[nodiscard]] const_iterator end() const ENTT_NOEXCEPT {
+        return cend();
+    }
+
+    /*! @copydoc end */
+    [[nodiscard]] iterator end() ENTT_NOEXCEPT {
+        return iterator{instances, {}};
+    }
+
+    /**
+     * @brief Returns the object associated with an entity.
+     *
+     * @warning
+     * Attempting to use an entity that doesn't belong to the storage results in
+     * undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * storage doesn't contain the given entity.
+     *
+     * @param entt A valid entity identifier.
+     * @return A proxy reference to the object associated with the entity.
+     */
+    [[nodiscard]] const_reference get(const entity_type entt) const {
+        const auto pos = underlying_type::template index<layout>(entt);
+        return std::apply([pos](auto &... field) { return const_reference{field.data() + pos...}; }, instances);
+    }
+
+    /*! @copydoc get */
+    [[nodiscard]] reference get(const entity_type entt) {
+        const auto pos = underlying_type::template index<layout>(entt);
+        return std::apply([pos](auto &... field) { return reference{field.data() + pos...}; }, instances);
+    }
+
+    /**
+     * @brief Assigns an entity to a storage and constructs its object.
+     *
+     * The object is constructed from the arguments provided and then split
+     * among the arrays of the data members.
+     *
+     * @warning
+     * Attempting to use an entity that already belongs to the storage results
+     * in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * storage already contains the given entity.
+     *
+     * @tparam Args Types of arguments to use to construct the object.
+     * @param entt A valid entity identifier.
+     * @param args Parameters to use to construct an object for the entity.
+     */
+    template<typename... Args>
+    void emplace(const entity_type entt, Args &&... args) {
+        const auto length = underlying_type::size();
+        reserve(length + 1u);
+
+        try {
+            if constexpr(std::is_aggregate_v<object_type>) {
+                push_back(Type{std::forward<Args>(args)...});
+            } else {
+                push_back(Type(std::forward<Args>(args)...));
+            }
+
+            // entity goes after component in case constructor throws
+            underlying_type::template emplace<layout>(entt);
+        } catch(...) {
+            // fields that already grew are brought back in sync with the packed array
+            truncate(length);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Assigns one or more entities to a storage and constructs their
+     * objects from a given instance.
+     *
+     * @warning
+     * Attempting to assign an entity that already belongs to the storage
+     * results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * storage already contains the given entity.
+     *
+     * @tparam It Type of input iterator.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     * @param value An instance of the object to construct.
+     */
+    template<typename It>
+    void insert(It first, It last, const object_type &value = {}) {
+        const auto length = underlying_type::size();
+        const auto count = static_cast<size_type>(std::distance(first, last));
+        reserve(length + count);
+
+        try {
+            std::apply([count, &value](auto &... field) { (field.insert(field.end(), count, value.*Member), ...); }, instances);
+        } catch(...) {
+            truncate(length);
+            throw;
+        }
+
+        // entities go after components in case constructors throw
+        underlying_type::template insert<layout>(first, last);
+    }
+
+    /**
+     * @brief Assigns one or more entities to a storage and constructs their
+     * objects from a given range.
+     *
+     * @sa construct
+     *
+     * @tparam EIt Type of input iterator.
+     * @tparam CIt Type of input iterator.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     * @param from An iterator to the first element of the range of objects.
+     * @param to An iterator past the last element of the range of objects.
+     */
+    template<typename EIt, typename CIt>
+    void insert(EIt first, EIt last, CIt from, CIt to) {
+        const auto length = underlying_type::size();
+        reserve(length + static_cast<size_type>(std::distance(from, to)));
+
+        try {
+            for(; from != to; ++from) {
+                push_back(*from);
+            }
+        } catch(...) {
+            truncate(length);
+            throw;
+        }
+
+        // entities go after components in case constructors throw
+        underlying_type::template insert<layout>(first, last);
+    }
+
+    /**
+     * @brief Swaps entities and objects in the internal packed arrays.
+     *
+     * @warning
+     * Attempting to swap entities that don't belong to the sparse set results
+     * in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * sparse set doesn't contain the given entities.
+     *
+     * @param lhs A valid entity identifier.
+     * @param rhs A valid entity identifier.
+     */
+    void swap(const entity_type lhs, const entity_type rhs) override {
+        const auto from = underlying_type::template index<layout>(lhs);
+        const auto to = underlying_type::template index<layout>(rhs);
+        visit([from, to](auto &field) { std::swap(field[from], field[to]); });
+        underlying_type::swap(lhs, rhs);
+    }
+
+    /**
+     * @brief Sort elements according to the given comparison function.
+     *
+     * @sa storage::sort
+     *
+     * The comparison function object receives either two entities or two
+     * constant proxy references to the objects to compare.
+     *
+     * @warning
+     * Storage classes that delete in-place must be compacted before sorting
+     * them.
+     *
+     * @tparam Compare Type of comparison function object.
+     * @tparam Sort Type of sort function object.
+     * @tparam Args Types of arguments to forward to the sort function object.
+     * @param first An iterator to the first element of the range to sort.
+     * @param last An iterator past the last element of the range to sort.
+     * @param compare A valid comparison function object.
+     * @param algo A valid sort function object.
+     * @param args Arguments to forward to the sort function object, if any.
+     */
+    template<typename Compare, typename Sort = std_sort, typename... Args>
+    void sort(iterator first, iterator last, Compare compare, Sort algo = Sort{}, Args &&... args) {
+        ENTT_ASSERT(!(last < first));
+        ENTT_ASSERT(!(last > end()));
+
+        const auto from = underlying_type::begin() + std::distance(begin(), first);
+        const auto to = from + std::distance(first, last);
+
+        const auto apply = [this](const auto lhs, const auto rhs) {
+            const auto pos = underlying_type::template index<layout>(lhs);
+            const auto other = underlying_type::template index<layout>(rhs);
+            visit([pos, other](auto &field) { std::swap(field[pos], field[other]); });
+        };
+
+        if constexpr(std::is_invocable_v<Compare, const_reference, const_reference>) {
+            underlying_type::arrange(from, to, std::move(apply), [this, compare = std::move(compare)](const auto lhs, const auto rhs) {
+                return compare(std::as_const(*this).get(lhs), std::as_const(*this).get(rhs));
+            }, std::move(algo), std::forward<Args>(args)...);
+        } else {
+            underlying_type::arrange(from, to, std::move(apply), std::move(compare), std::move(algo), std::forward<Args>(args)...);
+        }
+    }
+
+    /**
+     * @brief Returns the memory footprint of a storage.
+     * @return The memory footprint of the storage.
+     */
+    [[nodiscard]] pool_footprint footprint() const override {
+        auto info = underlying_type::footprint();
+
+        std::apply([&info](const auto &... field) {
+            ((info.instances += field.size() * sizeof(typename std::decay_t<decltype(field)>::value_type)), ...);
+            ((info.reserved += field.capacity() * sizeof(typename std::decay_t<decltype(field)>::value_type)), ...);
+        }, instances);
+
+        return info;
+    }
+
+    /*! @brief Clears a storage. */
+    void clear() {
+        underlying_type::clear();
+        visit([](auto &field) { field.clear(); });
+    }
+
+private:
+    void push_back(Type value) {
+        std::apply([&value](auto &... field) { (field.push_back(std::move(value.*Member)), ...); }, instances);
+    }
+
+    container_type instances;
+};
+
+
+}
+
+
+#endif
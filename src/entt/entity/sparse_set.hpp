@@ -2,21 +2,128 @@
 #define ENTT_ENTITY_SPARSE_SET_HPP
 
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <iterator>
 #include <utility>
 #include <vector>
 #include <memory>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
 #include <type_traits>
 #include "../config/config.h"
 #include "../core/algorithm.hpp"
 #include "entity.hpp"
 #include "fwd.hpp"
+#include "utility.hpp"
 
 
 namespace entt {
 
 
+/**
+ * @brief Memory footprint of a pool.
+ *
+ * Sizes are in bytes, unless otherwise specified.
+ */
+struct pool_footprint {
+    /*! @brief Bytes used by the packed array of entities. */
+    std::size_t packed{};
+    /*! @brief Bytes used by the objects assigned to the entities, if any. */
+    std::size_t instances{};
+    /*! @brief Bytes allocated for entities and objects, unused capacity included. */
+    std::size_t reserved{};
+    /*! @brief Bytes allocated for the sparse array, either paged or hashed. */
+    std::size_t sparse{};
+    /*! @brief Number of sparse pages allocated. */
+    std::size_t pages{};
+    /*! @brief Number of sparse pages that refer to at least one entity. */
+    std::size_t used_pages{};
+};
+
+
+/**
+ * @brief Number of operations recorded by a pool.
+ *
+ * Counters are updated only if `ENTT_USE_POOL_STATS` is defined, they are
+ * always zero otherwise.
+ */
+struct pool_stats {
+    /*! @brief Number of entities assigned to the pool. */
+    std::size_t emplace{};
+    /*! @brief Number of entities removed from the pool. */
+    std::size_t erase{};
+    /*! @brief Number of objects patched or replaced. */
+    std::size_t patch{};
+    /*! @brief Number of objects returned by entity through a registry. */
+    std::size_t get{};
+    /*! @brief Number of sparse pages allocated, copies of shared pages included. */
+    std::size_t pages{};
+    /*! @brief Number of signals published to at least one listener. */
+    std::size_t publish{};
+};
+
+
+/**
+ * @cond TURN_OFF_DOXYGEN
+ * Internal details not to be documented.
+ */
+
+
+namespace internal {
+
+
+template<bool>
+struct pool_counters {
+    void add(const pool_event, const std::size_t) const ENTT_NOEXCEPT {}
+
+    [[nodiscard]] std::size_t value(const pool_event) const ENTT_NOEXCEPT {
+        return {};
+    }
+};
+
+
+template<>
+struct pool_counters<true> {
+    pool_counters() ENTT_NOEXCEPT
+        : counters{}
+    {}
+
+    // counters belong to an instance, copies and moves start from zero
+    pool_counters(const pool_counters &) ENTT_NOEXCEPT
+        : pool_counters{}
+    {}
+
+    pool_counters & operator=(const pool_counters &) ENTT_NOEXCEPT {
+        return *this;
+    }
+
+    void add(const pool_event event, const std::size_t count) const ENTT_NOEXCEPT {
+        // accesses are recorded from const member functions, possibly from multiple threads
+        counters[static_cast<std::size_t>(event)].fetch_add(count, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t value(const pool_event event) const ENTT_NOEXCEPT {
+        return counters[static_cast<std::size_t>(event)].load(std::memory_order_relaxed);
+    }
+
+private:
+    mutable std::array<std::atomic<std::size_t>, 6u> counters;
+};
+
+
+}
+
+
+/**
+ * Internal details not to be documented.
+ * @endcond
+ */
+
+
 /**
  * @brief Basic sparse set implementation.
  *
@@ -37,20 +144,45 @@ namespace entt {
  * no guarantees that entities are returned in the insertion order when iterate
  * a sparse set. Do not make assumption on the order in any case.
  *
+ * @note
+ * The sparse array is paged by default. Sparse sets that are expected to
+ * contain a few elements spread over a large range of identifiers can use an
+ * open addressing hash table instead (see `sparse_policy`). It requires memory
+ * proportional to the number of elements, at the price of slightly slower
+ * lookups.
+ *
+ * @note
+ * Sparse sets that delete in-place (see `deletion_policy`) leave tombstones in
+ * the packed array when entities are erased. Tombstones are null entities that
+ * are never contained in a sparse set and therefore are skipped by all checks
+ * based on `contains`. They're reclaimed when the sparse set is compacted.
+ *
  * @tparam Entity A valid entity type (see entt_traits for more details).
+ * @tparam Allocator Type of allocator used to manage memory and elements.
  */
-template<typename Entity>
-class sparse_set {
+template<typename Entity, typename Allocator = ENTT_ALLOCATOR<Entity>>
+class sparse_set: private internal::pool_counters<ENTT_POOL_STATS_ENABLED> {
     static_assert(ENTT_PAGE_SIZE && ((ENTT_PAGE_SIZE & (ENTT_PAGE_SIZE - 1)) == 0), "ENTT_PAGE_SIZE must be a power of two");
     static constexpr auto entt_per_page = ENTT_PAGE_SIZE / sizeof(Entity);
 
     using traits_type = entt_traits<Entity>;
-    using page_type = std::unique_ptr<Entity[]>;
+    using alloc_traits = typename std::allocator_traits<Allocator>::template rebind_traits<Entity>;
+    using page_type = Entity *;
+    using page_alloc_type = typename alloc_traits::template rebind_alloc<page_type>;
+    // copies of a set can be destroyed or modified on different threads
+    using counter_type = std::atomic<std::size_t>;
+    using counter_alloc_type = typename alloc_traits::template rebind_alloc<counter_type>;
+    using owner_alloc_type = typename alloc_traits::template rebind_alloc<counter_type *>;
+    using bucket_type = std::pair<Entity, Entity>;
+    using bucket_alloc_type = typename alloc_traits::template rebind_alloc<bucket_type>;
+    using packed_type = std::vector<Entity, typename alloc_traits::allocator_type>;
+
+    // the allocator is bypassed only on demand and only if it's the default one
+    static constexpr bool zeroed_pages = ENTT_ZEROED_PAGES_ENABLED && std::is_same_v<typename alloc_traits::allocator_type, std::allocator<Entity>>;
 
     class sparse_set_iterator final {
-        friend class sparse_set<Entity>;
+        friend class sparse_set;
 
-        using packed_type = std::vector<Entity>;
         using index_type = typename traits_type::difference_type;
 
         sparse_set_iterator(const packed_type &ref, const index_type idx) ENTT_NOEXCEPT
@@ -157,23 +289,242 @@ class sparse_set {
         return size_type{to_integral(entt) & (entt_per_page - 1)};
     }
 
+    [[nodiscard]] static Entity encode(const std::size_t pos) ENTT_NOEXCEPT {
+        // null is encoded as zero, therefore zeroed memory is a valid sparse array
+        return entity_type{static_cast<typename traits_type::entity_type>(pos) ^ traits_type::entity_mask};
+    }
+
+    [[nodiscard]] static std::size_t decode(const Entity elem) ENTT_NOEXCEPT {
+        return size_type{to_integral(elem) ^ traits_type::entity_mask};
+    }
+
+    [[nodiscard]] page_type allocate_page(const page_type from) {
+        page_type page{};
+        record(pool_event::page);
+
+        if constexpr(zeroed_pages) {
+            // zeroed pages come almost for free from the system in many cases
+            page = static_cast<page_type>(from ? std::malloc(entt_per_page * sizeof(Entity)) : std::calloc(entt_per_page, sizeof(Entity)));
+
+            if(!page) {
+                throw std::bad_alloc{};
+            }
+        } else {
+            page = alloc_traits::allocate(allocator, entt_per_page);
+        }
+
+        if(from) {
+            std::uninitialized_copy_n(from, entt_per_page, page);
+        } else if constexpr(!zeroed_pages) {
+            std::uninitialized_fill_n(page, entt_per_page, entity_type{});
+        }
+
+        return page;
+    }
+
+    void deallocate_page(const page_type page) {
+        if constexpr(zeroed_pages) {
+            std::free(page);
+        } else if(page) {
+            alloc_traits::deallocate(allocator, page, entt_per_page);
+        }
+    }
+
+    void release_counter(counter_type *counter) {
+        counter_alloc_type alloc{allocator};
+        std::allocator_traits<counter_alloc_type>::destroy(alloc, counter);
+        std::allocator_traits<counter_alloc_type>::deallocate(alloc, counter, 1u);
+    }
+
+    void release_page(const std::size_t pos) {
+        if(pos < owners.size() && owners[pos]) {
+            // the last owner of a shared page is the one that frees it
+            auto *counter = std::exchange(owners[pos], nullptr);
+
+            if(--*counter != 0u) {
+                return;
+            }
+
+            release_counter(counter);
+        }
+
+        deallocate_page(sparse[pos]);
+    }
+
+    void unshare(const std::size_t pos) {
+        if(pos < owners.size() && owners[pos]) {
+            if(*owners[pos] == 1u) {
+                // the other owners are gone in the meantime
+                release_counter(std::exchange(owners[pos], nullptr));
+            } else {
+                const auto page = allocate_page(sparse[pos]);
+                release_page(pos);
+                sparse[pos] = page;
+            }
+        }
+    }
+
     [[nodiscard]] page_type & assure(const std::size_t pos) {
         if(!(pos < sparse.size())) {
             sparse.resize(pos+1);
         }
 
         if(!sparse[pos]) {
-            sparse[pos].reset(new entity_type[entt_per_page]);
-            // null is safe in all cases for our purposes
-            for(auto *first = sparse[pos].get(), *last = first + entt_per_page; first != last; ++first) {
-                *first = null;
-            }
+            sparse[pos] = allocate_page(nullptr);
+        } else {
+            unshare(pos);
         }
 
         return sparse[pos];
     }
 
+    void release_sparse() {
+        for(auto pos = sparse.size(); pos; --pos) {
+            release_page(pos - 1u);
+        }
+
+        sparse.clear();
+        owners.clear();
+        table.clear();
+    }
+
+    [[nodiscard]] static Entity key(const Entity entt) ENTT_NOEXCEPT {
+        return entity_type{to_integral(entt) & traits_type::entity_mask};
+    }
+
+    [[nodiscard]] std::size_t bucket(const Entity entt) const ENTT_NOEXCEPT {
+        // fibonacci hashing, it spreads regular patterns of identifiers
+        const auto hash = static_cast<std::uint64_t>(to_integral(key(entt))) * 11400714819323198485ull;
+        return static_cast<size_type>(hash >> shift);
+    }
+
+    [[nodiscard]] const bucket_type * lookup(const Entity entt) const {
+        if(!table.empty()) {
+            const auto curr = key(entt);
+
+            for(auto pos = bucket(entt); table[pos].first != null; pos = (pos + 1u) & (table.size() - 1u)) {
+                if(table[pos].first == curr) {
+                    return &table[pos];
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    void rehash(const std::size_t cap) {
+        std::vector<bucket_type, bucket_alloc_type> other(cap, bucket_type{null, null}, bucket_alloc_type{allocator});
+        table.swap(other);
+        shift = 64u;
+
+        for(auto curr = cap; curr > 1u; curr >>= 1u) {
+            --shift;
+        }
+
+        for(auto &&elem: other) {
+            if(elem.first != null) {
+                auto pos = bucket(elem.first);
+                for(; table[pos].first != null; pos = (pos + 1u) & (cap - 1u));
+                table[pos] = elem;
+            }
+        }
+    }
+
+    void reserve_buckets(const std::size_t count) {
+        // load factor is kept below one half to have short probe sequences
+        if(!(count * 2u < table.size())) {
+            auto cap = table.empty() ? size_type{8u} : table.size();
+            for(; !(count * 2u < cap); cap *= 2u);
+            rehash(cap);
+        }
+    }
+
+    template<sparse_policy Policy>
+    [[nodiscard]] Entity & element(const Entity entt) {
+        if constexpr(Policy == sparse_policy::paged) {
+            unshare(page(entt));
+            return sparse[page(entt)][offset(entt)];
+        } else {
+            return const_cast<bucket_type *>(lookup(entt))->second;
+        }
+    }
+
+    [[nodiscard]] Entity & element(const Entity entt) {
+        return mode == sparse_policy::paged ? element<sparse_policy::paged>(entt) : element<sparse_policy::hashed>(entt);
+    }
+
+    template<sparse_policy Policy>
+    [[nodiscard]] Entity & assure_element(const Entity entt) {
+        if constexpr(Policy == sparse_policy::paged) {
+            return assure(page(entt))[offset(entt)];
+        } else {
+            // buckets are reserved in advance by the caller
+            auto pos = bucket(entt);
+            for(; table[pos].first != null; pos = (pos + 1u) & (table.size() - 1u));
+            table[pos].first = key(entt);
+            return table[pos].second;
+        }
+    }
+
+    void release_element(const Entity entt) {
+        if(mode == sparse_policy::paged) {
+            unshare(page(entt));
+            sparse[page(entt)][offset(entt)] = entity_type{};
+        } else {
+            const auto mask = table.size() - 1u;
+            auto pos = static_cast<size_type>(lookup(entt) - table.data());
+
+            // backward shift deletion, no tombstones are ever left behind
+            for(auto next = (pos + 1u) & mask; table[next].first != null; next = (next + 1u) & mask) {
+                if(((next - bucket(table[next].first)) & mask) >= ((next - pos) & mask)) {
+                    table[pos] = table[next];
+                    pos = next;
+                }
+            }
+
+            table[pos] = bucket_type{null, null};
+        }
+    }
+
+protected:
+    /**
+     * @brief Moves an element within the packed array, no-op by default.
+     *
+     * Derived classes are notified so that they can keep their own arrays in
+     * sync with the packed array of entities.
+     *
+     * @param from Position of the element to move.
+     * @param to Position in which to move the element.
+     */
+    virtual void move_element([[maybe_unused]] const std::size_t from, [[maybe_unused]] const std::size_t to) {}
+
+    /**
+     * @brief Truncates the packed array, no-op by default.
+     * @param length Number of elements to keep.
+     */
+    virtual void truncate([[maybe_unused]] const std::size_t length) {}
+
+    /**
+     * @brief Rearranges the packed array according to a permutation.
+     *
+     * The permutation is applied in a single pass. Derived classes aren't
+     * notified, they are expected to rearrange their own arrays the same way.
+     *
+     * @param order For each position, the previous position of the element
+     * to move there.
+     */
+    void permute(const std::size_t *order) {
+        const packed_type previous(packed.cbegin(), packed.cend(), allocator);
+
+        for(size_type pos{}, last = packed.size(); pos < last; ++pos) {
+            packed[pos] = previous[order[pos]];
+            element(packed[pos]) = encode(pos);
+        }
+    }
+
 public:
+    /*! @brief Allocator type. */
+    using allocator_type = typename alloc_traits::allocator_type;
     /*! @brief Underlying entity identifier. */
     using entity_type = Entity;
     /*! @brief Unsigned integer type. */
@@ -184,16 +535,182 @@ public:
     using reverse_iterator = const entity_type *;
 
     /*! @brief Default constructor. */
-    sparse_set() = default;
+    sparse_set()
+        : sparse_set{allocator_type{}}
+    {}
+
+    /**
+     * @brief Constructs an empty sparse set with a given allocator.
+     * @param alloc Allocator to use for all memory allocations.
+     */
+    explicit sparse_set(const allocator_type &alloc)
+        : sparse_set{sparse_policy::paged, deletion_policy::swap_and_pop, alloc}
+    {}
+
+    /**
+     * @brief Constructs an empty sparse set with a given layout.
+     * @param policy Layout of the sparse array.
+     * @param deletion Deletion policy of the sparse set.
+     * @param alloc Allocator to use for all memory allocations.
+     */
+    explicit sparse_set(const sparse_policy policy, const deletion_policy deletion = deletion_policy::swap_and_pop, const allocator_type &alloc = allocator_type{})
+        : allocator{alloc},
+          sparse{page_alloc_type{alloc}},
+          owners{owner_alloc_type{alloc}},
+          table{bucket_alloc_type{alloc}},
+          packed{alloc},
+          shift{},
+          mode{policy},
+          removal{deletion}
+    {}
+
+    /**
+     * @brief Copy constructor.
+     * @param other The instance to copy from.
+     */
+    sparse_set(const sparse_set &other)
+        : allocator{alloc_traits::select_on_container_copy_construction(other.allocator)},
+          sparse{other.sparse.size(), page_type{}, page_alloc_type{allocator}},
+          owners{owner_alloc_type{allocator}},
+          table{other.table, bucket_alloc_type{allocator}},
+          packed{other.packed, allocator},
+          shift{other.shift},
+          mode{other.mode},
+          removal{other.removal}
+    {
+        try {
+            for(auto pos = sparse.size(); pos; --pos) {
+                if(other.sparse[pos - 1u]) {
+                    sparse[pos - 1u] = allocate_page(other.sparse[pos - 1u]);
+                }
+            }
+        } catch(...) {
+            release_sparse();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Forks a sparse set.
+     *
+     * Pages of the sparse array are shared between the two sparse sets and
+     * copied only when either of them modifies them for the first time. The
+     * packed array is always copied.
+     *
+     * @warning
+     * Forking updates the bookkeeping of the shared pages of the source.
+     * Therefore, it counts as a modification of the source, while the two
+     * sparse sets can be used on different threads later on.
+     *
+     * @param other The instance to fork.
+     */
+    sparse_set(sparse_set &other, fork_t)
+        : allocator{other.allocator},
+          sparse{other.sparse},
+          owners{owner_alloc_type{allocator}},
+          table{other.table},
+          packed{other.packed},
+          shift{other.shift},
+          mode{other.mode},
+          removal{other.removal}
+    {
+        other.owners.resize(other.sparse.size());
+
+        for(auto pos = other.sparse.size(); pos; --pos) {
+            if(auto *&counter = other.owners[pos - 1u]; other.sparse[pos - 1u] && !counter) {
+                counter_alloc_type alloc{allocator};
+                counter = std::allocator_traits<counter_alloc_type>::allocate(alloc, 1u);
+                std::allocator_traits<counter_alloc_type>::construct(alloc, counter, 1u);
+            }
+        }
+
+        owners = other.owners;
+
+        for(auto *counter: owners) {
+            if(counter) {
+                ++*counter;
+            }
+        }
+    }
 
-    /*! @brief Default move constructor. */
-    sparse_set(sparse_set &&) = default;
+    /**
+     * @brief Move constructor.
+     * @param other The instance to move from.
+     */
+    sparse_set(sparse_set &&other) ENTT_NOEXCEPT
+        : allocator{std::move(other.allocator)},
+          sparse{std::move(other.sparse)},
+          owners{std::move(other.owners)},
+          table{std::move(other.table)},
+          packed{std::move(other.packed)},
+          shift{other.shift},
+          mode{other.mode},
+          removal{other.removal}
+    {}
 
     /*! @brief Default destructor. */
-    virtual ~sparse_set() = default;
+    virtual ~sparse_set() {
+        release_sparse();
+    }
 
-    /*! @brief Default move assignment operator. @return This sparse set. */
-    sparse_set & operator=(sparse_set &&) = default;
+    /**
+     * @brief Move assignment operator.
+     *
+     * @warning
+     * Allocators that don't propagate on move assignment must compare equal.
+     * An assertion will abort the execution at runtime in debug mode otherwise.
+     *
+     * @param other The instance to move from.
+     * @return This sparse set.
+     */
+    sparse_set & operator=(sparse_set &&other) ENTT_NOEXCEPT {
+        ENTT_ASSERT(alloc_traits::propagate_on_container_move_assignment::value || allocator == other.allocator);
+
+        if(this != &other) {
+            release_sparse();
+
+            if constexpr(alloc_traits::propagate_on_container_move_assignment::value) {
+                allocator = std::move(other.allocator);
+            }
+
+            sparse = std::move(other.sparse);
+            owners = std::move(other.owners);
+            table = std::move(other.table);
+            packed = std::move(other.packed);
+            shift = other.shift;
+            mode = other.mode;
+            removal = other.removal;
+            other.sparse.clear();
+            other.owners.clear();
+            other.table.clear();
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Returns the associated allocator.
+     * @return The associated allocator.
+     */
+    [[nodiscard]] allocator_type get_allocator() const ENTT_NOEXCEPT {
+        return allocator;
+    }
+
+    /**
+     * @brief Returns the layout of the sparse array.
+     * @return The layout of the sparse array.
+     */
+    [[nodiscard]] sparse_policy policy() const ENTT_NOEXCEPT {
+        return mode;
+    }
+
+    /**
+     * @brief Returns the deletion policy of a sparse set.
+     * @return The deletion policy of the sparse set.
+     */
+    [[nodiscard]] deletion_policy deletion() const ENTT_NOEXCEPT {
+        return removal;
+    }
 
     /**
      * @brief Increases the capacity of a sparse set.
@@ -220,25 +737,90 @@ public:
     void shrink_to_fit() {
         // conservative approach
         if(packed.empty()) {
-            sparse.clear();
+            release_sparse();
         }
 
         sparse.shrink_to_fit();
         packed.shrink_to_fit();
     }
 
+    /**
+     * @brief Returns the memory footprint of a sparse set.
+     *
+     * Sparse pages shared with other sparse sets are counted as if they were
+     * owned by each of them.
+     *
+     * @return The memory footprint of the sparse set.
+     */
+    [[nodiscard]] virtual pool_footprint footprint() const {
+        pool_footprint info{};
+        std::vector<bool, typename alloc_traits::template rebind_alloc<bool>> used(sparse.size(), false, typename alloc_traits::template rebind_alloc<bool>{allocator});
+
+        info.packed = packed.size() * sizeof(entity_type);
+        info.reserved = packed.capacity() * sizeof(entity_type);
+        info.sparse = sparse.capacity() * sizeof(page_type) + owners.capacity() * sizeof(counter_type *) + table.capacity() * sizeof(bucket_type);
+
+        for(auto &&elem: sparse) {
+            info.pages += (elem != nullptr);
+        }
+
+        for(const auto entt: packed) {
+            if(const auto pos = page(entt); entt != null && pos < used.size() && !used[pos]) {
+                used[pos] = true;
+                ++info.used_pages;
+            }
+        }
+
+        info.sparse += info.pages * entt_per_page * sizeof(entity_type);
+        return info;
+    }
+
+    /**
+     * @brief Records a number of operations of a given type.
+     *
+     * This function does nothing unless `ENTT_USE_POOL_STATS` is defined.
+     * Sparse sets record the operations they are aware of, such as assignments,
+     * removals and page allocations. Pools and registries record the others,
+     * custom pools can do the same.
+     *
+     * @note
+     * Counters are atomic and updated with relaxed ordering. Recording is safe
+     * from multiple threads, as it happens during parallel iterations.
+     *
+     * @param event Type of operation to record.
+     * @param count Number of operations to record.
+     */
+    void record([[maybe_unused]] const pool_event event, [[maybe_unused]] const size_type count = 1u) const ENTT_NOEXCEPT {
+        if constexpr(ENTT_POOL_STATS_ENABLED) {
+            this->add(event, count);
+        }
+    }
+
+    /**
+     * @brief Returns the number of operations recorded by a sparse set.
+     *
+     * Counters aren't copied along with the sparse set, each instance starts
+     * from zero.
+     *
+     * @return The number of operations recorded so far.
+     */
+    [[nodiscard]] pool_stats stats() const ENTT_NOEXCEPT {
+        return pool_stats{this->value(pool_event::emplace), this->value(pool_event::erase), this->value(pool_event::patch), this->value(pool_event::get), this->value(pool_event::page), this->value(pool_event::publish)};
+    }
+
     /**
      * @brief Returns the extent of a sparse set.
      *
      * The extent of a sparse set is also the size of the internal sparse array.
      * There is no guarantee that the internal packed array has the same size.
      * Usually the size of the internal sparse array is equal or greater than
-     * the one of the internal packed array.
+     * the one of the internal packed array.<br/>
+     * For hashed sparse arrays, this is the number of buckets instead.
      *
      * @return Extent of the sparse set.
      */
     [[nodiscard]] size_type extent() const ENTT_NOEXCEPT {
-        return sparse.size() * entt_per_page;
+        return mode == sparse_policy::paged ? (sparse.size() * entt_per_page) : table.size();
     }
 
     /**
@@ -247,7 +829,8 @@ public:
      * The number of elements is also the size of the internal packed array.
      * There is no guarantee that the internal sparse array has the same size.
      * Usually the size of the internal sparse array is equal or greater than
-     * the one of the internal packed array.
+     * the one of the internal packed array.<br/>
+     * Tombstones left behind by in-place deletions are counted as elements.
      *
      * @return Number of elements.
      */
@@ -351,9 +934,33 @@ public:
      * @return True if the sparse set contains the entity, false otherwise.
      */
     [[nodiscard]] bool contains(const entity_type entt) const {
-        const auto curr = page(entt);
-        // testing against null permits to avoid accessing the packed array
-        return (curr < sparse.size() && sparse[curr] && sparse[curr][offset(entt)] != null);
+        return mode == sparse_policy::paged ? contains<sparse_policy::paged>(entt) : contains<sparse_policy::hashed>(entt);
+    }
+
+    /**
+     * @brief Checks if a sparse set contains an entity.
+     *
+     * @warning
+     * Using a layout other than the one of the sparse set results in undefined
+     * behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in case
+     * of mismatch.
+     *
+     * @tparam Policy Layout of the sparse array.
+     * @param entt A valid entity identifier.
+     * @return True if the sparse set contains the entity, false otherwise.
+     */
+    template<sparse_policy Policy>
+    [[nodiscard]] bool contains(const entity_type entt) const {
+        ENTT_ASSERT(mode == Policy);
+
+        if constexpr(Policy == sparse_policy::paged) {
+            const auto curr = page(entt);
+            // testing against null permits to avoid accessing the packed array
+            return (curr < sparse.size() && sparse[curr] && sparse[curr][offset(entt)] != entity_type{});
+        } else {
+            return lookup(entt) != nullptr;
+        }
     }
 
     /**
@@ -369,8 +976,32 @@ public:
      * @return The position of the entity in the sparse set.
      */
     [[nodiscard]] size_type index(const entity_type entt) const {
-        ENTT_ASSERT(contains(entt));
-        return size_type{to_integral(sparse[page(entt)][offset(entt)])};
+        return mode == sparse_policy::paged ? index<sparse_policy::paged>(entt) : index<sparse_policy::hashed>(entt);
+    }
+
+    /**
+     * @brief Returns the position of an entity in a sparse set.
+     *
+     * @warning
+     * Attempting to get the position of an entity that doesn't belong to the
+     * sparse set or using a layout other than the one of the sparse set
+     * results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in both
+     * cases.
+     *
+     * @tparam Policy Layout of the sparse array.
+     * @param entt A valid entity identifier.
+     * @return The position of the entity in the sparse set.
+     */
+    template<sparse_policy Policy>
+    [[nodiscard]] size_type index(const entity_type entt) const {
+        ENTT_ASSERT(contains<Policy>(entt));
+
+        if constexpr(Policy == sparse_policy::paged) {
+            return decode(sparse[page(entt)][offset(entt)]);
+        } else {
+            return decode(lookup(entt)->second);
+        }
     }
 
     /**
@@ -385,9 +1016,37 @@ public:
      * @param entt A valid entity identifier.
      */
     void emplace(const entity_type entt) {
-        ENTT_ASSERT(!contains(entt));
-        assure(page(entt))[offset(entt)] = entity_type{static_cast<typename traits_type::entity_type>(packed.size())};
+        if(mode == sparse_policy::paged) {
+            emplace<sparse_policy::paged>(entt);
+        } else {
+            emplace<sparse_policy::hashed>(entt);
+        }
+    }
+
+    /**
+     * @brief Assigns an entity to a sparse set.
+     *
+     * @warning
+     * Attempting to assign an entity that already belongs to the sparse set
+     * or using a layout other than the one of the sparse set results in
+     * undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in both
+     * cases.
+     *
+     * @tparam Policy Layout of the sparse array.
+     * @param entt A valid entity identifier.
+     */
+    template<sparse_policy Policy>
+    void emplace(const entity_type entt) {
+        ENTT_ASSERT(!contains<Policy>(entt));
+
+        if constexpr(Policy == sparse_policy::hashed) {
+            reserve_buckets(packed.size() + 1u);
+        }
+
+        assure_element<Policy>(entt) = encode(packed.size());
         packed.push_back(entt);
+        record(pool_event::emplace);
     }
 
     /**
@@ -405,18 +1064,55 @@ public:
      */
     template<typename It>
     void insert(It first, It last) {
-        auto next = static_cast<typename traits_type::entity_type>(packed.size());
+        if(mode == sparse_policy::paged) {
+            insert<sparse_policy::paged>(std::move(first), std::move(last));
+        } else {
+            insert<sparse_policy::hashed>(std::move(first), std::move(last));
+        }
+    }
+
+    /**
+     * @brief Assigns one or more entities to a sparse set.
+     *
+     * @warning
+     * Attempting to assign an entity that already belongs to the sparse set
+     * or using a layout other than the one of the sparse set results in
+     * undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode in both
+     * cases.
+     *
+     * @tparam Policy Layout of the sparse array.
+     * @tparam It Type of input iterator.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     */
+    template<sparse_policy Policy, typename It>
+    void insert(It first, It last) {
+        ENTT_ASSERT(mode == Policy);
+        const auto offset = packed.size();
+        auto next = offset;
         packed.insert(packed.end(), first, last);
 
+        if constexpr(Policy == sparse_policy::hashed) {
+            reserve_buckets(packed.size());
+        }
+
         for(; first != last; ++first) {
-            ENTT_ASSERT(!contains(*first));
-            assure(page(*first))[offset(*first)] = entity_type{next++};
+            ENTT_ASSERT(!contains<Policy>(*first));
+            assure_element<Policy>(*first) = encode(next++);
         }
+
+        record(pool_event::emplace, next - offset);
     }
 
     /**
      * @brief Removes an entity from a sparse set.
      *
+     * Sparse sets that delete in-place leave a tombstone behind, unless the
+     * entity is the last element of the packed array.<br/>
+     * Derived classes are notified through `move_element` and `truncate`, the
+     * same as for all the other functions that remove entities.
+     *
      * @warning
      * Attempting to remove an entity that doesn't belong to the sparse set
      * results in undefined behavior.<br/>
@@ -425,14 +1121,122 @@ public:
      *
      * @param entt A valid entity identifier.
      */
-    virtual void erase(const entity_type entt) {
+    void erase(const entity_type entt) {
         ENTT_ASSERT(contains(entt));
-        const auto curr = page(entt);
-        const auto pos = offset(entt);
-        packed[size_type{to_integral(sparse[curr][pos])}] = packed.back();
-        sparse[page(packed.back())][offset(packed.back())] = sparse[curr][pos];
-        sparse[curr][pos] = null;
-        packed.pop_back();
+        auto &ref = element(entt);
+
+        if(removal == deletion_policy::in_place) {
+            const auto pos = decode(ref);
+            release_element(entt);
+
+            // no need for a tombstone if the element is the last one
+            if(pos + 1u == packed.size()) {
+                packed.pop_back();
+                truncate(pos);
+            } else {
+                packed[pos] = null;
+            }
+        } else {
+            const auto pos = decode(ref);
+            const auto last = packed.size() - 1u;
+            auto &other = element(packed.back());
+
+            // derived classes go first in case move assignments throw
+            if(pos != last) {
+                move_element(last, pos);
+            }
+
+            truncate(last);
+            packed[pos] = packed.back();
+            other = ref;
+            release_element(entt);
+            packed.pop_back();
+        }
+
+        record(pool_event::erase);
+    }
+
+    /**
+     * @brief Removes multiple entities from a sparse set.
+     *
+     * Large batches are removed in a single pass over the packed array. The
+     * holes left behind are filled with the elements past the new end of the
+     * array and derived classes are notified of every movement. Small batches
+     * and sparse sets that delete in-place remove one entity at a time instead.
+     * If a derived class throws while moving an element, the entities that
+     * weren't removed yet stay in the sparse set and the two are left in sync.
+     *
+     * @warning
+     * Attempting to remove an entity that doesn't belong to the sparse set
+     * results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * sparse set doesn't contain the given entity.
+     *
+     * @tparam It Type of forward iterator.
+     * @param first An iterator to the first element of the range of entities.
+     * @param last An iterator past the last element of the range of entities.
+     */
+    template<typename It>
+    void erase(It first, It last) {
+        const auto count = static_cast<size_type>(std::distance(first, last));
+
+        // a sequential scan is cheaper than many random swaps in all cases but for small batches
+        if(removal == deletion_policy::in_place || count * 16u < packed.size()) {
+            for(; first != last; ++first) {
+                erase(*first);
+            }
+        } else {
+            // the range can refer to the packed array itself, entities are released only once derived classes are in sync
+            const packed_type batch(first, last, allocator);
+            const auto length = packed.size() - count;
+            auto hole = packed.size();
+
+            // shared pages are copied before anything changes
+            for(const auto entt: batch) {
+                ENTT_ASSERT(contains(entt));
+                hole = (std::min)(hole, decode(element(entt)));
+            }
+
+            for(const auto entt: batch) {
+                packed[index(entt)] = null;
+            }
+
+            auto from = packed.size();
+
+            try {
+                for(; hole < length; ++hole) {
+                    if(packed[hole] == null) {
+                        while(packed[--from] == null);
+                        auto &ref = element(packed[from]);
+                        // derived classes go first in case move assignments throw
+                        move_element(from, hole);
+                        ref = encode(hole);
+                        packed[hole] = std::exchange(packed[from], null);
+                    }
+                }
+            } catch(...) {
+                // entities that weren't overwritten yet are put back, those past the last element moved are removed
+                for(const auto entt: batch) {
+                    if(const auto pos = index(entt); pos <= from && packed[pos] == null) {
+                        packed[pos] = entt;
+                    } else {
+                        release_element(entt);
+                    }
+                }
+
+                packed.erase(packed.begin() + from + 1u, packed.end());
+                truncate(from + 1u);
+                throw;
+            }
+
+            for(const auto entt: batch) {
+                release_element(entt);
+            }
+
+            packed.erase(packed.begin() + length, packed.end());
+            truncate(length);
+            record(pool_event::erase, count);
+        }
     }
 
     /**
@@ -451,9 +1255,9 @@ public:
      * @param rhs A valid entity identifier.
      */
     virtual void swap(const entity_type lhs, const entity_type rhs) {
-        auto &from = sparse[page(lhs)][offset(lhs)];
-        auto &to = sparse[page(rhs)][offset(rhs)];
-        std::swap(packed[size_type{to_integral(from)}], packed[size_type{to_integral(to)}]);
+        auto &from = element(lhs);
+        auto &to = element(rhs);
+        std::swap(packed[decode(from)], packed[decode(to)]);
         std::swap(from, to);
     }
 
@@ -482,6 +1286,9 @@ public:
      * * An iterator past the last element of the range to sort.
      * * A comparison function to use to compare the elements.
      *
+     * @warning
+     * Sparse sets that delete in-place must be compacted before sorting them.
+     *
      * @tparam Compare Type of comparison function object.
      * @tparam Sort Type of sort function object.
      * @tparam Args Types of arguments to forward to the sort function object.
@@ -504,7 +1311,7 @@ public:
         algo(from, to, std::move(compare), std::forward<Args>(args)...);
 
         for(size_type pos = skip, end = skip+length; pos < end; ++pos) {
-            sparse[page(packed[pos])][offset(packed[pos])] = entity_type{static_cast<typename traits_type::entity_type>(pos)};
+            element(packed[pos]) = encode(pos);
         }
     }
 
@@ -524,6 +1331,9 @@ public:
      * bool(const Entity, const Entity);
      * @endcode
      *
+     * @warning
+     * Sparse sets that delete in-place must be compacted before sorting them.
+     *
      * @tparam Apply Type of function object to invoke to notify the caller.
      * @tparam Compare Type of comparison function object.
      * @tparam Sort Type of sort function object.
@@ -553,7 +1363,7 @@ public:
 
             while(curr != next) {
                 apply(packed[curr], packed[next]);
-                sparse[page(packed[curr])][offset(packed[curr])] = entity_type{static_cast<typename traits_type::entity_type>(curr)};
+                element(packed[curr]) = encode(curr);
 
                 curr = next;
                 next = index(packed[curr]);
@@ -574,6 +1384,9 @@ public:
      * the expected order after a call to `respect`. See `begin` and `end` for
      * more details.
      *
+     * @warning
+     * Sparse sets that delete in-place must be compacted before sorting them.
+     *
      * @param other The sparse sets that imposes the order of the entities.
      */
     void respect(const sparse_set &other) {
@@ -595,17 +1408,53 @@ public:
         }
     }
 
+    /**
+     * @brief Reclaims the holes left behind by in-place deletions.
+     *
+     * Elements are moved in a single linear pass and their relative order is
+     * preserved. Therefore, a sorted sparse set is still sorted once compacted.
+     * Derived classes are notified of every movement.<br/>
+     * This function does nothing for sparse sets that delete by swap-and-pop.
+     */
+    void compact() {
+        if(removal == deletion_policy::in_place) {
+            size_type next{};
+
+            for(size_type pos{}, last = packed.size(); pos < last; ++pos) {
+                if(packed[pos] != null) {
+                    if(pos != next) {
+                        packed[next] = packed[pos];
+                        element(packed[next]) = encode(next);
+                        move_element(pos, next);
+                    }
+
+                    ++next;
+                }
+            }
+
+            packed.erase(packed.begin() + next, packed.end());
+            truncate(next);
+        }
+    }
+
     /**
      * @brief Clears a sparse set.
      */
     void clear() ENTT_NOEXCEPT {
-        sparse.clear();
+        record(pool_event::erase, packed.size());
+        release_sparse();
         packed.clear();
     }
 
 private:
-    std::vector<page_type> sparse;
-    std::vector<entity_type> packed;
+    allocator_type allocator;
+    std::vector<page_type, page_alloc_type> sparse;
+    std::vector<counter_type *, owner_alloc_type> owners;
+    std::vector<bucket_type, bucket_alloc_type> table;
+    packed_type packed;
+    size_type shift;
+    sparse_policy mode;
+    deletion_policy removal;
 };
 
 
@@ -3,7 +3,10 @@
 
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <utility>
 #include <vector>
 #include <cstddef>
@@ -11,6 +14,7 @@
 #include "../config/config.h"
 #include "../core/algorithm.hpp"
 #include "../core/type_traits.hpp"
+#include "component.hpp"
 #include "entity.hpp"
 #include "sparse_set.hpp"
 
@@ -36,27 +40,337 @@ namespace entt {
  * no guarantees that objects are returned in the insertion order when iterate
  * a storage. Do not make assumption on the order in any case.
  *
+ * @note
+ * Objects are stored in a single contiguous array by default. When
+ * `component_traits<Type>::page_size` isn't zero, they are stored in fixed-size
+ * pages instead and are never moved in memory when the storage grows.
+ *
+ * @note
+ * When `component_traits<Type>::deletion` is `deletion_policy::in_place`,
+ * erased objects aren't replaced by the last one in the storage. They're kept
+ * in place instead and destroyed at the latest when the storage is compacted,
+ * therefore the order of the storage and the positions of all other objects
+ * are preserved.
+ *
  * @warning
  * Empty types aren't explicitly instantiated. Therefore, many of the functions
  * normally available for non-empty types will not be available for empty ones.
  *
- * @sa sparse_set<Entity>
+ * @sa sparse_set<Entity, Allocator>
+ * @sa component_traits
  *
  * @tparam Entity A valid entity type (see entt_traits for more details).
  * @tparam Type Type of objects assigned to the entities.
+ * @tparam Allocator Type of allocator used to manage memory and elements.
  */
-template<typename Entity, typename Type, typename = std::void_t<>>
-class storage: public sparse_set<Entity> {
+template<typename Entity, typename Type, typename Allocator = ENTT_ALLOCATOR<Type>, typename = std::void_t<>>
+class storage: public sparse_set<Entity, typename std::allocator_traits<Allocator>::template rebind_alloc<Entity>> {
     static_assert(std::is_move_constructible_v<Type> && std::is_move_assignable_v<Type>, "The managed type must be at least move constructible and assignable");
 
-    using underlying_type = sparse_set<Entity>;
+    static constexpr auto page_size = component_traits<Type>::page_size;
+    static_assert((page_size & (page_size - 1)) == 0, "Page size must be a power of two");
+
+    static constexpr auto track_changes = component_traits<Type>::track_changes;
+    static constexpr auto layout = component_traits<Type>::sparse;
+
+    using alloc_traits = typename std::allocator_traits<Allocator>::template rebind_traits<Type>;
+    using underlying_type = sparse_set<Entity, typename alloc_traits::template rebind_alloc<Entity>>;
     using traits_type = entt_traits<Entity>;
 
+    class paged_container final {
+        // pages shared by copies have an owner counter and are copied on first write
+        using counter_type = std::atomic<std::size_t>;
+        using counter_alloc_traits = typename alloc_traits::template rebind_traits<counter_type>;
+
+        void release(const std::size_t keep) {
+            for(auto pos = keep, last = pages.size(); pos < last; ++pos) {
+                alloc_traits::deallocate(allocator, pages[pos], page_size);
+            }
+
+            pages.resize(keep);
+        }
+
+        [[nodiscard]] bool shared(const std::size_t page) const ENTT_NOEXCEPT {
+            return page < owners.size() && owners[page];
+        }
+
+        [[nodiscard]] std::size_t live(const std::size_t page) const ENTT_NOEXCEPT {
+            return page * page_size < count ? (std::min)(page_size, count - page * page_size) : std::size_t{};
+        }
+
+        void release_counter(counter_type *counter) {
+            typename counter_alloc_traits::allocator_type alloc{allocator};
+            counter_alloc_traits::destroy(alloc, counter);
+            counter_alloc_traits::deallocate(alloc, counter, 1u);
+        }
+
+        void drop(const std::size_t page) {
+            if(shared(page)) {
+                auto *counter = std::exchange(owners[page], nullptr);
+
+                if(--*counter != 0u) {
+                    // the page is still in use elsewhere
+                    return;
+                }
+
+                release_counter(counter);
+            }
+
+            for(auto length = live(page); length; --length) {
+                alloc_traits::destroy(allocator, pages[page] + length - 1u);
+            }
+
+            alloc_traits::deallocate(allocator, pages[page], page_size);
+        }
+
+        void unshare(const std::size_t page, const std::size_t length) {
+            if(shared(page)) {
+                if(*owners[page] == 1u) {
+                    release_counter(std::exchange(owners[page], nullptr));
+                } else {
+                    Type *other = alloc_traits::allocate(allocator, page_size);
+
+                    try {
+                        std::uninitialized_copy_n(pages[page], length, other);
+                    } catch(...) {
+                        alloc_traits::deallocate(allocator, other, page_size);
+                        throw;
+                    }
+
+                    drop(page);
+                    pages[page] = other;
+                }
+            }
+        }
+
+        void unshare(const std::size_t page) {
+            unshare(page, live(page));
+        }
+
+        void reset() {
+            for(auto pos = pages.size(); pos; --pos) {
+                drop(pos - 1u);
+            }
+
+            pages.clear();
+            owners.clear();
+            count = {};
+        }
+
+    public:
+        paged_container(const typename alloc_traits::allocator_type &alloc)
+            : allocator{alloc},
+              pages{typename alloc_traits::template rebind_alloc<Type *>{alloc}},
+              owners{typename alloc_traits::template rebind_alloc<counter_type *>{alloc}},
+              count{}
+        {}
+
+        paged_container(const paged_container &other)
+            : allocator{alloc_traits::select_on_container_copy_construction(other.allocator)},
+              pages{typename alloc_traits::template rebind_alloc<Type *>{allocator}},
+              owners{typename alloc_traits::template rebind_alloc<counter_type *>{allocator}},
+              count{}
+        {
+            try {
+                reserve(other.count);
+
+                for(std::size_t pos{}; pos < other.count; ++pos) {
+                    emplace_back(other[pos]);
+                }
+            } catch(...) {
+                reset();
+                throw;
+            }
+        }
+
+        paged_container(paged_container &other, fork_t)
+            : allocator{other.allocator},
+              pages{other.pages.get_allocator()},
+              owners{other.owners.get_allocator()},
+              count{other.count}
+        {
+            const auto used = (count + page_size - 1u) / page_size;
+            other.owners.resize((std::max)(other.owners.size(), used));
+
+            for(auto pos = used; pos; --pos) {
+                if(auto *&counter = other.owners[pos - 1u]; !counter) {
+                    typename counter_alloc_traits::allocator_type alloc{allocator};
+                    counter = counter_alloc_traits::allocate(alloc, 1u);
+                    counter_alloc_traits::construct(alloc, counter, 1u);
+                }
+            }
+
+            pages.assign(other.pages.cbegin(), other.pages.cbegin() + used);
+            owners.assign(other.owners.cbegin(), other.owners.cbegin() + used);
+
+            for(auto *counter: owners) {
+                ++*counter;
+            }
+        }
+
+        paged_container(paged_container &&other) ENTT_NOEXCEPT
+            : allocator{std::move(other.allocator)},
+              pages{std::move(other.pages)},
+              owners{std::move(other.owners)},
+              count{std::exchange(other.count, std::size_t{})}
+        {}
+
+        ~paged_container() {
+            reset();
+        }
+
+        paged_container & operator=(paged_container &&other) ENTT_NOEXCEPT {
+            ENTT_ASSERT(alloc_traits::propagate_on_container_move_assignment::value || allocator == other.allocator);
+
+            if(this != &other) {
+                reset();
+
+                if constexpr(alloc_traits::propagate_on_container_move_assignment::value) {
+                    allocator = std::move(other.allocator);
+                }
+
+                pages = std::move(other.pages);
+                owners = std::move(other.owners);
+                other.pages.clear();
+                other.owners.clear();
+                count = std::exchange(other.count, std::size_t{});
+            }
+
+            return *this;
+        }
+
+        [[nodiscard]] std::size_t size() const ENTT_NOEXCEPT {
+            return count;
+        }
+
+        [[nodiscard]] std::size_t capacity() const ENTT_NOEXCEPT {
+            return pages.size() * page_size;
+        }
+
+        void reserve(const std::size_t cap) {
+            if(cap > capacity()) {
+                pages.reserve((cap + page_size - 1u) / page_size);
+
+                while(capacity() < cap) {
+                    pages.push_back(alloc_traits::allocate(allocator, page_size));
+                }
+            }
+        }
+
+        void shrink_to_fit() {
+            release((count + page_size - 1u) / page_size);
+            pages.shrink_to_fit();
+        }
+
+        [[nodiscard]] const Type * const * data() const ENTT_NOEXCEPT {
+            return pages.data();
+        }
+
+        [[nodiscard]] Type * const * data() {
+            for(auto pos = owners.size(); pos; --pos) {
+                unshare(pos - 1u);
+            }
+
+            return pages.data();
+        }
+
+        [[nodiscard]] const Type & operator[](const std::size_t pos) const {
+            return pages[pos / page_size][pos & (page_size - 1u)];
+        }
+
+        [[nodiscard]] Type & operator[](const std::size_t pos) {
+            unshare(pos / page_size);
+            return pages[pos / page_size][pos & (page_size - 1u)];
+        }
+
+        template<typename... Args>
+        void emplace_back(Args &&... args) {
+            reserve(count + 1u);
+            alloc_traits::construct(allocator, std::addressof((*this)[count]), std::forward<Args>(args)...);
+            ++count;
+        }
+
+        void push_back(Type &&value) {
+            emplace_back(std::move(value));
+        }
+
+        void pop_back() {
+            truncate(count - 1u);
+        }
+
+        template<typename It>
+        void append(It first, It last) {
+            const auto from = count;
+            reserve(count + std::distance(first, last));
+
+            try {
+                for(; first != last; ++first) {
+                    emplace_back(*first);
+                }
+            } catch(...) {
+                while(count != from) {
+                    pop_back();
+                }
+
+                throw;
+            }
+        }
+
+        void append(std::size_t length, const Type &value) {
+            const auto from = count;
+            reserve(count + length);
+
+            try {
+                for(; length; --length) {
+                    emplace_back(value);
+                }
+            } catch(...) {
+                while(count != from) {
+                    pop_back();
+                }
+
+                throw;
+            }
+        }
+
+        void truncate(const std::size_t length) {
+            while(count > length) {
+                const auto page = (count - 1u) / page_size;
+                const auto first = (std::max)(length, page * page_size);
+
+                if(shared(page) && *owners[page] != 1u) {
+                    // only the elements that are kept are copied, the others stay with the other owners
+                    unshare(page, first - page * page_size);
+                    count = first;
+                } else {
+                    unshare(page);
+
+                    for(; count > first; --count) {
+                        alloc_traits::destroy(allocator, pages[page] + ((count - 1u) & (page_size - 1u)));
+                    }
+                }
+            }
+        }
+
+        void clear() {
+            truncate(0u);
+        }
+
+    private:
+        typename alloc_traits::allocator_type allocator;
+        std::vector<Type *, typename alloc_traits::template rebind_alloc<Type *>> pages;
+        std::vector<counter_type *, typename alloc_traits::template rebind_alloc<counter_type *>> owners;
+        std::size_t count;
+    };
+
+    using container_type = std::conditional_t<page_size == 0u, std::vector<Type, typename alloc_traits::allocator_type>, paged_container>;
+    using tick_container_type = std::vector<tick_type, typename alloc_traits::template rebind_alloc<tick_type>>;
+
     template<bool Const>
     class storage_iterator final {
-        friend class storage<Entity, Type>;
+        friend class storage;
 
-        using instance_type = std::conditional_t<Const, const std::vector<Type>, std::vector<Type>>;
+        using instance_type = std::conditional_t<Const, const container_type, container_type>;
         using index_type = typename traits_type::difference_type;
 
         storage_iterator(instance_type &ref, const index_type idx) ENTT_NOEXCEPT
@@ -112,7 +426,7 @@ class storage: public sparse_set<Entity> {
             return other.index - index;
         }
 
-        [[nodiscard]] reference operator[](const difference_type value) const ENTT_NOEXCEPT {
+        [[nodiscard]] reference operator[](const difference_type value) const {
             const auto pos = size_type(index-value-1);
             return (*instances)[pos];
         }
@@ -141,12 +455,12 @@ class storage: public sparse_set<Entity> {
             return !(*this < other);
         }
 
-        [[nodiscard]] pointer operator->() const ENTT_NOEXCEPT {
+        [[nodiscard]] pointer operator->() const {
             const auto pos = size_type(index-1u);
             return &(*instances)[pos];
         }
 
-        [[nodiscard]] reference operator*() const ENTT_NOEXCEPT {
+        [[nodiscard]] reference operator*() const {
             return *operator->();
         }
 
@@ -155,7 +469,40 @@ class storage: public sparse_set<Entity> {
         index_type index;
     };
 
+protected:
+    /**
+     * @copybrief underlying_type::move_element
+     * @param from Position of the element to move.
+     * @param to Position in which to move the element.
+     */
+    void move_element(const std::size_t from, const std::size_t to) override {
+        instances[to] = std::move(instances[from]);
+
+        if constexpr(track_changes) {
+            changes[to] = changes[from];
+        }
+    }
+
+    /**
+     * @copybrief underlying_type::truncate
+     * @param length Number of elements to keep.
+     */
+    void truncate(const std::size_t length) override {
+        if constexpr(page_size == 0u) {
+            instances.erase(instances.begin() + length, instances.end());
+        } else {
+            // shared pages aren't copied only to destroy their tail
+            instances.truncate(length);
+        }
+
+        if constexpr(track_changes) {
+            changes.resize(length);
+        }
+    }
+
 public:
+    /*! @brief Allocator type. */
+    using allocator_type = typename alloc_traits::allocator_type;
     /*! @brief Type of the objects associated with the entities. */
     using object_type = Type;
     /*! @brief Underlying entity identifier. */
@@ -167,10 +514,58 @@ public:
     /*! @brief Constant random access iterator type. */
     using const_iterator = storage_iterator<true>;
     /*! @brief Reverse iterator type. */
-    using reverse_iterator = Type *;
+    using reverse_iterator = std::conditional_t<page_size == 0u, Type *, std::reverse_iterator<iterator>>;
     /*! @brief Constant reverse iterator type. */
-    using const_reverse_iterator = const Type *;
+    using const_reverse_iterator = std::conditional_t<page_size == 0u, const Type *, std::reverse_iterator<const_iterator>>;
+
+    /*! @brief Default constructor. */
+    storage()
+        : storage{allocator_type{}}
+    {}
+
+    /**
+     * @brief Constructs an empty storage with a given allocator.
+     * @param alloc Allocator to use for all memory allocations.
+     */
+    explicit storage(const allocator_type &alloc)
+        : underlying_type{component_traits<Type>::sparse, component_traits<Type>::deletion, typename underlying_type::allocator_type{alloc}},
+          instances{alloc},
+          changes{typename tick_container_type::allocator_type{alloc}}
+    {}
 
+    /**
+     * @brief Forks a storage.
+     *
+     * Pages of paginated objects and pages of the sparse array are shared
+     * between the two storage classes and copied only when either of them
+     * modifies them for the first time. Everything else is copied.
+     *
+     * @warning
+     * Forking updates the bookkeeping of the shared pages of the source.
+     * Therefore, it counts as a modification of the source, while the two
+     * storage classes can be used on different threads later on.
+     *
+     * @param other The instance to fork.
+     */
+    storage(storage &other, fork_t)
+        : underlying_type{other, fork_t{}},
+          instances{[&other]() -> container_type {
+              if constexpr(page_size == 0u) {
+                  return other.instances;
+              } else {
+                  return container_type{other.instances, fork_t{}};
+              }
+          }()},
+          changes{other.changes}
+    {}
+
+    /**
+     * @brief Returns the associated allocator.
+     * @return The associated allocator.
+     */
+    [[nodiscard]] allocator_type get_allocator() const ENTT_NOEXCEPT {
+        return allocator_type{underlying_type::get_allocator()};
+    }
 
     /**
      * @brief Increases the capacity of a storage.
@@ -183,12 +578,20 @@ public:
     void reserve(const size_type cap) {
         underlying_type::reserve(cap);
         instances.reserve(cap);
+
+        if constexpr(track_changes) {
+            changes.reserve(cap);
+        }
     }
 
     /*! @brief Requests the removal of unused capacity. */
     void shrink_to_fit() {
         underlying_type::shrink_to_fit();
         instances.shrink_to_fit();
+
+        if constexpr(track_changes) {
+            changes.shrink_to_fit();
+        }
     }
 
     /**
@@ -201,15 +604,58 @@ public:
      * Objects are in the reverse order as returned by the `begin`/`end`
      * iterators.
      *
+     * @warning
+     * Paginated objects aren't stored contiguously and don't offer this
+     * function, see `pages` instead. A compilation error will occur if invoked.
+     *
      * @return A pointer to the array of objects.
      */
     [[nodiscard]] const object_type * raw() const ENTT_NOEXCEPT {
+        static_assert(page_size == 0u, "Paginated objects aren't contiguous, use pages instead");
         return instances.data();
     }
 
     /*! @copydoc raw */
     [[nodiscard]] object_type * raw() ENTT_NOEXCEPT {
-        return const_cast<object_type *>(std::as_const(*this).raw());
+        static_assert(page_size == 0u, "Paginated objects aren't contiguous, use pages instead");
+        return instances.data();
+    }
+
+    /**
+     * @brief Direct access to the array of pages of paginated objects.
+     *
+     * The object in position `pos` is found at
+     * `pages()[pos / page_size][pos % page_size]`, where `page_size` is the one
+     * defined by the component traits. Pages are allocated on demand, the
+     * returned array contains at least those required by `size()` objects.
+     *
+     * @note
+     * Objects are in the reverse order as returned by the `begin`/`end`
+     * iterators.
+     *
+     * @warning
+     * Only paginated objects offer this function. A compilation error will
+     * occur if invoked for other types.
+     *
+     * @return A pointer to the array of pages.
+     */
+    [[nodiscard]] const object_type * const * pages() const ENTT_NOEXCEPT {
+        static_assert(page_size != 0u, "Objects aren't paginated, use raw instead");
+        return instances.data();
+    }
+
+    /**
+     * @copybrief pages
+     *
+     * Pages shared with forked registries are copied before they're returned,
+     * so that they can be modified freely. This function can therefore be
+     * expensive and throw.
+     *
+     * @return A pointer to the array of pages.
+     */
+    [[nodiscard]] object_type * const * pages() {
+        static_assert(page_size != 0u, "Objects aren't paginated, use raw instead");
+        return instances.data();
     }
 
     /**
@@ -270,7 +716,11 @@ public:
      * @return An iterator to the first instance of the reversed internal array.
      */
     [[nodiscard]] const_reverse_iterator crbegin() const ENTT_NOEXCEPT {
-        return instances.data();
+        if constexpr(page_size == 0u) {
+            return instances.data();
+        } else {
+            return const_reverse_iterator{cend()};
+        }
     }
 
     /*! @copydoc crbegin */
@@ -280,7 +730,11 @@ public:
 
     /*! @copydoc rbegin */
     [[nodiscard]] reverse_iterator rbegin() ENTT_NOEXCEPT {
-        return instances.data();
+        if constexpr(page_size == 0u) {
+            return instances.data();
+        } else {
+            return reverse_iterator{end()};
+        }
     }
 
     /**
@@ -307,6 +761,35 @@ public:
         return rbegin() + instances.size();
     }
 
+    /**
+     * @brief Checks if a storage contains an entity.
+     *
+     * The layout of the sparse array is known at compile-time, no dispatch is
+     * required to find the entity.
+     *
+     * @param entt A valid entity identifier.
+     * @return True if the storage contains the entity, false otherwise.
+     */
+    [[nodiscard]] bool contains(const entity_type entt) const {
+        return underlying_type::template contains<layout>(entt);
+    }
+
+    /**
+     * @brief Returns the position of an entity in a storage.
+     *
+     * @warning
+     * Attempting to get the position of an entity that doesn't belong to the
+     * storage results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * storage doesn't contain the given entity.
+     *
+     * @param entt A valid entity identifier.
+     * @return The position of the entity in the storage.
+     */
+    [[nodiscard]] size_type index(const entity_type entt) const {
+        return underlying_type::template index<layout>(entt);
+    }
+
     /**
      * @brief Returns the object associated with an entity.
      *
@@ -320,12 +803,12 @@ public:
      * @return The object associated with the entity.
      */
     [[nodiscard]] const object_type & get(const entity_type entt) const {
-        return instances[underlying_type::index(entt)];
+        return instances[underlying_type::template index<layout>(entt)];
     }
 
     /*! @copydoc get */
     [[nodiscard]] object_type & get(const entity_type entt) {
-        return const_cast<object_type &>(std::as_const(*this).get(entt));
+        return instances[underlying_type::template index<layout>(entt)];
     }
 
     /**
@@ -334,12 +817,63 @@ public:
      * @return The object associated with the entity, if any.
      */
     [[nodiscard]] const object_type * try_get(const entity_type entt) const {
-        return underlying_type::contains(entt) ? (instances.data() + underlying_type::index(entt)) : nullptr;
+        return underlying_type::template contains<layout>(entt) ? std::addressof(instances[underlying_type::template index<layout>(entt)]) : nullptr;
     }
 
     /*! @copydoc try_get */
     [[nodiscard]] object_type * try_get(const entity_type entt) {
-        return const_cast<object_type *>(std::as_const(*this).try_get(entt));
+        return underlying_type::template contains<layout>(entt) ? std::addressof(instances[underlying_type::template index<layout>(entt)]) : nullptr;
+    }
+
+    /**
+     * @brief Direct access to the array of change ticks.
+     *
+     * The returned pointer is such that range `[ticks(), ticks() + size())` is
+     * always a valid range, even if the container is empty. Ticks have the same
+     * order of the entities and objects.
+     *
+     * @note
+     * Only available when `component_traits<Type>::track_changes` is true.
+     *
+     * @return A pointer to the array of change ticks.
+     */
+    [[nodiscard]] const tick_type * ticks() const ENTT_NOEXCEPT {
+        static_assert(track_changes, "Change ticks aren't enabled for this type");
+        return changes.data();
+    }
+
+    /**
+     * @brief Returns the change tick of the object associated with an entity.
+     *
+     * @warning
+     * Attempting to use an entity that doesn't belong to the storage results in
+     * undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * storage doesn't contain the given entity.
+     *
+     * @param entt A valid entity identifier.
+     * @return The change tick of the object associated with the entity.
+     */
+    [[nodiscard]] tick_type tick(const entity_type entt) const {
+        static_assert(track_changes, "Change ticks aren't enabled for this type");
+        return changes[underlying_type::template index<layout>(entt)];
+    }
+
+    /**
+     * @brief Sets the change tick of the object associated with an entity.
+     *
+     * @warning
+     * Attempting to use an entity that doesn't belong to the storage results in
+     * undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * storage doesn't contain the given entity.
+     *
+     * @param entt A valid entity identifier.
+     * @param value The new change tick of the object.
+     */
+    void stamp(const entity_type entt, const tick_type value) {
+        static_assert(track_changes, "Change ticks aren't enabled for this type");
+        changes[underlying_type::template index<layout>(entt)] = value;
     }
 
     /**
@@ -367,8 +901,12 @@ public:
             instances.emplace_back(std::forward<Args>(args)...);
         }
 
+        if constexpr(track_changes) {
+            changes.push_back(tick_type{});
+        }
+
         // entity goes after component in case constructor throws
-        underlying_type::emplace(entt);
+        underlying_type::template emplace<layout>(entt);
     }
 
     /**
@@ -388,9 +926,18 @@ public:
      */
     template<typename It>
     void insert(It first, It last, const object_type &value = {}) {
-        instances.insert(instances.end(), std::distance(first, last), value);
+        if constexpr(page_size == 0u) {
+            instances.insert(instances.end(), std::distance(first, last), value);
+        } else {
+            instances.append(std::distance(first, last), value);
+        }
+
+        if constexpr(track_changes) {
+            changes.resize(instances.size());
+        }
+
         // entities go after components in case constructors throw
-        underlying_type::insert(first, last);
+        underlying_type::template insert<layout>(first, last);
     }
 
     /**
@@ -408,27 +955,18 @@ public:
      */
     template<typename EIt, typename CIt>
     void insert(EIt first, EIt last, CIt from, CIt to) {
-        instances.insert(instances.end(), from, to);
-        // entities go after components in case constructors throw
-        underlying_type::insert(first, last);
-    }
+        if constexpr(page_size == 0u) {
+            instances.insert(instances.end(), from, to);
+        } else {
+            instances.append(from, to);
+        }
 
-    /**
-     * @brief Removes an entity from a storage and destroys its object.
-     *
-     * @warning
-     * Attempting to use an entity that doesn't belong to the storage results in
-     * undefined behavior.<br/>
-     * An assertion will abort the execution at runtime in debug mode if the
-     * storage doesn't contain the given entity.
-     *
-     * @param entt A valid entity identifier.
-     */
-    void erase(const entity_type entt) override {
-        auto other = std::move(instances.back());
-        instances[underlying_type::index(entt)] = std::move(other);
-        instances.pop_back();
-        underlying_type::erase(entt);
+        if constexpr(track_changes) {
+            changes.resize(instances.size());
+        }
+
+        // entities go after components in case constructors throw
+        underlying_type::template insert<layout>(first, last);
     }
 
     /**
@@ -444,7 +982,12 @@ public:
      * @param rhs A valid entity identifier.
      */
     void swap(const entity_type lhs, const entity_type rhs) override {
-        std::swap(instances[underlying_type::index(lhs)], instances[underlying_type::index(rhs)]);
+        std::swap(instances[underlying_type::template index<layout>(lhs)], instances[underlying_type::template index<layout>(rhs)]);
+
+        if constexpr(track_changes) {
+            std::swap(changes[underlying_type::template index<layout>(lhs)], changes[underlying_type::template index<layout>(rhs)]);
+        }
+
         underlying_type::swap(lhs, rhs);
     }
 
@@ -477,7 +1020,9 @@ public:
      * @warning
      * Empty types are never instantiated. Therefore, only comparison function
      * objects that require to return entities rather than components are
-     * accepted.
+     * accepted.<br/>
+     * Storage classes that delete in-place must be compacted before sorting
+     * them.
      *
      * @tparam Compare Type of comparison function object.
      * @tparam Sort Type of sort function object.
@@ -497,35 +1042,146 @@ public:
         const auto to = from + std::distance(first, last);
 
         const auto apply = [this](const auto lhs, const auto rhs) {
-            std::swap(instances[underlying_type::index(lhs)], instances[underlying_type::index(rhs)]);
+            std::swap(instances[underlying_type::template index<layout>(lhs)], instances[underlying_type::template index<layout>(rhs)]);
+
+            if constexpr(track_changes) {
+                std::swap(changes[underlying_type::template index<layout>(lhs)], changes[underlying_type::template index<layout>(rhs)]);
+            }
         };
 
         if constexpr(std::is_invocable_v<Compare, const object_type &, const object_type &>) {
             underlying_type::arrange(from, to, std::move(apply), [this, compare = std::move(compare)](const auto lhs, const auto rhs) {
-                return compare(std::as_const(instances[underlying_type::index(lhs)]), std::as_const(instances[underlying_type::index(rhs)]));
+                return compare(std::as_const(instances[underlying_type::template index<layout>(lhs)]), std::as_const(instances[underlying_type::template index<layout>(rhs)]));
             }, std::move(algo), std::forward<Args>(args)...);
         } else {
             underlying_type::arrange(from, to, std::move(apply), std::move(compare), std::move(algo), std::forward<Args>(args)...);
         }
     }
 
+    /**
+     * @brief Sort elements according to the integral keys extracted from
+     * their objects.
+     *
+     * Keys are sorted by means of a radix sort, then entities and objects are
+     * moved in their final positions in a single pass. Iterating the storage
+     * with a couple of iterators returns elements in ascending order of keys
+     * afterwards. The sort is stable, elements with equal keys are returned in
+     * the same order as before sorting.
+     *
+     * The signature of the _getter_ should be equivalent to the following,
+     * where `Key` is an unsigned integral type:
+     *
+     * @code{.cpp}
+     * Key(const Type &);
+     * @endcode
+     *
+     * An executor can be provided to sort the keys on multiple threads, in
+     * which case the _getter_ is invoked on the calling thread only.
+     *
+     * @sa radix_sort
+     *
+     * @warning
+     * Storage classes that delete in-place must be compacted before sorting
+     * them.
+     *
+     * @tparam Getter Type of _getter_ function object.
+     * @tparam Executor Type of executor, if any.
+     * @param getter A valid _getter_ function object.
+     * @param executor A valid executor, if any.
+     */
+    template<typename Getter, typename... Executor>
+    void sort_by_key(Getter getter, Executor &&... executor) {
+        static_assert(sizeof...(Executor) < 2u, "Too many executors");
+        using key_type = std::decay_t<std::invoke_result_t<Getter, const object_type &>>;
+        static_assert(std::is_unsigned_v<key_type> && !std::is_same_v<key_type, bool>, "Invalid key type");
+
+        const auto length = underlying_type::size();
+        std::vector<std::pair<key_type, size_type>, typename alloc_traits::template rebind_alloc<std::pair<key_type, size_type>>> keys{get_allocator()};
+        keys.reserve(length);
+
+        // keys are collected in iteration order so that the radix sort keeps equal keys in place
+        for(auto pos = length; pos; --pos) {
+            keys.emplace_back(getter(std::as_const(instances[pos - 1u])), pos - 1u);
+        }
+
+        radix_sort<8u, std::numeric_limits<key_type>::digits>{}(std::forward<Executor>(executor)..., keys.begin(), keys.end(), [](const auto &elem) { return elem.first; });
+
+        // iterators visit the packed arrays backwards, the smallest key goes last
+        std::vector<size_type, typename alloc_traits::template rebind_alloc<size_type>> order(length, size_type{}, get_allocator());
+        std::transform(keys.crbegin(), keys.crend(), order.begin(), [](const auto &elem) { return elem.second; });
+        underlying_type::permute(order.data());
+
+        container_type other{get_allocator()};
+        other.reserve(length);
+
+        for(const auto pos: order) {
+            other.emplace_back(std::move(instances[pos]));
+        }
+
+        instances = std::move(other);
+
+        if constexpr(track_changes) {
+            tick_container_type ordered{changes.get_allocator()};
+            ordered.reserve(length);
+
+            for(const auto pos: order) {
+                ordered.push_back(changes[pos]);
+            }
+
+            changes = std::move(ordered);
+        }
+    }
+
+    /**
+     * @brief Returns the memory footprint of a storage.
+     *
+     * Pages of objects shared with other storage classes are counted as if
+     * they were owned by each of them.
+     *
+     * @return The memory footprint of the storage.
+     */
+    [[nodiscard]] pool_footprint footprint() const override {
+        auto info = underlying_type::footprint();
+        info.instances = instances.size() * sizeof(Type);
+        info.reserved += instances.capacity() * sizeof(Type);
+
+        if constexpr(track_changes) {
+            info.instances += changes.size() * sizeof(tick_type);
+            info.reserved += changes.capacity() * sizeof(tick_type);
+        }
+
+        return info;
+    }
+
     /*! @brief Clears a storage. */
     void clear() {
         underlying_type::clear();
         instances.clear();
+
+        if constexpr(track_changes) {
+            changes.clear();
+        }
     }
 
 private:
-    std::vector<object_type> instances;
+    container_type instances;
+    tick_container_type changes;
 };
 
 
 /*! @copydoc storage */
-template<typename Entity, typename Type>
-class storage<Entity, Type, std::enable_if_t<is_eto_eligible_v<Type>>>: public sparse_set<Entity> {
-    using underlying_type = sparse_set<Entity>;
+template<typename Entity, typename Type, typename Allocator>
+class storage<Entity, Type, Allocator, std::enable_if_t<is_eto_eligible_v<Type>>>: public sparse_set<Entity, typename std::allocator_traits<Allocator>::template rebind_alloc<Entity>> {
+    using alloc_traits = typename std::allocator_traits<Allocator>::template rebind_traits<Type>;
+    using underlying_type = sparse_set<Entity, typename alloc_traits::template rebind_alloc<Entity>>;
+
+    static_assert(!component_traits<Type>::track_changes, "Change ticks aren't supported for empty types");
+
+    static constexpr auto layout = component_traits<Type>::sparse;
 
 public:
+    /*! @brief Allocator type. */
+    using allocator_type = typename alloc_traits::allocator_type;
     /*! @brief Type of the objects associated with the entities. */
     using object_type = Type;
     /*! @brief Underlying entity identifier. */
@@ -533,6 +1189,64 @@ public:
     /*! @brief Unsigned integer type. */
     using size_type = std::size_t;
 
+    /*! @brief Default constructor. */
+    storage()
+        : storage{allocator_type{}}
+    {}
+
+    /**
+     * @brief Constructs an empty storage with a given allocator.
+     * @param alloc Allocator to use for all memory allocations.
+     */
+    explicit storage(const allocator_type &alloc)
+        : underlying_type{component_traits<Type>::sparse, component_traits<Type>::deletion, typename underlying_type::allocator_type{alloc}}
+    {}
+
+    /**
+     * @brief Forks a storage.
+     * @param other The instance to fork.
+     */
+    storage(storage &other, fork_t)
+        : underlying_type{other, fork_t{}}
+    {}
+
+    /**
+     * @brief Returns the associated allocator.
+     * @return The associated allocator.
+     */
+    [[nodiscard]] allocator_type get_allocator() const ENTT_NOEXCEPT {
+        return allocator_type{underlying_type::get_allocator()};
+    }
+
+    /**
+     * @brief Checks if a storage contains an entity.
+     *
+     * The layout of the sparse array is known at compile-time, no dispatch is
+     * required to find the entity.
+     *
+     * @param entt A valid entity identifier.
+     * @return True if the storage contains the entity, false otherwise.
+     */
+    [[nodiscard]] bool contains(const entity_type entt) const {
+        return underlying_type::template contains<layout>(entt);
+    }
+
+    /**
+     * @brief Returns the position of an entity in a storage.
+     *
+     * @warning
+     * Attempting to get the position of an entity that doesn't belong to the
+     * storage results in undefined behavior.<br/>
+     * An assertion will abort the execution at runtime in debug mode if the
+     * storage doesn't contain the given entity.
+     *
+     * @param entt A valid entity identifier.
+     * @return The position of the entity in the storage.
+     */
+    [[nodiscard]] size_type index(const entity_type entt) const {
+        return underlying_type::template index<layout>(entt);
+    }
+
     /**
      * @brief Assigns an entity to a storage and constructs its object.
      *
@@ -549,7 +1263,7 @@ public:
     template<typename... Args>
     void emplace(const entity_type entt, Args &&... args) {
         [[maybe_unused]] object_type instance{std::forward<Args>(args)...};
-        underlying_type::emplace(entt);
+        underlying_type::template emplace<layout>(entt);
     }
 
     /**
@@ -567,7 +1281,7 @@ public:
      */
     template<typename It>
     void insert(It first, It last, const object_type & = {}) {
-        underlying_type::insert(first, last);
+        underlying_type::template insert<layout>(first, last);
     }
 };
 
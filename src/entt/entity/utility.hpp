@@ -2,7 +2,9 @@
 #define ENTT_ENTITY_UTILITY_HPP
 
 
+#include "../config/config.h"
 #include "../core/type_traits.hpp"
+#include "fwd.hpp"
 
 
 namespace entt {
@@ -40,6 +42,41 @@ template<typename... Type>
 inline constexpr get_t<Type...> get{};
 
 
+/*! @brief Tag for groups that are kept up-to-date lazily. */
+struct lazy_t {};
+
+
+/*! @brief Variable for groups that are kept up-to-date lazily. */
+inline constexpr lazy_t lazy{};
+
+
+/*! @brief Tag for copies that share their pages with the source. */
+struct fork_t {};
+
+
+/**
+ * @brief Filter for the components changed after a given tick.
+ * @tparam Type Type of component.
+ */
+template<typename Type>
+struct changed_since_t {
+    /*! @brief Tick after which components are considered changed. */
+    tick_type tick;
+};
+
+
+/**
+ * @brief Constructs a filter for the components changed after a given tick.
+ * @tparam Type Type of component.
+ * @param tick Tick after which components are considered changed.
+ * @return A properly initialized filter.
+ */
+template<typename Type>
+[[nodiscard]] constexpr changed_since_t<Type> changed_since(const tick_type tick) ENTT_NOEXCEPT {
+    return changed_since_t<Type>{tick};
+}
+
+
 }
 
 
@@ -3,6 +3,7 @@
 
 
 #include <iterator>
+#include <memory>
 #include <array>
 #include <tuple>
 #include <utility>
@@ -10,6 +11,7 @@
 #include <type_traits>
 #include "../config/config.h"
 #include "../core/type_traits.hpp"
+#include "component.hpp"
 #include "entity.hpp"
 #include "fwd.hpp"
 #include "pool.hpp"
@@ -74,6 +76,9 @@ class basic_view<Entity, exclude_t<Exclude...>, Component...> {
     template<typename Comp>
     using component_iterator = decltype(std::declval<pool_type<Comp>>().begin());
 
+    template<typename Comp>
+    using reference_type = decltype(*std::declval<pool_type<Comp> &>().begin());
+
     using unchecked_type = std::array<const sparse_set<Entity> *, (sizeof...(Component) - 1)>;
     using filter_type = std::array<const sparse_set<Entity> *, sizeof...(Exclude)>;
 
@@ -94,7 +99,7 @@ class basic_view<Entity, exclude_t<Exclude...>, Component...> {
         }
 
         [[nodiscard]] bool valid() const {
-            return std::all_of(unchecked.cbegin(), unchecked.cend(), [entt = *it](const sparse_set<Entity> *curr) { return curr->contains(entt); })
+            return std::all_of(unchecked.cbegin(), unchecked.cend(), [entt = *it](const sparse_set<Entity> *curr) { return !curr || curr->contains(entt); })
                     && (sizeof...(Exclude) == 0 || std::none_of(filter.cbegin(), filter.cend(), [entt = *it](const sparse_set<Entity> *cpool) { return cpool->contains(entt); }));
         }
 
@@ -175,7 +180,7 @@ class basic_view<Entity, exclude_t<Exclude...>, Component...> {
             using pointer = void;
             using reference = decltype(std::tuple_cat(
                 std::declval<std::tuple<Entity>>(),
-                std::declval<std::conditional_t<is_eto_eligible_v<Component>, std::tuple<>, std::tuple<Component &>>>()...
+                std::declval<std::conditional_t<is_eto_eligible_v<Component>, std::tuple<>, std::tuple<reference_type<Component>>>>()...
             ));
             using iterator_category = std::input_iterator_tag;
 
@@ -255,7 +260,14 @@ class basic_view<Entity, exclude_t<Exclude...>, Component...> {
     [[nodiscard]] unchecked_type unchecked(const sparse_set<Entity> *cpool) const {
         std::size_t pos{};
         unchecked_type other{};
-        ((std::get<pool_type<Component> *>(pools) == cpool ? nullptr : (other[pos] = std::get<pool_type<Component> *>(pools), other[pos++])), ...);
+
+        // pools shared by multiple types are tested only once, unused slots are left empty
+        ([&pos, &other, cpool](const sparse_set<Entity> *curr) {
+            if(curr != cpool && std::find(other.begin(), other.begin() + pos, curr) == other.begin() + pos) {
+                other[pos++] = curr;
+            }
+        }(std::get<pool_type<Component> *>(pools)), ...);
+
         return other;
     }
 
@@ -268,13 +280,22 @@ class basic_view<Entity, exclude_t<Exclude...>, Component...> {
         }
     }
 
+    template<typename Comp, typename Other>
+    [[nodiscard]] bool check(const Entity entt) const {
+        // pools shared by multiple types are tested only once
+        const sparse_set<Entity> *cpool = std::get<pool_type<Other> *>(pools);
+        return std::is_same_v<Comp, Other> || cpool == std::get<pool_type<Comp> *>(pools) || cpool->contains(entt);
+    }
+
     template<typename Comp, typename Func, typename... Type>
-    void traverse(Func func, type_list<Type...>) const {
+    void traverse(Func &func, const std::size_t from, const std::size_t to, type_list<Type...>) const {
+        auto curr = static_cast<const sparse_set<entity_type> &>(*std::get<pool_type<Comp> *>(pools)).begin() + from;
+
         if constexpr(std::disjunction_v<std::is_same<Comp, Type>...>) {
-            auto it = std::get<pool_type<Comp> *>(pools)->begin();
+            auto it = std::get<pool_type<Comp> *>(pools)->begin() + from;
 
-            for(const auto entt: static_cast<const sparse_set<entity_type> &>(*std::get<pool_type<Comp> *>(pools))) {
-                if(((std::is_same_v<Comp, Component> || std::get<pool_type<Component> *>(pools)->contains(entt)) && ...)
+            for(auto pos = from; pos != to; ++pos, ++curr) {
+                if(const auto entt = *curr; (check<Comp, Component>(entt) && ...)
                         && (sizeof...(Exclude) == 0 || std::none_of(filter.cbegin(), filter.cend(), [entt](const sparse_set<Entity> *cpool) { return cpool->contains(entt); })))
                 {
                     if constexpr(std::is_invocable_v<Func, decltype(get<Type>({}))...>) {
@@ -287,8 +308,8 @@ class basic_view<Entity, exclude_t<Exclude...>, Component...> {
                 ++it;
             }
         } else {
-            for(const auto entt: static_cast<const sparse_set<entity_type> &>(*std::get<pool_type<Comp> *>(pools))) {
-                if(((std::is_same_v<Comp, Component> || std::get<pool_type<Component> *>(pools)->contains(entt)) && ...)
+            for(auto pos = from; pos != to; ++pos, ++curr) {
+                if(const auto entt = *curr; (check<Comp, Component>(entt) && ...)
                         && (sizeof...(Exclude) == 0 || std::none_of(filter.cbegin(), filter.cend(), [entt](const sparse_set<Entity> *cpool) { return cpool->contains(entt); })))
                 {
                     if constexpr(std::is_invocable_v<Func, decltype(get<Type>({}))...>) {
@@ -301,6 +322,51 @@ class basic_view<Entity, exclude_t<Exclude...>, Component...> {
         }
     }
 
+    template<typename Comp, typename Func, typename... Type>
+    void traverse_changed(const tick_type tick, Func func, type_list<Type...>) const {
+        const auto *cpool = std::get<pool_type<Comp> *>(pools);
+        const auto *ticks = cpool->ticks();
+        const auto *data = cpool->data();
+
+        for(auto pos = cpool->size(); pos; --pos) {
+            if(const auto entt = data[pos - 1u]; tick < ticks[pos - 1u]
+                    // tombstones are never returned, no matter what their ticks are
+                    && (!component_in_place_delete_v<Comp> || entt != null)
+                    && (check<Comp, Component>(entt) && ...)
+                    && (sizeof...(Exclude) == 0 || std::none_of(filter.cbegin(), filter.cend(), [entt](const sparse_set<Entity> *epool) { return epool->contains(entt); })))
+            {
+                if constexpr(std::is_invocable_v<Func, decltype(get<Type>({}))...>) {
+                    func(std::get<pool_type<Type> *>(pools)->get(entt)...);
+                } else {
+                    func(entt, std::get<pool_type<Type> *>(pools)->get(entt)...);
+                }
+            }
+        }
+    }
+
+    template<typename Comp>
+    [[nodiscard]] auto chunk_data(const Entity entt) const {
+        if constexpr(std::is_reference_v<reference_type<Comp>>) {
+            return std::addressof(std::get<pool_type<Comp> *>(pools)->get(entt));
+        } else {
+            // proxy references give access to the arrays of the data members
+            return std::get<pool_type<Comp> *>(pools)->get(entt);
+        }
+    }
+
+    template<typename Comp>
+    [[nodiscard]] std::size_t contiguous(const Entity entt) const {
+        const auto *cpool = std::get<pool_type<Comp> *>(pools);
+        const auto pos = cpool->index(entt);
+
+        if constexpr(is_eto_eligible_v<Comp> || component_page_size_v<Comp> == 0u) {
+            return cpool->size() - pos;
+        } else {
+            // objects are contiguous only up to the end of the current page
+            return (std::min)(cpool->size() - pos, component_page_size_v<Comp> - (pos & (component_page_size_v<Comp> - 1u)));
+        }
+    }
+
     template<typename Func, typename... Type>
     void iterate(Func func, type_list<Type...>) const {
         const auto last = view->data() + view->size();
@@ -311,16 +377,18 @@ class basic_view<Entity, exclude_t<Exclude...>, Component...> {
                     && (sizeof...(Exclude) == 0 || std::none_of(filter.cbegin(), filter.cend(), [entt = *first](const sparse_set<Entity> *cpool) { return cpool->contains(entt); })))
             {
                 const auto base = *(first++);
-                const auto chunk = (std::min)({ (std::get<pool_type<Component> *>(pools)->size() - std::get<pool_type<Component> *>(pools)->index(base))... });
+                const auto chunk = (std::min)({ contiguous<Component>(base)... });
                 size_type length{};
 
                 for(++length;
                     length < chunk
+                        // tombstones can match each other if pools delete in-place
+                        && (!(component_in_place_delete_v<Component> || ...) || *first != null)
                         && ((*(std::get<pool_type<Component> *>(pools)->data() + std::get<pool_type<Component> *>(pools)->index(base) + length) == *first) && ...)
                         && (sizeof...(Exclude) == 0 || std::none_of(filter.cbegin(), filter.cend(), [entt = *first](const sparse_set<Entity> *cpool) { return cpool->contains(entt); }));
                     ++length, ++first);
 
-                func(view->data() + view->index(base), (std::get<pool_type<Type> *>(pools)->raw() + std::get<pool_type<Type> *>(pools)->index(base))..., length);
+                func(view->data() + view->index(base), chunk_data<Type>(base)..., length);
             } else {
                 ++first;
             }
@@ -397,11 +465,15 @@ public:
      * Components are in the reverse order as returned by the `begin`/`end`
      * iterators.
      *
+     * @warning
+     * Paginated components aren't stored contiguously. A compilation error
+     * will occur if invoked for them, see `storage::pages` instead.
+     *
      * @tparam Comp Type of component in which one is interested.
      * @return A pointer to the array of components.
      */
     template<typename Comp>
-    [[nodiscard]] Comp * raw() const ENTT_NOEXCEPT {
+    [[nodiscard]] auto raw() const ENTT_NOEXCEPT {
         return std::get<pool_type<Comp> *>(pools)->raw();
     }
 
@@ -611,7 +683,101 @@ public:
     template<typename Comp, typename Func>
     void each(Func func) const {
         using non_empty_type = type_list_cat_t<std::conditional_t<is_eto_eligible_v<Component>, type_list<>, type_list<Component>>...>;
-        traverse<Comp>(std::move(func), non_empty_type{});
+        traverse<Comp>(func, 0u, std::get<pool_type<Comp> *>(pools)->size(), non_empty_type{});
+    }
+
+    /**
+     * @brief Iterates entities and components by means of an executor and
+     * applies the given function object to them.
+     *
+     * The entities of the candidate pool are split in chunks of the given size
+     * and each chunk is visited by a separate task. The executor is a function
+     * object that accepts a number of tasks and a task to run for each index
+     * in the range `[0, count)`. It must return only once all the tasks have
+     * completed. Its signature must be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(std::size_t count, Task task);
+     * @endcode
+     *
+     * The signature of the function is the same as for `each`. Within a chunk,
+     * entities are visited in the same order as for `each`. Chunks are the same
+     * no matter how many threads are available for a given chunk size.
+     *
+     * @sa each
+     * @sa thread_pool
+     *
+     * @warning
+     * The function object is invoked concurrently from different tasks.
+     * Creating or destroying entities and assigning or removing components
+     * from within the function object results in undefined behavior.
+     *
+     * @tparam Executor Type of executor.
+     * @tparam Func Type of the function object to invoke.
+     * @param executor A valid executor.
+     * @param func A valid function object.
+     * @param chunk Number of entities per chunk.
+     */
+    template<typename Executor, typename Func>
+    void each(Executor &&executor, Func func, const size_type chunk = ENTT_CHUNK_SIZE) const {
+        view = candidate();
+        ((std::get<pool_type<Component> *>(pools) == view ? each<Component>(executor, std::move(func), chunk) : void()), ...);
+    }
+
+    /**
+     * @brief Iterates entities and components by means of an executor and
+     * applies the given function object to them.
+     *
+     * The pool of the suggested component is used to lead the iterations and
+     * it's split in chunks of the given size.
+     *
+     * @sa each
+     *
+     * @tparam Comp Type of component to use to enforce the iteration order.
+     * @tparam Executor Type of executor.
+     * @tparam Func Type of the function object to invoke.
+     * @param executor A valid executor.
+     * @param func A valid function object.
+     * @param chunk Number of entities per chunk.
+     */
+    template<typename Comp, typename Executor, typename Func>
+    void each(Executor &&executor, Func func, const size_type chunk = ENTT_CHUNK_SIZE) const {
+        ENTT_ASSERT(chunk != 0u);
+        using non_empty_type = type_list_cat_t<std::conditional_t<is_eto_eligible_v<Component>, type_list<>, type_list<Component>>...>;
+        (internal::prepare_concurrent_access<Component>(*std::get<pool_type<Component> *>(pools)), ...);
+        const auto length = std::get<pool_type<Comp> *>(pools)->size();
+
+        executor((length + chunk - 1u) / chunk, [this, &func, length, chunk](const std::size_t task) {
+            traverse<Comp>(func, task * chunk, (std::min)(length, (task + 1u) * chunk), non_empty_type{});
+        });
+    }
+
+    /**
+     * @brief Iterates entities and components and applies the given function
+     * object to those whose filtered component changed after a given tick.
+     *
+     * The pool of the filtered component is used to lead the iterations and
+     * only the elements with a change tick greater than the one of the filter
+     * are visited. The signature of the function is the same as for `each`.
+     *
+     * @sa each
+     * @sa basic_registry::tick
+     *
+     * @warning
+     * The filtered component must track changes (see `component_traits`).
+     *
+     * @tparam Comp Type of component to use to filter and lead the iterations.
+     * @tparam Func Type of the function object to invoke.
+     * @param since A filter for the components changed after a given tick.
+     * @param func A valid function object.
+     */
+    template<typename Comp, typename Func>
+    void each(const changed_since_t<Comp> since, Func func) const {
+        using lead_type = std::conditional_t<(std::is_same_v<Component, const Comp> || ...), const Comp, Comp>;
+        static_assert((std::is_same_v<Component, lead_type> || ...), "Invalid component type");
+        static_assert(component_track_changes_v<Comp>, "Change ticks aren't enabled for this type");
+        using non_empty_type = type_list_cat_t<std::conditional_t<is_eto_eligible_v<Component>, type_list<>, type_list<Component>>...>;
+        traverse_changed<lead_type>(since.tick, std::move(func), non_empty_type{});
     }
 
     /**
@@ -677,7 +843,11 @@ public:
      * * The length of the chunk.
      *
      * Note that the callback can be invoked 0 or more times and no guarantee is
-     * given on the order of the elements.
+     * given on the order of the elements.<br/>
+     * Chunks never cross the boundaries of the pages of paginated components.
+     * Components laid out as structures of arrays (see `soa_storage`) are
+     * returned as proxies rather than pointers, from which the arrays of the
+     * single data members are obtained.
      *
      * @note
      * Empty types aren't explicitly instantiated and therefore they are never
@@ -724,6 +894,10 @@ private:
  * generated them. Therefore any change to the entities and to the components
  * made by means of the registry are immediately reflected by views.
  *
+ * @note
+ * The tombstones left behind by components that delete in-place are skipped
+ * during iterations. For these components, iterators are bidirectional only.
+ *
  * @warning
  * Lifetime of a view must not overcome that of the registry that generated it.
  * In any other case, attempting to use a view results in undefined behavior.
@@ -737,6 +911,72 @@ class basic_view<Entity, exclude_t<>, Component> {
     friend class basic_registry<Entity>;
 
     using pool_type = pool_t<Entity, Component>;
+    using reference_type = decltype(*std::declval<pool_type &>().begin());
+
+    template<typename It>
+    class view_iterator final {
+        friend class basic_view<Entity, exclude_t<>, Component>;
+
+        view_iterator(It from, It to, It curr) ENTT_NOEXCEPT
+            : first{from},
+              last{to},
+              it{curr}
+        {
+            if(it != last && *it == null) {
+                ++(*this);
+            }
+        }
+
+    public:
+        using difference_type = typename std::iterator_traits<It>::difference_type;
+        using value_type = typename std::iterator_traits<It>::value_type;
+        using pointer = typename std::iterator_traits<It>::pointer;
+        using reference = typename std::iterator_traits<It>::reference;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        view_iterator() ENTT_NOEXCEPT = default;
+
+        view_iterator & operator++() ENTT_NOEXCEPT {
+            while(++it != last && *it == null);
+            return *this;
+        }
+
+        view_iterator operator++(int) ENTT_NOEXCEPT {
+            view_iterator orig = *this;
+            return ++(*this), orig;
+        }
+
+        view_iterator & operator--() ENTT_NOEXCEPT {
+            while(--it != first && *it == null);
+            return *this;
+        }
+
+        view_iterator operator--(int) ENTT_NOEXCEPT {
+            view_iterator orig = *this;
+            return operator--(), orig;
+        }
+
+        [[nodiscard]] bool operator==(const view_iterator &other) const ENTT_NOEXCEPT {
+            return other.it == it;
+        }
+
+        [[nodiscard]] bool operator!=(const view_iterator &other) const ENTT_NOEXCEPT {
+            return !(*this == other);
+        }
+
+        [[nodiscard]] pointer operator->() const {
+            return &*it;
+        }
+
+        [[nodiscard]] reference operator*() const {
+            return *operator->();
+        }
+
+    private:
+        It first;
+        It last;
+        It it;
+    };
 
     class view_proxy {
         friend class basic_view<Entity, exclude_t<>, Component>;
@@ -750,19 +990,28 @@ class basic_view<Entity, exclude_t<>, Component> {
                 std::tuple<typename sparse_set<Entity>::iterator, decltype(std::declval<pool_type>().begin())>
             >;
 
-            proxy_iterator(it_type from) ENTT_NOEXCEPT
-                : it{from}
-            {}
+            proxy_iterator(it_type from, typename sparse_set<Entity>::iterator to) ENTT_NOEXCEPT
+                : it{from},
+                  last{to}
+            {
+                if(component_in_place_delete_v<Component> && std::get<0>(it) != last && *std::get<0>(it) == null) {
+                    ++(*this);
+                }
+            }
 
         public:
             using difference_type = std::ptrdiff_t;
             using value_type = std::conditional_t<is_eto_eligible_v<Component>, std::tuple<Entity>, std::tuple<Entity, Component>>;
             using pointer = void;
-            using reference = std::conditional_t<is_eto_eligible_v<Component>, std::tuple<Entity>, std::tuple<Entity, Component &>>;
+            using reference = std::conditional_t<is_eto_eligible_v<Component>, std::tuple<Entity>, std::tuple<Entity, reference_type>>;
             using iterator_category = std::input_iterator_tag;
 
             proxy_iterator & operator++() ENTT_NOEXCEPT {
-                return std::apply([](auto &&... curr) { (++curr, ...); }, it), *this;
+                do {
+                    std::apply([](auto &&... curr) { (++curr, ...); }, it);
+                } while(component_in_place_delete_v<Component> && std::get<0>(it) != last && *std::get<0>(it) == null);
+
+                return *this;
             }
 
             proxy_iterator operator++(int) ENTT_NOEXCEPT {
@@ -784,6 +1033,7 @@ class basic_view<Entity, exclude_t<>, Component> {
 
         private:
             it_type it{};
+            typename sparse_set<Entity>::iterator last{};
         };
 
         view_proxy(pool_type &ref)
@@ -795,17 +1045,17 @@ class basic_view<Entity, exclude_t<>, Component> {
 
         [[nodiscard]] iterator begin() const ENTT_NOEXCEPT {
             if constexpr(is_eto_eligible_v<Component>) {
-                return proxy_iterator{std::make_tuple(pool->sparse_set<entity_type>::begin())};
+                return proxy_iterator{std::make_tuple(pool->sparse_set<entity_type>::begin()), pool->sparse_set<entity_type>::end()};
             } else {
-                return proxy_iterator{std::make_tuple(pool->sparse_set<entity_type>::begin(), pool->begin())};
+                return proxy_iterator{std::make_tuple(pool->sparse_set<entity_type>::begin(), pool->begin()), pool->sparse_set<entity_type>::end()};
             }
         }
 
         [[nodiscard]] iterator end() const ENTT_NOEXCEPT {
             if constexpr(is_eto_eligible_v<Component>) {
-                return proxy_iterator{std::make_tuple(pool->sparse_set<entity_type>::end())};
+                return proxy_iterator{std::make_tuple(pool->sparse_set<entity_type>::end()), pool->sparse_set<entity_type>::end()};
             } else {
-                return proxy_iterator{std::make_tuple(pool->sparse_set<entity_type>::end(), pool->end())};
+                return proxy_iterator{std::make_tuple(pool->sparse_set<entity_type>::end(), pool->end()), pool->sparse_set<entity_type>::end()};
             }
         }
 
@@ -817,6 +1067,44 @@ class basic_view<Entity, exclude_t<>, Component> {
         : pool{&ref}
     {}
 
+    template<typename It>
+    [[nodiscard]] auto wrap([[maybe_unused]] It first, [[maybe_unused]] It last, It curr) const ENTT_NOEXCEPT {
+        if constexpr(component_in_place_delete_v<Component>) {
+            return view_iterator<It>{first, last, curr};
+        } else {
+            return curr;
+        }
+    }
+
+    template<typename Func>
+    void traverse(Func &func, const std::size_t from, const std::size_t to) const {
+        auto curr = static_cast<const sparse_set<entity_type> &>(*pool).begin() + from;
+
+        if constexpr(is_eto_eligible_v<Component>) {
+            for(auto pos = from; pos != to; ++pos, ++curr) {
+                if(!component_in_place_delete_v<Component> || *curr != null) {
+                    if constexpr(std::is_invocable_v<Func>) {
+                        func();
+                    } else {
+                        func(*curr);
+                    }
+                }
+            }
+        } else {
+            auto it = pool->begin() + from;
+
+            for(auto pos = from; pos != to; ++pos, ++curr, ++it) {
+                if(!component_in_place_delete_v<Component> || *curr != null) {
+                    if constexpr(std::is_invocable_v<Func, decltype(get({}))>) {
+                        func(*it);
+                    } else {
+                        func(*curr, *it);
+                    }
+                }
+            }
+        }
+    }
+
 public:
     /*! @brief Type of component iterated by the view. */
     using raw_type = Component;
@@ -824,13 +1112,25 @@ public:
     using entity_type = Entity;
     /*! @brief Unsigned integer type. */
     using size_type = std::size_t;
-    /*! @brief Random access iterator type. */
-    using iterator = typename sparse_set<Entity>::iterator;
+    /*! @brief Random access iterator type, bidirectional if tombstones are possible. */
+    using iterator = std::conditional_t<
+        component_in_place_delete_v<Component>,
+        view_iterator<typename sparse_set<Entity>::iterator>,
+        typename sparse_set<Entity>::iterator
+    >;
     /*! @brief Reversed iterator type. */
-    using reverse_iterator = typename sparse_set<Entity>::reverse_iterator;
+    using reverse_iterator = std::conditional_t<
+        component_in_place_delete_v<Component>,
+        view_iterator<typename sparse_set<Entity>::reverse_iterator>,
+        typename sparse_set<Entity>::reverse_iterator
+    >;
 
     /**
      * @brief Returns the number of entities that have the given component.
+     *
+     * Tombstones left behind by components that delete in-place are counted
+     * as well.
+     *
      * @return Number of entities that have the given component.
      */
     [[nodiscard]] size_type size() const ENTT_NOEXCEPT {
@@ -855,9 +1155,13 @@ public:
      * Components are in the reverse order as returned by the `begin`/`end`
      * iterators.
      *
+     * @warning
+     * Paginated components aren't stored contiguously. A compilation error
+     * will occur if invoked for them, see `storage::pages` instead.
+     *
      * @return A pointer to the array of components.
      */
-    [[nodiscard]] raw_type * raw() const ENTT_NOEXCEPT {
+    [[nodiscard]] auto raw() const ENTT_NOEXCEPT {
         return pool->raw();
     }
 
@@ -890,7 +1194,7 @@ public:
      * @return An iterator to the first entity of the view.
      */
     [[nodiscard]] iterator begin() const ENTT_NOEXCEPT {
-        return pool->sparse_set<Entity>::begin();
+        return wrap(pool->sparse_set<Entity>::begin(), pool->sparse_set<Entity>::end(), pool->sparse_set<Entity>::begin());
     }
 
     /**
@@ -907,7 +1211,7 @@ public:
      * @return An iterator to the entity following the last entity of the view.
      */
     [[nodiscard]] iterator end() const ENTT_NOEXCEPT {
-        return pool->sparse_set<Entity>::end();
+        return wrap(pool->sparse_set<Entity>::begin(), pool->sparse_set<Entity>::end(), pool->sparse_set<Entity>::end());
     }
 
     /**
@@ -923,7 +1227,7 @@ public:
      * @return An iterator to the first entity of the reversed view.
      */
     [[nodiscard]] reverse_iterator rbegin() const ENTT_NOEXCEPT {
-        return pool->sparse_set<Entity>::rbegin();
+        return wrap(pool->sparse_set<Entity>::rbegin(), pool->sparse_set<Entity>::rend(), pool->sparse_set<Entity>::rbegin());
     }
 
     /**
@@ -942,7 +1246,7 @@ public:
      * reversed view.
      */
     [[nodiscard]] reverse_iterator rend() const ENTT_NOEXCEPT {
-        return pool->sparse_set<Entity>::rend();
+        return wrap(pool->sparse_set<Entity>::rbegin(), pool->sparse_set<Entity>::rend(), pool->sparse_set<Entity>::rend());
     }
 
     /**
@@ -973,16 +1277,20 @@ public:
      */
     [[nodiscard]] iterator find(const entity_type entt) const {
         const auto it = pool->find(entt);
-        return it != end() && *it == entt ? it : end();
+        return it != pool->sparse_set<Entity>::end() && *it == entt ? wrap(pool->sparse_set<Entity>::begin(), pool->sparse_set<Entity>::end(), it) : end();
     }
 
     /**
      * @brief Returns the identifier that occupies the given position.
+     *
+     * The null entity is returned in place of the tombstones left behind by
+     * components that delete in-place.
+     *
      * @param pos Position of the element to return.
      * @return The identifier that occupies the given position.
      */
     [[nodiscard]] entity_type operator[](const size_type pos) const {
-        return begin()[pos];
+        return pool->sparse_set<Entity>::begin()[pos];
     }
 
     /**
@@ -1041,7 +1349,11 @@ public:
     template<typename Func>
     void each(Func func) const {
         if constexpr(is_eto_eligible_v<Component>) {
-            if constexpr(std::is_invocable_v<Func>) {
+            if constexpr(std::is_invocable_v<Func> && component_in_place_delete_v<Component>) {
+                for(auto first = begin(), last = end(); first != last; ++first) {
+                    func();
+                }
+            } else if constexpr(std::is_invocable_v<Func>) {
                 for(auto pos = pool->size(); pos; --pos) {
                     func();
                 }
@@ -1050,6 +1362,20 @@ public:
                     func(entt);
                 }
             }
+        } else if constexpr(component_in_place_delete_v<Component>) {
+            auto raw = pool->begin();
+
+            for(const auto entt: static_cast<const sparse_set<entity_type> &>(*pool)) {
+                if(entt != null) {
+                    if constexpr(std::is_invocable_v<Func, decltype(get({}))>) {
+                        func(*raw);
+                    } else {
+                        func(entt, *raw);
+                    }
+                }
+
+                ++raw;
+            }
         } else {
             if constexpr(std::is_invocable_v<Func, decltype(get({}))>) {
                 for(auto &&component: *pool) {
@@ -1065,6 +1391,152 @@ public:
         }
     }
 
+    /**
+     * @brief Iterates entities and components and applies the given function
+     * object to those changed after a given tick.
+     *
+     * Only the elements with a change tick greater than the one of the filter
+     * are visited. The signature of the function is the same as for `each`.
+     *
+     * @sa each
+     * @sa basic_registry::tick
+     *
+     * @warning
+     * The component must track changes (see `component_traits`).
+     *
+     * @tparam Comp Type of component of the view, possibly without qualifiers.
+     * @tparam Func Type of the function object to invoke.
+     * @param since A filter for the components changed after a given tick.
+     * @param func A valid function object.
+     */
+    template<typename Comp, typename Func>
+    void each(const changed_since_t<Comp> since, Func func) const {
+        static_assert(std::is_same_v<std::remove_const_t<Comp>, std::remove_const_t<Component>>, "Invalid component type");
+        static_assert(component_track_changes_v<Comp>, "Change ticks aren't enabled for this type");
+        const auto *ticks = pool->ticks();
+        const auto *data = pool->data();
+
+        for(auto pos = pool->size(); pos; --pos) {
+            // tombstones are never returned, no matter what their ticks are
+            if(const auto entt = data[pos - 1u]; since.tick < ticks[pos - 1u] && (!component_in_place_delete_v<Component> || entt != null)) {
+                if constexpr(std::is_invocable_v<Func, decltype(get({}))>) {
+                    func(pool->get(entt));
+                } else {
+                    func(entt, pool->get(entt));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Iterates entities and components by means of an executor and
+     * applies the given function object to them.
+     *
+     * The entities are split in chunks of the given size and each chunk is
+     * visited by a separate task. The executor is a function object that
+     * accepts a number of tasks and a task to run for each index in the range
+     * `[0, count)`. It must return only once all the tasks have completed. Its
+     * signature must be equivalent to the following:
+     *
+     * @code{.cpp}
+     * void(std::size_t count, Task task);
+     * @endcode
+     *
+     * The signature of the function is the same as for `each`. Within a chunk,
+     * entities are visited in the same order as for `each`. Chunks are the same
+     * no matter how many threads are available for a given chunk size.
+     *
+     * @sa each
+     * @sa thread_pool
+     *
+     * @warning
+     * The function object is invoked concurrently from different tasks.
+     * Creating or destroying entities and assigning or removing components
+     * from within the function object results in undefined behavior.
+     *
+     * @tparam Executor Type of executor.
+     * @tparam Func Type of the function object to invoke.
+     * @param executor A valid executor.
+     * @param func A valid function object.
+     * @param chunk Number of entities per chunk.
+     */
+    template<typename Executor, typename Func>
+    void each(Executor &&executor, Func func, const size_type chunk = ENTT_CHUNK_SIZE) const {
+        ENTT_ASSERT(chunk != 0u);
+        internal::prepare_concurrent_access<Component>(*pool);
+        const auto length = pool->size();
+
+        executor((length + chunk - 1u) / chunk, [this, &func, length, chunk](const std::size_t task) {
+            traverse(func, task * chunk, (std::min)(length, (task + 1u) * chunk));
+        });
+    }
+
+    /**
+     * @brief Chunked iteration for entities and components
+     *
+     * Chunked iteration returns the packed arrays of entities and components
+     * one chunk at a time along with their sizes, so that they can be visited
+     * by tight loops rather than through a function call per entity.<br/>
+     * The signature of the function must be equivalent to one of the following
+     * forms:
+     *
+     * @code{.cpp}
+     * void(const entity_type *, Component *, size_type);
+     * void(const entity_type *, size_type);
+     * @endcode
+     *
+     * The arguments are as follows:
+     *
+     * * A pointer to the entities belonging to the chunk.
+     * * A pointer to the components associated with the returned entities, if
+     *   the component isn't an empty one.
+     * * The length of the chunk.
+     *
+     * Note that the callback can be invoked 0 or more times.<br/>
+     * The whole pool is returned as a single chunk unless its components are
+     * paginated, in which case chunks never cross the boundaries of the pages,
+     * or deleted in-place, in which case chunks never contain tombstones.
+     * Components laid out as structures of arrays (see `soa_storage`) are
+     * returned as proxies rather than pointers.
+     *
+     * @tparam Func Type of the function object to invoke.
+     * @param func A valid function object.
+     */
+    template<typename Func>
+    void chunked(Func func) const {
+        const auto *data = pool->data();
+
+        for(size_type pos{}, last = pool->size(); pos < last;) {
+            size_type length = last - pos;
+
+            if constexpr(component_in_place_delete_v<Component>) {
+                if(data[pos] == null) {
+                    ++pos;
+                    continue;
+                }
+
+                length = static_cast<size_type>(std::find(data + pos, data + last, null) - (data + pos));
+            }
+
+            if constexpr(is_eto_eligible_v<Component>) {
+                func(data + pos, length);
+            } else {
+                if constexpr(component_page_size_v<Component> != 0u) {
+                    // objects are contiguous only up to the end of the current page
+                    length = (std::min)(length, component_page_size_v<Component> - (pos & (component_page_size_v<Component> - 1u)));
+                }
+
+                if constexpr(std::is_reference_v<reference_type>) {
+                    func(data + pos, std::addressof(pool->get(data[pos])), length);
+                } else {
+                    func(data + pos, pool->get(data[pos]), length);
+                }
+            }
+
+            pos += length;
+        }
+    }
+
     /**
      * @brief Returns an iterable object to use to _visit_ the view.
      *
@@ -4,18 +4,25 @@
 #include "core/hashed_string.hpp"
 #include "core/ident.hpp"
 #include "core/monostate.hpp"
+#include "core/thread_pool.hpp"
 #include "core/type_info.hpp"
 #include "core/type_traits.hpp"
 #include "core/utility.hpp"
+#include "entity/cached_view.hpp"
+#include "entity/command_buffer.hpp"
+#include "entity/component.hpp"
 #include "entity/entity.hpp"
 #include "entity/group.hpp"
 #include "entity/handle.hpp"
 #include "entity/helper.hpp"
+#include "entity/multi_storage.hpp"
 #include "entity/observer.hpp"
+#include "entity/organizer.hpp"
 #include "entity/pool.hpp"
 #include "entity/registry.hpp"
 #include "entity/runtime_view.hpp"
 #include "entity/snapshot.hpp"
+#include "entity/soa_storage.hpp"
 #include "entity/sparse_set.hpp"
 #include "entity/storage.hpp"
 #include "entity/utility.hpp"
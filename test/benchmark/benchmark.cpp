@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 #include <entt/core/type_info.hpp>
 #include <entt/entity/registry.hpp>
+#include <entt/entity/sparse_set.hpp>
 
 struct position {
     std::uint64_t x;
@@ -64,6 +65,21 @@ void pathological(Func func) {
     });
 }
 
+template<typename Func>
+void sparse_lookup(const entt::sparse_policy policy, const std::uint32_t step, Func func) {
+    entt::sparse_set<entt::entity> set{policy};
+
+    for(std::uint32_t i = 0; i < 1000000L; i += step) {
+        set.emplace(entt::entity{i});
+    }
+
+    std::cout << set.size() << " out of 1000000 identifiers, extent: " << set.extent() << std::endl;
+
+    timer timer;
+    func(set);
+    timer.elapsed();
+}
+
 TEST(Benchmark, Create) {
     entt::registry registry;
 
@@ -153,6 +169,25 @@ TEST(Benchmark, RemoveMany) {
     timer.elapsed();
 }
 
+TEST(Benchmark, RemoveManyScattered) {
+    entt::registry registry;
+    std::vector<entt::entity> entities(1000000);
+    std::vector<entt::entity> victims;
+
+    std::cout << "Removing 500000 scattered components from their entities at once" << std::endl;
+
+    registry.create(entities.begin(), entities.end());
+    registry.insert<int>(entities.begin(), entities.end());
+
+    for(auto pos = 0u; pos < entities.size(); pos += 2u) {
+        victims.push_back(entities[pos]);
+    }
+
+    timer timer;
+    registry.remove<int>(victims.begin(), victims.end());
+    timer.elapsed();
+}
+
 TEST(Benchmark, RemoveAll) {
     entt::registry registry;
     std::vector<entt::entity> entities(1000000);
@@ -1127,6 +1162,25 @@ TEST(Benchmark, SortSingle) {
     timer.elapsed();
 }
 
+TEST(Benchmark, SortByKey) {
+    entt::registry registry;
+
+    std::cout << "Sort 150000 entities by key, one component" << std::endl;
+
+    for(std::uint64_t i = 0; i < 150000L; i++) {
+        const auto entity = registry.create();
+        registry.emplace<position>(entity, (i * 2654435761u) % 150000u, i);
+    }
+
+    timer timer;
+
+    registry.sort_by_key<position>([](const auto &instance) {
+        return static_cast<std::uint32_t>(instance.x);
+    });
+
+    timer.elapsed();
+}
+
 TEST(Benchmark, SortMulti) {
     entt::registry registry;
 
@@ -1208,3 +1262,80 @@ TEST(Benchmark, AlmostSortedInsertionSort) {
 
     timer.elapsed();
 }
+
+TEST(Benchmark, SparseContainsPaged) {
+    std::cout << "Contains for 1000000 identifiers, paged" << std::endl;
+
+    for(auto step: {1u, 16u, 20000u}) {
+        sparse_lookup(entt::sparse_policy::paged, step, [](const auto &set) {
+            std::size_t count{};
+
+            for(std::uint32_t i = 0; i < 1000000L; i++) {
+                count += set.contains(entt::entity{i});
+            }
+
+            ASSERT_EQ(count, set.size());
+        });
+    }
+}
+
+TEST(Benchmark, SparseContainsHashed) {
+    std::cout << "Contains for 1000000 identifiers, hashed" << std::endl;
+
+    for(auto step: {1u, 16u, 20000u}) {
+        sparse_lookup(entt::sparse_policy::hashed, step, [](const auto &set) {
+            std::size_t count{};
+
+            for(std::uint32_t i = 0; i < 1000000L; i++) {
+                count += set.contains(entt::entity{i});
+            }
+
+            ASSERT_EQ(count, set.size());
+        });
+    }
+}
+
+TEST(Benchmark, SparseIndexPaged) {
+    std::cout << "Index for all the elements, paged" << std::endl;
+
+    for(auto step: {1u, 16u, 20000u}) {
+        sparse_lookup(entt::sparse_policy::paged, step, [](const auto &set) {
+            std::size_t sum{};
+
+            for(auto entity: set) {
+                sum += set.index(entity);
+            }
+
+            ASSERT_EQ(sum, set.size() * (set.size() - 1u) / 2u);
+        });
+    }
+}
+
+TEST(Benchmark, SparseIndexHashed) {
+    std::cout << "Index for all the elements, hashed" << std::endl;
+
+    for(auto step: {1u, 16u, 20000u}) {
+        sparse_lookup(entt::sparse_policy::hashed, step, [](const auto &set) {
+            std::size_t sum{};
+
+            for(auto entity: set) {
+                sum += set.index(entity);
+            }
+
+            ASSERT_EQ(sum, set.size() * (set.size() - 1u) / 2u);
+        });
+    }
+}
+
+TEST(Benchmark, SparseFirstTouch) {
+    std::cout << "Emplacing 1000 entities spread over 1000000 identifiers" << std::endl;
+
+    entt::sparse_set<entt::entity> set;
+    timer timer;
+
+    for(std::uint32_t i = 0; i < 1000000L; i += 1000u) {
+        set.emplace(entt::entity{i});
+    }
+
+    timer.elapsed();
+}
@@ -1,4 +1,7 @@
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 #include <gtest/gtest.h>
 #include <entt/core/algorithm.hpp>
 
@@ -89,6 +92,34 @@ TEST(Algorithm, RadixSortBoxedInt) {
     }
 }
 
+TEST(Algorithm, RadixSortExecutor) {
+    std::vector<std::uint32_t> vec(100000u);
+    std::size_t count{};
+
+    for(std::size_t pos{}; pos < vec.size(); ++pos) {
+        vec[pos] = static_cast<std::uint32_t>((pos * 2654435761u) % 1000003u);
+    }
+
+    auto expected = vec;
+    entt::radix_sort<8, 32>{}(expected.begin(), expected.end());
+
+    // tasks are run backwards to make sure they are independent of each other
+    entt::radix_sort<8, 32>{}([&count](const std::size_t tasks, auto task) {
+        for(auto pos = tasks; pos; --pos) {
+            task(pos - 1u);
+        }
+
+        count = tasks;
+    }, vec.begin(), vec.end());
+
+    ASSERT_GT(count, 1u);
+    ASSERT_EQ(vec, expected);
+
+    for(std::size_t pos{1u}; pos < vec.size(); ++pos) {
+        ASSERT_LE(vec[pos - 1u], vec[pos]);
+    }
+}
+
 TEST(Algorithm, RadixSortEmptyContainer) {
     std::vector<int> vec{};
     entt::radix_sort<8, 32> sort;
@@ -0,0 +1,85 @@
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+#include <entt/core/thread_pool.hpp>
+
+TEST(ThreadPool, Functionalities) {
+    entt::thread_pool pool{3u};
+    std::vector<int> values(1000u);
+
+    ASSERT_EQ(pool.size(), 3u);
+
+    pool(values.size(), [&values](const std::size_t pos) {
+        values[pos] = static_cast<int>(pos);
+    });
+
+    for(std::size_t pos{}; pos < values.size(); ++pos) {
+        ASSERT_EQ(values[pos], static_cast<int>(pos));
+    }
+
+    pool(0u, [](auto) { FAIL(); });
+}
+
+TEST(ThreadPool, NoWorkers) {
+    entt::thread_pool pool{0u};
+    std::size_t count{};
+
+    ASSERT_EQ(pool.size(), 0u);
+
+    pool(10u, [&count](auto) { ++count; });
+
+    ASSERT_EQ(count, 10u);
+}
+
+TEST(ThreadPool, Reuse) {
+    entt::thread_pool pool{};
+    std::atomic<std::size_t> count{};
+
+    for(auto next = 0; next < 100; ++next) {
+        pool(8u, [&count](auto) { ++count; });
+    }
+
+    ASSERT_EQ(count.load(), 800u);
+}
+
+TEST(ThreadPool, Exception) {
+    entt::thread_pool pool{2u};
+    std::atomic<std::size_t> count{};
+
+    ASSERT_THROW(pool(16u, [&count](const std::size_t pos) {
+        ++count;
+
+        if(pos == 7u) {
+            throw std::runtime_error{"error"};
+        }
+    }), std::runtime_error);
+
+    ASSERT_EQ(count.load(), 16u);
+
+    pool(4u, [&count](auto) { ++count; });
+
+    ASSERT_EQ(count.load(), 20u);
+}
+
+TEST(ThreadPool, Run) {
+    entt::thread_pool pool{3u};
+    std::vector<std::size_t> roots{0u, 1u};
+    std::vector<std::atomic<int>> visited(64u);
+
+    // every job spawns its two children in a binary tree, jobs 0 and 1 included
+    pool.run(roots.cbegin(), roots.cend(), [&visited](const std::size_t job, auto spawn) {
+        ++visited[job];
+
+        for(auto next = 2u * job + 2u; next < 2u * job + 4u && next < visited.size(); ++next) {
+            spawn(next);
+        }
+    });
+
+    for(auto &&elem: visited) {
+        ASSERT_EQ(elem.load(), 1);
+    }
+
+    pool.run(roots.cend(), roots.cend(), [](auto...) { FAIL(); });
+}
@@ -0,0 +1,202 @@
+#include <iterator>
+#include <utility>
+#include <gtest/gtest.h>
+#include <entt/entity/cached_view.hpp>
+#include <entt/entity/registry.hpp>
+
+struct empty_type {};
+
+TEST(CachedView, Functionalities) {
+    entt::registry registry;
+    auto view = registry.cached_view<int, char>();
+
+    ASSERT_TRUE(view.empty());
+    ASSERT_EQ(view.size(), 0u);
+    ASSERT_EQ(view.begin(), view.end());
+
+    const auto e0 = registry.create();
+    registry.emplace<char>(e0, 'c');
+
+    const auto e1 = registry.create();
+    registry.emplace<int>(e1, 42);
+    registry.emplace<char>(e1, '2');
+
+    ASSERT_FALSE(view.empty());
+    ASSERT_EQ(view.size(), 1u);
+    ASSERT_FALSE(view.contains(e0));
+    ASSERT_TRUE(view.contains(e1));
+    ASSERT_EQ(*view.begin(), e1);
+
+    ASSERT_EQ(view.get<int>(e1), 42);
+    ASSERT_EQ(view.get<char>(e1), '2');
+    ASSERT_EQ((view.get<int, char>(e1)), std::make_tuple(42, '2'));
+    ASSERT_EQ(view.get(e1), std::make_tuple(42, '2'));
+
+    registry.emplace<int>(e0, 0);
+    registry.remove<char>(e1);
+
+    ASSERT_EQ(view.size(), 1u);
+    ASSERT_TRUE(view.contains(e0));
+    ASSERT_FALSE(view.contains(e1));
+
+    registry.clear<int>();
+
+    ASSERT_TRUE(view.empty());
+}
+
+TEST(CachedView, LateInitialization) {
+    entt::registry registry;
+
+    for(auto i = 0; i < 4; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<int>(entity, i);
+
+        if(i % 2) {
+            registry.emplace<char>(entity);
+        }
+    }
+
+    auto view = registry.cached_view<int, const char>();
+    std::size_t count{};
+
+    ASSERT_EQ(view.size(), 2u);
+
+    view.each([&count, &registry](const auto entity, int &value, const char &) {
+        ASSERT_EQ(value % 2, 1);
+        ASSERT_EQ(registry.get<int>(entity), value);
+        ++count;
+    });
+
+    ASSERT_EQ(count, 2u);
+}
+
+TEST(CachedView, Each) {
+    entt::registry registry;
+    auto view = registry.cached_view<int, empty_type>();
+    std::size_t count{};
+
+    for(auto i = 0; i < 4; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<int>(entity, i);
+        registry.emplace<empty_type>(entity);
+    }
+
+    view.each([&count](const auto, int &) { ++count; });
+    view.each([&count](int &value) { ++value; ++count; });
+
+    ASSERT_EQ(count, 8u);
+
+    for(const auto entity: view) {
+        ASSERT_EQ(registry.get<int>(entity), static_cast<int>(entt::to_integral(entity)) + 1);
+    }
+}
+
+TEST(CachedView, RecycledEntities) {
+    entt::registry registry;
+    auto view = registry.cached_view<int, char>();
+
+    const auto entity = registry.create();
+    registry.emplace<int>(entity);
+    registry.emplace<char>(entity);
+
+    ASSERT_EQ(view.size(), 1u);
+
+    registry.destroy(entity);
+    const auto other = registry.create();
+    registry.emplace<int>(other);
+    registry.emplace<char>(other);
+
+    ASSERT_EQ(registry.entity(entity), registry.entity(other));
+    ASSERT_NE(entity, other);
+    ASSERT_EQ(view.size(), 1u);
+    ASSERT_EQ(*view.begin(), other);
+}
+
+TEST(CachedView, SharedLogs) {
+    entt::registry registry;
+    auto first = registry.cached_view<int, char>();
+    auto second = registry.cached_view<int, double>();
+
+    for(auto i = 0; i < 8; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<int>(entity, i);
+
+        if(i % 2) {
+            registry.emplace<char>(entity);
+        } else {
+            registry.emplace<double>(entity);
+        }
+    }
+
+    ASSERT_EQ(first.size(), 4u);
+
+    registry.remove<int>(registry.view<char>().front());
+    registry.remove<int>(registry.view<double>().front());
+
+    ASSERT_EQ(first.size(), 3u);
+    ASSERT_EQ(second.size(), 3u);
+
+    for(const auto entity: second) {
+        ASSERT_TRUE((registry.has<int, double>(entity)));
+    }
+}
+
+TEST(CachedView, Move) {
+    entt::registry registry;
+    auto view = registry.cached_view<int, char>();
+
+    const auto entity = registry.create();
+    registry.emplace<int>(entity);
+    registry.emplace<char>(entity);
+
+    auto other{std::move(view)};
+
+    ASSERT_EQ(other.size(), 1u);
+
+    view = registry.cached_view<int, char>();
+    registry.remove<char>(entity);
+    other = std::move(view);
+
+    ASSERT_TRUE(other.empty());
+}
+
+TEST(ChangeLog, Functionalities) {
+    entt::registry registry;
+    entt::change_log log;
+    entt::entity entities[3u]{entt::entity{0}, entt::entity{1}, entt::entity{2}};
+    std::size_t count{};
+
+    log.record(registry, std::begin(entities), std::end(entities));
+
+    ASSERT_EQ(log.size(), 0u);
+
+    const auto first = log.attach();
+    log.record(registry, std::begin(entities), std::end(entities));
+    const auto second = log.attach();
+    log.record(registry, entities, entities + 1u);
+
+    ASSERT_EQ(log.size(), 4u);
+
+    log.consume(second, [&count, &entities](const auto entity) {
+        ASSERT_EQ(entity, entities[0u]);
+        ++count;
+    });
+
+    ASSERT_EQ(count, 1u);
+    ASSERT_EQ(log.size(), 4u);
+
+    log.consume(first, [&count](const auto) { ++count; });
+
+    ASSERT_EQ(count, 5u);
+    ASSERT_EQ(log.size(), 0u);
+
+    log.record(registry, std::begin(entities), std::end(entities));
+    log.detach(first);
+
+    ASSERT_EQ(log.size(), 3u);
+
+    log.detach(second);
+
+    ASSERT_EQ(log.size(), 0u);
+    ASSERT_EQ(log.attach(), first);
+}
@@ -0,0 +1,200 @@
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <entt/entity/command_buffer.hpp>
+#include <entt/entity/registry.hpp>
+
+struct empty_type {};
+
+struct position {
+    int x;
+    int y;
+};
+
+struct fragile {
+    fragile(const int v): value{v} {}
+
+    fragile(fragile &&other)
+        : value{other.value}
+    {
+        if(value < 0) {
+            throw std::runtime_error{"fragile"};
+        }
+    }
+
+    fragile & operator=(fragile &&) = default;
+
+    int value;
+};
+
+struct listener {
+    void incr(const entt::registry &, entt::entity) {
+        ++counter;
+    }
+
+    int counter{};
+};
+
+TEST(CommandBuffer, Functionalities) {
+    entt::registry registry;
+    entt::command_buffer buffer;
+
+    const auto entity = registry.create();
+    registry.emplace<int>(entity, 42);
+
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_EQ(buffer.size(), 0u);
+
+    const auto first = buffer.create();
+    const auto second = buffer.create();
+
+    buffer.emplace<position>(first, 1, 2);
+    buffer.emplace<position>(second, 3, 4);
+    buffer.emplace<empty_type>(second);
+    buffer.emplace<std::unique_ptr<int>>(first, new int{3});
+    buffer.emplace<char>(entity, 'c');
+    buffer.remove<int>(entity);
+
+    ASSERT_FALSE(buffer.empty());
+    ASSERT_EQ(buffer.size(), 8u);
+    ASSERT_EQ(registry.alive(), 1u);
+    ASSERT_FALSE(registry.has<char>(entity));
+
+    buffer.apply(registry);
+
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_EQ(registry.alive(), 3u);
+    ASSERT_EQ(registry.size<position>(), 2u);
+    ASSERT_FALSE(registry.has<int>(entity));
+    ASSERT_EQ(registry.get<char>(entity), 'c');
+
+    registry.view<position>().each([&registry](const auto entt, const auto &pos) {
+        ASSERT_EQ(pos.y, pos.x + 1);
+        ASSERT_EQ(registry.has<empty_type>(entt), pos.x == 3);
+        ASSERT_EQ(registry.has<std::unique_ptr<int>>(entt), pos.x == 1);
+    });
+
+    registry.view<std::unique_ptr<int>>().each([](const auto &value) {
+        ASSERT_EQ(*value, 3);
+    });
+}
+
+TEST(CommandBuffer, Destroy) {
+    entt::registry registry;
+    entt::command_buffer buffer;
+
+    const auto entity = registry.create();
+    const auto placeholder = buffer.create();
+
+    buffer.emplace<int>(placeholder, 0);
+    buffer.destroy(placeholder);
+    buffer.destroy(entity);
+    static_cast<void>(buffer.create());
+    buffer.apply(registry);
+
+    ASSERT_FALSE(registry.valid(entity));
+    ASSERT_EQ(registry.alive(), 1u);
+    ASSERT_TRUE(registry.empty<int>());
+
+    buffer.emplace<int>(registry.create(), 0);
+    buffer.clear();
+    buffer.apply(registry);
+
+    ASSERT_TRUE(registry.empty<int>());
+}
+
+TEST(CommandBuffer, Batches) {
+    entt::registry registry;
+    entt::command_buffer buffer;
+    listener listener;
+
+    registry.on_construct<int>().connect<&listener::incr>(listener);
+
+    std::vector<entt::command_buffer::placeholder_type> entities{};
+
+    for(auto next = 0; next < 5; ++next) {
+        entities.push_back(buffer.create());
+    }
+
+    for(auto next = 0; next < 5; ++next) {
+        buffer.emplace<int>(entities[next], next);
+    }
+
+    buffer.apply(registry);
+
+    ASSERT_EQ(listener.counter, 5);
+    ASSERT_EQ(registry.size<int>(), 5u);
+
+    registry.each([&registry](const auto entity) {
+        ASSERT_EQ(registry.get<int>(entity), static_cast<int>(entt::to_integral(entity)));
+    });
+}
+
+TEST(CommandBuffer, MultipleBuffers) {
+    entt::registry registry;
+    std::array<entt::command_buffer, 4u> buffers{};
+    std::vector<std::thread> workers{};
+
+    for(auto pos = 0u; pos < buffers.size(); ++pos) {
+        workers.emplace_back([&buffer = buffers[pos], pos]() {
+            for(auto next = 0u; next < 16u; ++next) {
+                buffer.emplace<unsigned int>(buffer.create(), pos);
+            }
+        });
+    }
+
+    for(auto &&worker: workers) {
+        worker.join();
+    }
+
+    entt::command_buffer::apply(registry, buffers.begin(), buffers.end());
+
+    ASSERT_EQ(registry.size<unsigned int>(), 64u);
+
+    registry.each([&registry](const auto entity) {
+        ASSERT_EQ(registry.get<unsigned int>(entity), entt::to_integral(entity) / 16u);
+    });
+}
+
+TEST(CommandBuffer, PlaceholderLookalike) {
+    using traits_type = entt::entt_traits<entt::entity>;
+
+    entt::registry registry;
+    entt::command_buffer buffer;
+
+    const auto hint = entt::entity{(traits_type::entity_mask - 1u) | (traits_type::version_mask << traits_type::entity_shift)};
+    const auto entity = registry.create(hint);
+
+    ASSERT_EQ(entity, hint);
+
+    static_cast<void>(buffer.create());
+    buffer.emplace<int>(entity, 42);
+    buffer.apply(registry);
+
+    ASSERT_EQ(registry.alive(), 2u);
+    ASSERT_EQ(registry.size<int>(), 1u);
+    ASSERT_EQ(registry.get<int>(entity), 42);
+}
+
+TEST(CommandBuffer, ThrowingCommand) {
+    entt::registry registry;
+    entt::command_buffer buffer;
+
+    buffer.emplace<int>(buffer.create(), 42);
+    buffer.emplace<fragile>(buffer.create(), -1);
+    buffer.emplace<char>(buffer.create(), 'c');
+
+    ASSERT_THROW(buffer.apply(registry), std::runtime_error);
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_EQ(registry.size<int>(), 1u);
+    ASSERT_TRUE(registry.empty<fragile>());
+    ASSERT_TRUE(registry.empty<char>());
+
+    buffer.emplace<char>(buffer.create(), 'c');
+    buffer.apply(registry);
+
+    ASSERT_EQ(registry.size<char>(), 1u);
+}
@@ -1,10 +1,14 @@
+#include <atomic>
+#include <cstdint>
 #include <utility>
 #include <iterator>
 #include <algorithm>
 #include <type_traits>
+#include <vector>
 #include <gtest/gtest.h>
 #include <entt/entity/registry.hpp>
 #include <entt/entity/group.hpp>
+#include <entt/core/thread_pool.hpp>
 
 struct empty_type {};
 struct boxed_int { int value; };
@@ -579,6 +583,77 @@ TEST(NonOwningGroup, SignalRace) {
     ASSERT_EQ(group.size(), 1u);
 }
 
+TEST(NonOwningGroup, Chunked) {
+    entt::registry registry;
+    auto group = registry.group(entt::get<const int, const char>);
+
+    group.chunked([](auto...) { FAIL(); });
+
+    registry.emplace<int>(registry.create());
+
+    for(auto i = 0; i < 6; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<int>(entity, static_cast<int>(entt::to_integral(entity)));
+        registry.emplace<char>(entity);
+    }
+
+    std::size_t count{};
+
+    group.chunked([&count](const entt::entity *entity, const int *value, const char *, std::size_t sz) {
+        for(decltype(sz) i{}; i < sz; ++i) {
+            ASSERT_EQ(static_cast<int>(entt::to_integral(entity[i])), value[i]);
+        }
+
+        count += sz;
+    });
+
+    ASSERT_EQ(count, 6u);
+
+    registry.sort<int>([](const auto lhs, const auto rhs) { return lhs < rhs; });
+    registry.sort<char, int>();
+    group.sort<const int>();
+
+    count = {};
+    group.chunked([&count](const entt::entity *entity, const int *value, const char *, std::size_t sz) {
+        ASSERT_EQ(sz, 6u);
+
+        for(decltype(sz) i{}; i < sz; ++i) {
+            ASSERT_EQ(static_cast<int>(entt::to_integral(entity[i])), value[i]);
+        }
+
+        ++count;
+    });
+
+    ASSERT_EQ(count, 1u);
+}
+
+TEST(NonOwningGroup, EachExecutor) {
+    entt::registry registry;
+    auto group = registry.group(entt::get<int, empty_type>);
+    entt::thread_pool pool{2u};
+    std::atomic<int> count{};
+
+    for(auto next = 0; next < 100; ++next) {
+        const auto entity = registry.create();
+        registry.emplace<int>(entity, next);
+
+        if(next % 2) {
+            registry.emplace<empty_type>(entity);
+        }
+    }
+
+    group.each(pool, [](const auto entity, int &value) {
+        ASSERT_EQ(value, static_cast<int>(entt::to_integral(entity)));
+        value *= 2;
+    }, 8u);
+
+    group.each(pool, [&count](const int value) {
+        count += value;
+    });
+
+    ASSERT_EQ(count.load(), 5000);
+}
+
 TEST(OwningGroup, Functionalities) {
     entt::registry registry;
     auto group = registry.group<int>(entt::get<char>);
@@ -749,6 +824,57 @@ TEST(OwningGroup, EachAndProxy) {
     ASSERT_EQ(cnt, std::size_t{0});
 }
 
+TEST(OwningGroup, EachExecutor) {
+    entt::registry registry;
+    auto group = registry.group<int, char>(entt::get<double>, entt::exclude<float>);
+    std::vector<entt::entity> expected{};
+    std::vector<entt::entity> visited{};
+
+    for(auto next = 0; next < 100; ++next) {
+        const auto entity = registry.create();
+        registry.emplace<int>(entity, next);
+        registry.emplace<char>(entity);
+
+        if(next % 3) {
+            registry.emplace<double>(entity, next);
+        }
+
+        if(next % 5 == 0) {
+            registry.emplace<float>(entity);
+        }
+    }
+
+    group.each([&expected](const entt::entity entity, auto &&...) { expected.push_back(entity); });
+
+    // chunks are run backwards to make sure they are independent of each other
+    group.each([](const std::size_t tasks, auto task) {
+        for(auto pos = tasks; pos; --pos) {
+            task(pos - 1u);
+        }
+    }, [&visited](const auto entity, int &value, char, double other) {
+        ASSERT_EQ(value, static_cast<int>(entt::to_integral(entity)));
+        ASSERT_EQ(value, static_cast<int>(other));
+        visited.push_back(entity);
+    }, 6u);
+
+    ASSERT_EQ(visited.size(), expected.size());
+    ASSERT_TRUE(std::is_permutation(visited.cbegin(), visited.cend(), expected.cbegin()));
+
+    entt::thread_pool pool{3u};
+    std::atomic<std::size_t> count{};
+
+    group.each(pool, [&count](int &value, char &, const double &) {
+        ++count;
+        ++value;
+    }, 5u);
+
+    ASSERT_EQ(count.load(), group.size());
+
+    group.each(pool, [](const auto entity, const int value, char, double) {
+        ASSERT_EQ(value, static_cast<int>(entt::to_integral(entity)) + 1);
+    });
+}
+
 TEST(OwningGroup, SortOrdered) {
     entt::registry registry;
     auto group = registry.group<boxed_int, char>();
@@ -1265,3 +1391,165 @@ TEST(OwningGroup, PreventEarlyOptOut) {
         ASSERT_EQ(i, 2);
     });
 }
+
+TEST(OwningGroup, Chunked) {
+    entt::registry registry;
+    auto group = registry.group<int, char>();
+    std::size_t count{};
+
+    group.chunked([](auto...) { FAIL(); });
+
+    for(auto i = 0; i < 10; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<int>(entity, i);
+        registry.emplace<char>(entity);
+
+        if(i % 5) {
+            registry.emplace<double>(entity);
+        }
+    }
+
+    group.chunked([&count](const entt::entity *entity, int *value, char *, std::size_t sz) {
+        ASSERT_EQ(sz, 10u);
+
+        for(decltype(sz) i{}; i < sz; ++i) {
+            ASSERT_EQ(static_cast<int>(entt::to_integral(entity[i])), value[i]);
+        }
+
+        ++count;
+    });
+
+    ASSERT_EQ(count, 1u);
+}
+
+TEST(OwningGroup, ChunkedWithGetComponents) {
+    entt::registry registry;
+    auto group = registry.group<int>(entt::get<double>);
+    std::size_t count{};
+
+    for(auto i = 0; i < 10; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<int>(entity, i);
+
+        if(i % 5) {
+            registry.emplace<double>(entity, i);
+        }
+    }
+
+    group.chunked([&count](const entt::entity *entity, int *value, double *other, std::size_t sz) {
+        for(decltype(sz) i{}; i < sz; ++i) {
+            ASSERT_EQ(static_cast<int>(entt::to_integral(entity[i])), value[i]);
+            ASSERT_EQ(value[i], static_cast<int>(other[i]));
+        }
+
+        count += sz;
+    });
+
+    ASSERT_EQ(count, 8u);
+}
+
+TEST(OwningGroup, Lazy) {
+    entt::registry registry;
+    entt::entity entities[6u];
+
+    registry.create(std::begin(entities), std::end(entities));
+
+    for(auto i = 0; i < 6; ++i) {
+        registry.emplace<int>(entities[i], i);
+    }
+
+    registry.emplace<char>(entities[1u]);
+    registry.emplace<char>(entities[3u]);
+
+    auto group = registry.group<int>(entt::get<char>, entt::exclude<double>, entt::lazy);
+
+    ASSERT_EQ(group.size(), 2u);
+    ASSERT_TRUE(group.contains(entities[1u]));
+    ASSERT_TRUE(group.contains(entities[3u]));
+
+    registry.emplace<char>(entities[0u]);
+    registry.emplace<char>(entities[5u]);
+    registry.emplace<double>(entities[5u]);
+    registry.remove<double>(entities[5u]);
+    registry.remove<char>(entities[1u]);
+
+    // changes aren't applied to the owned pools until the group is refreshed
+    ASSERT_EQ(registry.data<int>()[0u], entities[1u]);
+    ASSERT_EQ(registry.data<int>()[5u], entities[5u]);
+
+    group.refresh();
+
+    ASSERT_EQ(group.size(), 3u);
+    ASSERT_FALSE(group.contains(entities[1u]));
+    ASSERT_TRUE(group.contains(entities[0u]));
+    ASSERT_TRUE(group.contains(entities[5u]));
+
+    for(auto pos = 0u; pos < group.size(); ++pos) {
+        ASSERT_TRUE(registry.has<char>(registry.data<int>()[pos]));
+    }
+
+    registry.emplace<double>(entities[3u]);
+    registry.remove<int>(entities[0u]);
+    registry.emplace<char>(entities[2u]);
+    registry.destroy(entities[2u]);
+
+    group.refresh();
+    std::size_t count{};
+
+    group.each([&count, &entities](const auto entity, const int &value, const char) {
+        ASSERT_EQ(entity, entities[5u]);
+        ASSERT_EQ(value, 5);
+        ++count;
+    });
+
+    ASSERT_EQ(count, 1u);
+    ASSERT_EQ(registry.group<int>(entt::get<char>, entt::exclude<double>).size(), 1u);
+    ASSERT_EQ(registry.data<int>()[0u], entities[5u]);
+}
+
+TEST(OwningGroup, LazyAndEagerGroupsMatch) {
+    entt::registry lazy;
+    entt::registry eager;
+
+    auto lgroup = lazy.group<int, boxed_int>(entt::get<char>, entt::exclude<double>, entt::lazy);
+    const auto egroup = eager.group<int, boxed_int>(entt::get<char>, entt::exclude<double>);
+
+    for(auto i = 0; i < 64; ++i) {
+        ASSERT_EQ(lazy.create(), eager.create());
+    }
+
+    for(std::uint32_t step{}, seed{42u}; step < 1024u; ++step) {
+        seed = seed * 1664525u + 1013904223u;
+        const auto entity = entt::entity{(seed >> 8u) % 64u};
+        const auto op = (seed >> 20u) % 8u;
+
+        for(auto *curr: { &lazy, &eager }) {
+            switch(op) {
+            case 0u: curr->emplace_or_replace<int>(entity, static_cast<int>(step)); break;
+            case 1u: curr->remove_if_exists<int>(entity); break;
+            case 2u: curr->emplace_or_replace<boxed_int>(entity, static_cast<int>(step)); break;
+            case 3u: curr->remove_if_exists<boxed_int>(entity); break;
+            case 4u: curr->emplace_or_replace<char>(entity); break;
+            case 5u: curr->remove_if_exists<char>(entity); break;
+            case 6u: curr->emplace_or_replace<double>(entity); break;
+            default: curr->remove_if_exists<double>(entity); break;
+            }
+        }
+
+        if(step % 16u == 0u) {
+            lgroup.refresh();
+
+            ASSERT_EQ(lgroup.size(), egroup.size());
+
+            egroup.each([&lgroup](const auto entt, const int &value, const boxed_int &boxed, const char) {
+                ASSERT_TRUE(lgroup.contains(entt));
+                ASSERT_EQ(lgroup.get<int>(entt), value);
+                ASSERT_EQ(lgroup.get<boxed_int>(entt).value, boxed.value);
+            });
+
+            for(auto pos = 0u; pos < lgroup.size(); ++pos) {
+                ASSERT_EQ(lazy.data<int>()[pos], lazy.data<boxed_int>()[pos]);
+            }
+        }
+    }
+}
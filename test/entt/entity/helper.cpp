@@ -1,10 +1,18 @@
 #include <gtest/gtest.h>
 #include <entt/core/hashed_string.hpp>
+#include <entt/entity/component.hpp>
 #include <entt/entity/helper.hpp>
 #include <entt/entity/entity.hpp>
 #include <entt/entity/registry.hpp>
 #include <entt/core/type_traits.hpp>
 
+struct paged_int { int value; };
+
+template<>
+struct entt::component_traits<paged_int>: entt::basic_component_traits {
+    static constexpr std::size_t page_size = 2u;
+};
+
 struct clazz {
     void func(entt::registry &, entt::entity curr) { entt = curr; }
     entt::entity entt{entt::null};
@@ -57,3 +65,22 @@ TEST(Helper, ToEntity) {
     ASSERT_EQ(entt::to_entity(registry, registry.get<int>(other)), other);
     ASSERT_EQ(entt::to_entity(registry, registry.get<char>(other)), other);
 }
+
+TEST(Helper, ToEntityPaged) {
+    entt::registry registry;
+    entt::entity entities[5u];
+
+    registry.create(std::begin(entities), std::end(entities));
+
+    for(auto entity: entities) {
+        registry.emplace<paged_int>(entity);
+    }
+
+    for(auto entity: entities) {
+        ASSERT_EQ(entt::to_entity(registry, registry.get<paged_int>(entity)), entity);
+    }
+
+    const paged_int instance{};
+
+    ASSERT_EQ(entt::to_entity(registry, instance), static_cast<entt::entity>(entt::null));
+}
@@ -0,0 +1,380 @@
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <gtest/gtest.h>
+#include <entt/entity/multi_storage.hpp>
+#include <entt/entity/pool.hpp>
+#include <entt/entity/registry.hpp>
+
+struct position {
+    int x;
+    int y;
+};
+
+struct rotation {
+    int value;
+};
+
+struct scale {
+    int value;
+};
+
+struct fragile {
+    fragile(const int v): value{v} {}
+
+    fragile(const fragile &other): value{other.value} {
+        if(value < 0) {
+            throw std::runtime_error{"fragile"};
+        }
+    }
+
+    fragile(fragile &&other): fragile{std::as_const(other)} {}
+
+    fragile & operator=(const fragile &) = default;
+    fragile & operator=(fragile &&) = default;
+
+    int value;
+};
+
+struct listener {
+    template<typename Component>
+    void incr(const entt::registry &registry, entt::entity entity) {
+        ASSERT_TRUE(registry.has<Component>(entity));
+        ++counter;
+    }
+
+    template<typename Component>
+    void decr(const entt::registry &registry, entt::entity entity) {
+        ASSERT_TRUE(registry.has<Component>(entity));
+        --counter;
+    }
+
+    int counter{};
+};
+
+template<typename Entity>
+struct entt::pool<Entity, position> {
+    using type = entt::multi_pool<Entity, position, position, rotation, scale>;
+};
+
+template<typename Entity>
+struct entt::pool<Entity, rotation> {
+    using type = entt::multi_pool<Entity, rotation, position, rotation, scale>;
+};
+
+template<typename Entity>
+struct entt::pool<Entity, scale> {
+    using type = entt::multi_pool<Entity, scale, position, rotation, scale>;
+};
+
+TEST(MultiStorage, Functionalities) {
+    entt::multi_storage<entt::entity, int, char> pool;
+
+    pool.reserve(42);
+
+    ASSERT_EQ(pool.capacity(), 42u);
+    ASSERT_TRUE(pool.empty());
+
+    pool.emplace(entt::entity{41}, 3, 'c');
+    pool.emplace(entt::entity{3}, 42, 'a');
+
+    ASSERT_EQ(pool.size(), 2u);
+    ASSERT_TRUE(pool.contains(entt::entity{41}));
+    ASSERT_TRUE(pool.contains(entt::entity{3}));
+    ASSERT_EQ(pool.get<int>(entt::entity{41}), 3);
+    ASSERT_EQ(std::as_const(pool).get<char>(entt::entity{3}), 'a');
+    ASSERT_EQ(pool.try_get<int>(entt::entity{0}), nullptr);
+    ASSERT_EQ(*pool.try_get<char>(entt::entity{41}), 'c');
+
+    auto [ivalue, cvalue] = pool.get<int, char>(entt::entity{3});
+    ivalue = 1;
+    cvalue = 'b';
+
+    ASSERT_EQ(pool.raw<int>()[1u], 1);
+    ASSERT_EQ(pool.raw<char>()[1u], 'b');
+
+    pool.swap(entt::entity{41}, entt::entity{3});
+
+    ASSERT_EQ(pool.raw<int>()[0u], 1);
+    ASSERT_EQ(pool.raw<char>()[1u], 'c');
+
+    pool.erase(entt::entity{3});
+
+    ASSERT_EQ(pool.size(), 1u);
+    ASSERT_FALSE(pool.contains(entt::entity{3}));
+    ASSERT_EQ(pool.raw<int>()[0u], 3);
+    ASSERT_EQ(pool.raw<char>()[0u], 'c');
+
+    pool.clear();
+
+    ASSERT_TRUE(pool.empty());
+
+    pool.shrink_to_fit();
+
+    ASSERT_EQ(pool.capacity(), 0u);
+}
+
+TEST(MultiStorage, ThrowingMember) {
+    entt::multi_storage<entt::entity, int, fragile> pool;
+    const entt::entity entities[2u]{entt::entity{3}, entt::entity{4}};
+
+    pool.emplace(entt::entity{1}, 3, fragile{3});
+
+    ASSERT_THROW(pool.emplace(entt::entity{2}, 4, fragile{-1}), std::runtime_error);
+    ASSERT_EQ(pool.size(), 1u);
+    ASSERT_FALSE(pool.contains(entt::entity{2}));
+
+    pool.emplace(entt::entity{2}, 5, fragile{5});
+
+    ASSERT_EQ(pool.get<int>(entt::entity{2}), 5);
+    ASSERT_EQ(pool.get<fragile>(entt::entity{2}).value, 5);
+
+    ASSERT_THROW(pool.insert(std::begin(entities), std::end(entities), 6, fragile{-1}), std::runtime_error);
+    ASSERT_EQ(pool.size(), 2u);
+    ASSERT_FALSE(pool.contains(entt::entity{3}));
+
+    pool.insert(std::begin(entities), std::end(entities), 9, fragile{9});
+
+    ASSERT_EQ(pool.size(), 4u);
+    ASSERT_EQ(pool.get<int>(entt::entity{1}), 3);
+    ASSERT_EQ(pool.get<fragile>(entt::entity{2}).value, 5);
+    ASSERT_EQ(pool.get<int>(entt::entity{4}), 9);
+    ASSERT_EQ(pool.get<fragile>(entt::entity{4}).value, 9);
+}
+
+TEST(MultiStorage, InsertSortErase) {
+    entt::multi_storage<entt::entity, int, char> pool;
+    entt::entity entities[5u]{entt::entity{3}, entt::entity{12}, entt::entity{42}, entt::entity{7}, entt::entity{1}};
+
+    pool.insert(std::begin(entities), std::end(entities), 0, 'x');
+
+    for(auto entt: entities) {
+        pool.get<int>(entt) = 100 - static_cast<int>(entt::to_integral(entt));
+    }
+
+    pool.sort(pool.begin(), pool.end(), [&pool](const auto lhs, const auto rhs) {
+        return pool.get<int>(lhs) < pool.get<int>(rhs);
+    });
+
+    ASSERT_TRUE(std::is_sorted(std::make_reverse_iterator(pool.raw<int>() + pool.size()), std::make_reverse_iterator(pool.raw<int>())));
+
+    for(auto entt: entities) {
+        ASSERT_EQ(pool.get<int>(entt), 100 - static_cast<int>(entt::to_integral(entt)));
+        ASSERT_EQ(pool.get<char>(entt), 'x');
+    }
+
+    pool.erase(std::begin(entities), std::begin(entities) + 4u);
+
+    ASSERT_EQ(pool.size(), 1u);
+    ASSERT_EQ(pool.get<int>(entt::entity{1}), 99);
+}
+
+TEST(MultiStorage, Registry) {
+    entt::registry registry;
+    listener on_construct;
+    listener on_destroy;
+
+    static_assert(std::is_base_of_v<entt::multi_storage<entt::entity, position, rotation, scale>, entt::pool_t<entt::entity, rotation>>);
+
+    registry.on_construct<scale>().connect<&listener::incr<scale>>(on_construct);
+    registry.on_destroy<rotation>().connect<&listener::decr<rotation>>(on_destroy);
+
+    const auto e0 = registry.create();
+    const auto e1 = registry.create();
+
+    registry.emplace<position>(e0, 1, 2);
+    registry.emplace<rotation>(e1, 3);
+
+    ASSERT_EQ(on_construct.counter, 2);
+    ASSERT_TRUE((registry.has<position, rotation, scale>(e0)));
+    ASSERT_TRUE((registry.has<position, rotation, scale>(e1)));
+    ASSERT_EQ(registry.size<position>(), 2u);
+    ASSERT_EQ(registry.size<scale>(), 2u);
+    ASSERT_EQ(registry.data<position>(), registry.data<rotation>());
+    ASSERT_EQ(registry.data<position>(), registry.data<scale>());
+
+    ASSERT_EQ(registry.get<position>(e0).y, 2);
+    ASSERT_EQ(registry.get<rotation>(e0).value, 0);
+    ASSERT_EQ(registry.get<position>(e1).x, 0);
+    ASSERT_EQ(registry.get<rotation>(e1).value, 3);
+    ASSERT_EQ(registry.try_get<scale>(registry.create()), nullptr);
+
+    registry.replace<scale>(e0, 4);
+    registry.patch<rotation>(e0, [](auto &rot) { rot.value = 5; });
+
+    auto [pos, rot, scl] = registry.get<position, rotation, scale>(e0);
+
+    ASSERT_EQ(pos.x, 1);
+    ASSERT_EQ(rot.value, 5);
+    ASSERT_EQ(scl.value, 4);
+    ASSERT_EQ(registry.raw<scale>()[0u].value, 4);
+
+    registry.remove<rotation>(e0);
+
+    ASSERT_EQ(on_destroy.counter, -1);
+    ASSERT_FALSE((registry.has<position>(e0)));
+    ASSERT_FALSE((registry.any<rotation, scale>(e0)));
+    ASSERT_TRUE((registry.has<position, rotation, scale>(e1)));
+
+    registry.destroy(e1);
+
+    ASSERT_EQ(on_destroy.counter, -2);
+    ASSERT_TRUE(registry.empty<scale>());
+}
+
+TEST(MultiStorage, Insert) {
+    entt::registry registry;
+    entt::entity entities[3u];
+    const position values[3u]{{0, 1}, {2, 3}, {4, 5}};
+
+    registry.create(std::begin(entities), std::end(entities));
+    registry.insert<rotation>(std::begin(entities), std::begin(entities) + 1u, rotation{42});
+    registry.insert<position>(std::begin(entities) + 1u, std::end(entities), std::begin(values), std::begin(values) + 2u);
+
+    ASSERT_EQ(registry.size<scale>(), 3u);
+    ASSERT_EQ(registry.get<rotation>(entities[0u]).value, 42);
+    ASSERT_EQ(registry.get<position>(entities[0u]).x, 0);
+    ASSERT_EQ(registry.get<position>(entities[2u]).y, 3);
+    ASSERT_EQ(registry.get<rotation>(entities[2u]).value, 0);
+
+    registry.clear<scale>();
+
+    ASSERT_TRUE(registry.empty<position>());
+    ASSERT_TRUE(registry.orphan(entities[0u]));
+}
+
+TEST(MultiStorage, ViewsAndGroups) {
+    entt::registry registry;
+
+    for(auto next = 0; next < 5; ++next) {
+        const auto entity = registry.create();
+        registry.emplace<position>(entity, next, next);
+        registry.get<rotation>(entity).value = next;
+
+        if(next % 2) {
+            registry.emplace<int>(entity, next);
+        }
+    }
+
+    std::size_t count{};
+
+    for(auto entity: registry.view<position, rotation>()) {
+        ASSERT_EQ(registry.get<position>(entity).x, registry.get<rotation>(entity).value);
+        ++count;
+    }
+
+    ASSERT_EQ(count, 5u);
+
+    registry.view<const position, rotation>().each([](const auto &pos, auto &rot) {
+        rot.value = pos.x * 2;
+    });
+
+    registry.view<position, scale, int>().each([&count](const auto entity, auto &pos, auto &scl, const int value) {
+        ASSERT_EQ(pos.x, value);
+        ASSERT_EQ(entt::to_integral(entity), static_cast<std::underlying_type_t<entt::entity>>(value));
+        scl.value = value;
+        --count;
+    });
+
+    ASSERT_EQ(count, 3u);
+
+    auto group = registry.group<>(entt::get<int, position, rotation>);
+
+    ASSERT_EQ(group.size(), 2u);
+
+    group.each([](const int value, auto &pos, auto &rot) {
+        ASSERT_EQ(pos.x, value);
+        ASSERT_EQ(rot.value, value * 2);
+    });
+
+    auto owning = registry.group<position, int>(entt::get<scale>);
+
+    ASSERT_EQ(owning.size(), 2u);
+
+    owning.each([](auto &pos, const int value, const auto &scl) {
+        ASSERT_EQ(pos.x, value);
+        ASSERT_EQ(scl.value, value);
+    });
+
+    const auto entity = registry.create();
+    registry.emplace<int>(entity, 42);
+    registry.emplace<scale>(entity, 42);
+
+    ASSERT_EQ(group.size(), 3u);
+    ASSERT_EQ(owning.size(), 3u);
+    ASSERT_EQ(registry.get<scale>(owning.data()[0u]).value, registry.get<int>(owning.data()[0u]));
+
+    registry.remove<position>(entity);
+
+    ASSERT_EQ(group.size(), 2u);
+    ASSERT_EQ(owning.size(), 2u);
+}
+
+TEST(MultiStorage, Sort) {
+    entt::registry registry;
+
+    for(auto next = 0; next < 5; ++next) {
+        registry.emplace<scale>(registry.create(), 10 - next);
+    }
+
+    registry.sort<scale>([](const auto &lhs, const auto &rhs) { return lhs.value < rhs.value; });
+
+    auto view = registry.view<scale>();
+    auto prev = view.begin();
+
+    for(auto it = ++view.begin(); it != view.end(); ++it, ++prev) {
+        ASSERT_LT(view.get(*prev).value, view.get(*it).value);
+    }
+
+    registry.view<position, scale>().each([](const auto entity, auto &pos, auto &scl) {
+        ASSERT_EQ(pos.x, 0);
+        ASSERT_EQ(scl.value, 10 - static_cast<int>(entt::to_integral(entity)));
+    });
+}
+
+TEST(MultiStorage, Fork) {
+    entt::registry registry;
+    const auto entity = registry.create();
+
+    registry.emplace<position>(entity, 1, 2);
+    registry.emplace<int>(entity, 3);
+
+    auto fork = registry.fork();
+
+    ASSERT_EQ(fork.data<position>(), fork.data<scale>());
+    ASSERT_NE(fork.data<position>(), registry.data<position>());
+    ASSERT_TRUE((fork.has<position, rotation, scale, int>(entity)));
+    ASSERT_EQ(fork.get<position>(entity).y, 2);
+
+    fork.remove<scale>(entity);
+
+    ASSERT_FALSE((fork.any<position, rotation, scale>(entity)));
+    ASSERT_TRUE((registry.has<position, rotation, scale>(entity)));
+    ASSERT_EQ(registry.get<position>(entity).x, 1);
+}
+
+TEST(MultiStorage, Spawn) {
+    entt::registry registry;
+    listener on_construct;
+
+    registry.on_construct<scale>().connect<&listener::incr<scale>>(on_construct);
+
+    registry.spawn<position, int, rotation>(4u, [](const entt::entity entity, position &pos, int &value, rotation &rot) {
+        pos.x = static_cast<int>(entt::to_integral(entity));
+        value = pos.x + 1;
+        rot.value = pos.x + 2;
+    });
+
+    ASSERT_EQ(registry.size<position>(), 4u);
+    ASSERT_EQ(registry.size<scale>(), 4u);
+    ASSERT_EQ(registry.size<int>(), 4u);
+    ASSERT_EQ(on_construct.counter, 4);
+
+    registry.view<position, rotation, int>().each([](const auto &pos, const auto &rot, const int value) {
+        ASSERT_EQ(value, pos.x + 1);
+        ASSERT_EQ(rot.value, pos.x + 2);
+    });
+}
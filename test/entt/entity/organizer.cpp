@@ -0,0 +1,146 @@
+#include <atomic>
+#include <vector>
+#include <gtest/gtest.h>
+#include <entt/core/thread_pool.hpp>
+#include <entt/entity/organizer.hpp>
+#include <entt/entity/registry.hpp>
+
+struct position { int value; };
+struct velocity { int value; };
+struct health { int value; };
+struct clock_type { int ticks; };
+
+void move(entt::view<entt::exclude_t<>, position, const velocity> view) {
+    view.each([](auto &pos, const auto &vel) { pos.value += vel.value; });
+}
+
+void heal(entt::view<entt::exclude_t<>, health> view) {
+    view.each([](auto &hp) { ++hp.value; });
+}
+
+void render(entt::view<entt::exclude_t<>, const position> view, const clock_type &) {
+    view.each([](const auto &) {});
+}
+
+void tick(clock_type &clock) {
+    ++clock.ticks;
+}
+
+void spawn(entt::registry &owner) {
+    const auto entity = owner.create();
+    owner.emplace<position>(entity, 0);
+    owner.emplace<velocity>(entity, 1);
+}
+
+struct listener {
+    void check(const entt::group<entt::exclude_t<>, entt::get_t<const velocity>, health> &group) {
+        count = group.size();
+    }
+
+    std::size_t count{};
+};
+
+TEST(Organizer, Graph) {
+    entt::organizer organizer;
+    listener instance;
+
+    organizer.emplace<&move>("move");
+    organizer.emplace<&heal>("heal");
+    organizer.emplace<&render>("render");
+    organizer.emplace<&tick>("tick");
+    organizer.emplace<&listener::check>(instance, "check");
+    organizer.emplace<&spawn>("spawn");
+
+    const auto &graph = organizer.graph();
+
+    ASSERT_EQ(graph.size(), 6u);
+
+    ASSERT_STREQ(graph[0u].name(), "move");
+    ASSERT_EQ(graph[0u].ro_count(), 1u);
+    ASSERT_EQ(graph[0u].rw_count(), 1u);
+    ASSERT_TRUE(graph[0u].top_level());
+    ASSERT_EQ(graph[0u].children(), (std::vector<std::size_t>{2u, 5u}));
+
+    ASSERT_TRUE(graph[1u].top_level());
+    ASSERT_EQ(graph[1u].children(), (std::vector<std::size_t>{4u, 5u}));
+
+    ASSERT_FALSE(graph[2u].top_level());
+    ASSERT_EQ(graph[2u].in_degree(), 1u);
+    ASSERT_EQ(graph[2u].ro_count(), 2u);
+    ASSERT_EQ(graph[2u].rw_count(), 0u);
+    ASSERT_EQ(graph[2u].children(), (std::vector<std::size_t>{3u, 5u}));
+
+    ASSERT_EQ(graph[3u].in_degree(), 1u);
+    ASSERT_EQ(graph[4u].in_degree(), 1u);
+    ASSERT_EQ(graph[4u].data(), &instance);
+    ASSERT_EQ(graph[5u].in_degree(), 5u);
+    ASSERT_TRUE(graph[5u].children().empty());
+
+    organizer.clear();
+
+    ASSERT_TRUE(organizer.graph().empty());
+}
+
+TEST(Organizer, RawFunction) {
+    entt::organizer organizer;
+    entt::registry registry;
+    int value{};
+
+    organizer.emplace<const position>(+[](const void *payload, entt::registry &) {
+        ++*static_cast<int *>(const_cast<void *>(payload));
+    }, &value, "raw");
+
+    organizer.emplace<entt::view<entt::exclude_t<>, position>>(+[](const void *, entt::registry &) {});
+
+    const auto &graph = organizer.graph();
+
+    ASSERT_EQ(graph.size(), 2u);
+    ASSERT_EQ(graph[0u].ro_count(), 1u);
+    ASSERT_EQ(graph[0u].children(), (std::vector<std::size_t>{1u}));
+    ASSERT_EQ(graph[1u].name(), nullptr);
+
+    organizer.run(registry);
+
+    ASSERT_EQ(value, 1);
+}
+
+TEST(Organizer, Run) {
+    entt::organizer organizer;
+    entt::registry registry;
+    entt::thread_pool pool{3u};
+    listener instance;
+
+    registry.set<clock_type>();
+
+    for(auto next = 0; next < 10; ++next) {
+        const auto entity = registry.create();
+        registry.emplace<position>(entity, next);
+        registry.emplace<velocity>(entity, 2);
+        registry.emplace<health>(entity, next);
+    }
+
+    organizer.emplace<&move>();
+    organizer.emplace<&heal>();
+    organizer.emplace<&render>();
+    organizer.emplace<&tick>();
+    organizer.emplace<&listener::check>(instance);
+    organizer.emplace<&spawn>();
+
+    organizer.run(registry);
+
+    ASSERT_EQ(registry.ctx<clock_type>().ticks, 1);
+    ASSERT_EQ(instance.count, 10u);
+    ASSERT_EQ(registry.size<position>(), 11u);
+
+    for(auto next = 0; next < 100; ++next) {
+        organizer.run(registry, pool);
+    }
+
+    ASSERT_EQ(registry.ctx<clock_type>().ticks, 101);
+    ASSERT_EQ(registry.size<position>(), 111u);
+
+    registry.view<position, health>().each([](const auto entity, const auto &pos, const auto &hp) {
+        ASSERT_EQ(pos.value, static_cast<int>(entt::to_integral(entity)) + 202);
+        ASSERT_EQ(hp.value, static_cast<int>(entt::to_integral(entity)) + 101);
+    });
+}
@@ -2,14 +2,32 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <stdexcept>
 #include <cstdint>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include <gtest/gtest.h>
 #include <entt/core/type_traits.hpp>
+#include <entt/entity/component.hpp>
 #include <entt/entity/registry.hpp>
 #include <entt/entity/entity.hpp>
 
 struct empty_type {};
+struct stable_int { int value; };
+
+struct paged_int { int value; };
+
+template<>
+struct entt::component_traits<stable_int>: entt::basic_component_traits {
+    static constexpr entt::deletion_policy deletion = entt::deletion_policy::in_place;
+};
+
+template<>
+struct entt::component_traits<paged_int>: entt::basic_component_traits {
+    static constexpr std::size_t page_size = 2u;
+};
 
 struct non_default_constructible {
     non_default_constructible(int v): value{v} {}
@@ -20,6 +38,23 @@ struct aggregate {
     int value{};
 };
 
+template<std::size_t Value>
+struct context_variable {
+    std::size_t value{Value};
+};
+
+struct large_context_variable {
+    ~large_context_variable() { ++*counter; }
+
+    int *counter;
+    char data[512u];
+};
+
+template<std::size_t... Index>
+auto set_context_variables(entt::registry &registry, std::index_sequence<Index...>) {
+    return std::make_tuple(&registry.set<context_variable<Index>>()...);
+}
+
 struct listener {
     template<typename Component>
     static void sort(entt::registry &registry) {
@@ -97,6 +132,51 @@ TEST(Registry, Context) {
     ASSERT_EQ(registry.try_ctx<float>(), nullptr);
 }
 
+TEST(Registry, ContextManyVariables) {
+    int counter{};
+    entt::registry registry;
+
+    const auto instances = set_context_variables(registry, std::make_index_sequence<34u>{});
+
+    registry.set<large_context_variable>(&counter);
+    registry.unset<context_variable<3u>>();
+    registry.unset<context_variable<17u>>();
+
+    ASSERT_EQ(registry.try_ctx<context_variable<3u>>(), nullptr);
+    ASSERT_EQ(registry.try_ctx<context_variable<17u>>(), nullptr);
+    ASSERT_EQ(&registry.ctx<context_variable<0u>>(), std::get<0u>(instances));
+    ASSERT_EQ(&registry.ctx<context_variable<33u>>(), std::get<33u>(instances));
+    ASSERT_EQ(registry.ctx<context_variable<32u>>().value, 32u);
+    ASSERT_EQ(registry.ctx<large_context_variable>().counter, &counter);
+
+    registry.set<context_variable<3u>>(42u);
+
+    ASSERT_EQ(registry.ctx<context_variable<3u>>().value, 42u);
+    ASSERT_EQ(&registry.ctx<context_variable<4u>>(), std::get<4u>(instances));
+
+    std::size_t count{};
+    registry.ctx([&count](auto) { ++count; });
+
+    ASSERT_EQ(count, 34u);
+
+    static_assert(std::is_nothrow_move_constructible_v<entt::registry>);
+    static_assert(std::is_nothrow_move_assignable_v<entt::registry>);
+
+    entt::registry other{std::move(registry)};
+
+    ASSERT_EQ(registry.try_ctx<context_variable<0u>>(), nullptr);
+    ASSERT_EQ(&other.ctx<context_variable<33u>>(), std::get<33u>(instances));
+
+    registry = std::move(other);
+
+    ASSERT_EQ(&registry.ctx<context_variable<33u>>(), std::get<33u>(instances));
+    ASSERT_EQ(counter, 0);
+
+    registry.unset<large_context_variable>();
+
+    ASSERT_EQ(counter, 1);
+}
+
 TEST(Registry, Functionalities) {
     entt::registry registry;
 
@@ -471,6 +551,48 @@ TEST(Registry, VersionOverflow) {
     ASSERT_EQ(registry.current(entity), registry.version(entity));
 }
 
+TEST(Registry, Alive) {
+    entt::registry registry;
+    entt::entity entities[10u];
+
+    registry.create(std::begin(entities), std::end(entities));
+    registry.destroy(std::begin(entities) + 2u, std::end(entities));
+
+    ASSERT_EQ(registry.size(), 10u);
+    ASSERT_EQ(registry.alive(), 2u);
+
+    static_cast<void>(registry.create(entt::entity{5}));
+    static_cast<void>(registry.create(entt::entity{15}));
+
+    ASSERT_EQ(registry.size(), 16u);
+    ASSERT_EQ(registry.alive(), 4u);
+
+    registry.create();
+
+    ASSERT_EQ(registry.alive(), 5u);
+
+    entt::registry::size_type count{};
+    registry.each([&count, &registry](const auto entity) { ASSERT_TRUE(registry.valid(entity)); ++count; });
+
+    ASSERT_EQ(count, registry.alive());
+
+    std::vector<entt::entity> raw{registry.data(), registry.data() + registry.size()};
+    entt::registry other;
+    other.assign(raw.cbegin(), raw.cend());
+
+    ASSERT_EQ(other.alive(), 5u);
+
+    count = {};
+    other.each([&count, &registry](const auto entity) { ASSERT_TRUE(registry.valid(entity)); ++count; });
+
+    ASSERT_EQ(count, 5u);
+
+    other.clear();
+
+    ASSERT_EQ(other.alive(), 0u);
+    ASSERT_EQ(other.size(), 16u);
+}
+
 TEST(Registry, Each) {
     entt::registry registry;
     entt::registry::size_type tot;
@@ -974,6 +1096,43 @@ TEST(Registry, SortMulti) {
     }
 }
 
+TEST(Registry, SortByKey) {
+    entt::registry registry;
+    std::vector<entt::entity> entities(50000u);
+    registry.create(entities.begin(), entities.end());
+
+    for(std::size_t pos{}; pos < entities.size(); ++pos) {
+        registry.emplace<unsigned int>(entities[pos], static_cast<unsigned int>((pos * 2654435761u) % 100003u));
+        registry.emplace<int>(entities[pos], static_cast<int>(pos));
+    }
+
+    registry.sort_by_key<unsigned int>([](const unsigned int value) { return value; }, [](const std::size_t tasks, auto task) {
+        for(std::size_t pos{}; pos < tasks; ++pos) {
+            task(pos);
+        }
+    });
+
+    unsigned int prev{};
+
+    for(auto entity: registry.view<unsigned int>()) {
+        ASSERT_LE(prev, registry.get<unsigned int>(entity));
+        prev = registry.get<unsigned int>(entity);
+    }
+
+    for(std::size_t pos{}; pos < entities.size(); ++pos) {
+        ASSERT_EQ(registry.get<unsigned int>(entities[pos]), static_cast<unsigned int>((pos * 2654435761u) % 100003u));
+    }
+
+    registry.sort_by_key<int>([](const int value) { return static_cast<unsigned int>(100000 - value); });
+
+    int iprev{100000};
+
+    for(auto entity: registry.view<int>()) {
+        ASSERT_GE(iprev, registry.get<int>(entity));
+        iprev = registry.get<int>(entity);
+    }
+}
+
 TEST(Registry, SortEmpty) {
     entt::registry registry;
 
@@ -1120,6 +1279,169 @@ TEST(Registry, Signals) {
     ASSERT_EQ(listener.last, e0);
 }
 
+struct batch_listener {
+    void incr(const entt::registry &, const entt::entity *first, const entt::entity *last) {
+        entities += static_cast<std::size_t>(last - first);
+        ++calls;
+    }
+
+    std::size_t entities{};
+    std::size_t calls{};
+};
+
+TEST(Registry, BatchSignals) {
+    entt::registry registry;
+    batch_listener on_construct;
+    batch_listener on_destroy;
+    listener listener;
+
+    registry.on_construct_batch<int>().connect<&batch_listener::incr>(on_construct);
+    registry.on_destroy_batch<int>().connect<&batch_listener::incr>(on_destroy);
+    registry.on_construct<int>().connect<&listener::incr<int>>(listener);
+
+    std::vector<entt::entity> entities(5u);
+    registry.create(entities.begin(), entities.end());
+    registry.insert<int>(entities.begin(), entities.end());
+
+    ASSERT_EQ(on_construct.calls, 1u);
+    ASSERT_EQ(on_construct.entities, 5u);
+    ASSERT_EQ(listener.counter, 5);
+
+    registry.emplace<int>(registry.create());
+
+    ASSERT_EQ(on_construct.calls, 2u);
+    ASSERT_EQ(on_construct.entities, 6u);
+
+    registry.remove<int>(entities.begin(), entities.begin() + 3u);
+
+    ASSERT_EQ(on_destroy.calls, 1u);
+    ASSERT_EQ(on_destroy.entities, 3u);
+
+    registry.remove<int>(entities[3u]);
+    registry.clear<int>();
+
+    ASSERT_EQ(on_destroy.calls, 3u);
+    ASSERT_EQ(on_destroy.entities, 6u);
+    ASSERT_TRUE(registry.empty<int>());
+}
+
+TEST(Registry, BatchSignalsAndGroups) {
+    entt::registry registry;
+    const auto group = registry.group<int>(entt::get<char>, entt::exclude<double>);
+    std::vector<entt::entity> entities(10u);
+
+    registry.create(entities.begin(), entities.end());
+    registry.insert<char>(entities.begin(), entities.end());
+    registry.insert<int>(entities.begin(), entities.end());
+
+    ASSERT_EQ(group.size(), 10u);
+
+    registry.insert<double>(entities.begin(), entities.begin() + 4u);
+
+    ASSERT_EQ(group.size(), 6u);
+
+    registry.remove<double>(entities.begin(), entities.begin() + 2u);
+    registry.remove<char>(entities.begin() + 8u, entities.end());
+
+    ASSERT_EQ(group.size(), 6u);
+
+    for(auto pos = 0u; pos < entities.size(); ++pos) {
+        ASSERT_EQ(group.contains(entities[pos]), pos < 2u || (pos >= 4u && pos < 8u));
+    }
+}
+
+TEST(Registry, Spawn) {
+    entt::registry registry;
+    batch_listener on_construct;
+    listener listener;
+
+    registry.on_construct_batch<char>().connect<&batch_listener::incr>(on_construct);
+    registry.on_construct<int>().connect<&listener::incr<int>>(listener);
+
+    const auto group = registry.group<int>(entt::get<char>);
+    const auto other = registry.create();
+    registry.emplace<int>(other, 42);
+
+    registry.spawn<int, char, empty_type>(5u, [](const entt::entity entity, int &value, char &chr) {
+        value = static_cast<int>(entt::to_integral(entity));
+        chr = 'c';
+    });
+
+    ASSERT_EQ(registry.alive(), 6u);
+    ASSERT_EQ(registry.size<int>(), 6u);
+    ASSERT_EQ(registry.size<empty_type>(), 5u);
+    ASSERT_EQ(group.size(), 5u);
+    ASSERT_EQ(on_construct.calls, 1u);
+    ASSERT_EQ(on_construct.entities, 5u);
+    ASSERT_EQ(listener.counter, 6);
+
+    group.each([](const entt::entity entity, const int value, const char chr) {
+        ASSERT_EQ(value, static_cast<int>(entt::to_integral(entity)));
+        ASSERT_EQ(chr, 'c');
+    });
+
+    std::vector<entt::entity> entities(3u);
+    registry.spawn<char>(entities.begin(), entities.end(), [](const entt::entity, char &chr) { chr = 'd'; });
+
+    ASSERT_EQ(registry.alive(), 9u);
+    ASSERT_EQ(group.size(), 5u);
+    ASSERT_EQ(on_construct.calls, 2u);
+
+    for(const auto entity: entities) {
+        ASSERT_TRUE(registry.valid(entity));
+        ASSERT_EQ(registry.get<char>(entity), 'd');
+        ASSERT_FALSE(registry.has<int>(entity));
+    }
+}
+
+TEST(Registry, SpawnThrowingInitializer) {
+    entt::registry registry;
+    batch_listener on_construct;
+    listener listener;
+
+    registry.on_construct_batch<char>().connect<&batch_listener::incr>(on_construct);
+    registry.on_construct<int>().connect<&listener::incr<int>>(listener);
+
+    const auto group = registry.group<int>(entt::get<char>);
+    const auto other = registry.create();
+    registry.emplace<int>(other, 42);
+    registry.emplace<char>(other, 'c');
+
+    std::vector<entt::entity> entities(64u);
+    std::size_t count{};
+
+    const auto init = [&count](const entt::entity, int &value, char &) {
+        if(++count == 32u) {
+            throw std::runtime_error{"initializer"};
+        }
+
+        value = 0;
+    };
+
+    ASSERT_THROW((registry.spawn<int, char, empty_type>(entities.begin(), entities.end(), init)), std::runtime_error);
+
+    ASSERT_EQ(count, 32u);
+    ASSERT_EQ(registry.alive(), 1u);
+    ASSERT_EQ(registry.size<int>(), 1u);
+    ASSERT_EQ(registry.size<char>(), 1u);
+    ASSERT_EQ(registry.size<empty_type>(), 0u);
+    ASSERT_EQ(group.size(), 1u);
+    ASSERT_EQ(on_construct.calls, 1u);
+    ASSERT_EQ(listener.counter, 1);
+    ASSERT_EQ(registry.get<int>(other), 42);
+    ASSERT_EQ(registry.get<char>(other), 'c');
+
+    for(const auto entity: entities) {
+        ASSERT_FALSE(registry.valid(entity));
+    }
+
+    registry.spawn<int, char>(2u, [](const entt::entity, int &value, char &) { value = 3; });
+
+    ASSERT_EQ(registry.alive(), 3u);
+    ASSERT_EQ(group.size(), 3u);
+    ASSERT_EQ(on_construct.calls, 2u);
+}
+
 TEST(Registry, RangeDestroy) {
     entt::registry registry;
 
@@ -1465,3 +1787,271 @@ TEST(Registry, Visit) {
 
     hasType[1] = false;
 }
+
+TEST(Registry, InPlaceDelete) {
+    entt::registry registry;
+    entt::entity entities[6u];
+
+    registry.create(std::begin(entities), std::end(entities));
+
+    for(auto next = 0; next < 6; ++next) {
+        registry.emplace<stable_int>(entities[next], 6 - next);
+        registry.emplace<int>(entities[next], next);
+    }
+
+    registry.sort<stable_int>([](const auto &lhs, const auto &rhs) { return lhs.value < rhs.value; });
+    registry.remove<stable_int>(entities[1u]);
+    registry.destroy(entities[4u]);
+
+    const auto view = registry.view<stable_int>();
+    const auto values = [&view]() {
+        std::vector<int> result;
+        view.each([&result](const auto &instance) { result.push_back(instance.value); });
+        return result;
+    };
+
+    ASSERT_EQ(registry.size<stable_int>(), 6u);
+    ASSERT_EQ(values(), (std::vector<int>{1, 3, 4, 6}));
+    ASSERT_EQ((registry.view<stable_int, int>().size_hint()), 5u);
+
+    const auto mview = registry.view<int, stable_int>();
+    const entt::id_type types[]{entt::type_info<stable_int>::id()};
+    const auto rview = registry.runtime_view(std::begin(types), std::end(types));
+
+    ASSERT_EQ(std::distance(mview.begin(), mview.end()), 4);
+    ASSERT_EQ(std::distance(rview.begin(), rview.end()), 4);
+
+    registry.compact();
+
+    ASSERT_EQ(registry.size<stable_int>(), 4u);
+    ASSERT_EQ(values(), (std::vector<int>{1, 3, 4, 6}));
+
+    registry.sort<stable_int>([](const auto &lhs, const auto &rhs) { return lhs.value > rhs.value; });
+    registry.remove<stable_int>(entities[3u]);
+
+    ASSERT_EQ(values(), (std::vector<int>{6, 4, 1}));
+
+    registry.clear<stable_int>();
+
+    ASSERT_TRUE(registry.empty<stable_int>());
+}
+
+template<std::size_t Value>
+struct many_types { int value; };
+
+template<std::size_t... Index>
+void emplace_many_types(entt::registry &registry, const entt::entity entity, std::index_sequence<Index...>) {
+    (registry.emplace<many_types<Index>>(entity, static_cast<int>(Index)), ...);
+}
+
+TEST(Registry, ManyComponentTypes) {
+    entt::registry registry;
+    const auto entity = registry.create();
+    const auto other = registry.create();
+
+    emplace_many_types(registry, entity, std::make_index_sequence<80u>{});
+    registry.emplace<many_types<3u>>(other);
+    registry.emplace<many_types<71u>>(other);
+
+    ASSERT_FALSE(registry.orphan(entity));
+    ASSERT_FALSE(registry.orphan(other));
+    ASSERT_TRUE((registry.has<many_types<0u>, many_types<42u>, many_types<79u>>(entity)));
+    ASSERT_TRUE((registry.has<many_types<3u>, many_types<71u>>(other)));
+    ASSERT_FALSE((registry.has<many_types<3u>, many_types<70u>>(other)));
+    ASSERT_TRUE((registry.any<many_types<3u>, many_types<70u>>(other)));
+    ASSERT_FALSE((registry.any<many_types<4u>, many_types<70u>, int>(other)));
+
+    std::size_t count{};
+    registry.visit(entity, [&count](const auto) { ++count; });
+
+    ASSERT_EQ(count, 80u);
+
+    count = {};
+    registry.visit(other, [&count](const auto component) {
+        ASSERT_TRUE(component == entt::type_info<many_types<3u>>::id() || component == entt::type_info<many_types<71u>>::id());
+        ++count;
+    });
+
+    ASSERT_EQ(count, 2u);
+
+    registry.remove<many_types<71u>>(other);
+
+    ASSERT_FALSE(registry.has<many_types<71u>>(other));
+    ASSERT_TRUE(registry.has<many_types<71u>>(entity));
+
+    registry.remove_all(entity);
+
+    ASSERT_TRUE(registry.orphan(entity));
+    ASSERT_FALSE(registry.orphan(other));
+    ASSERT_FALSE(registry.has<many_types<79u>>(entity));
+    ASSERT_EQ(registry.size<many_types<3u>>(), 1u);
+
+    registry.clear<many_types<3u>>();
+
+    ASSERT_TRUE(registry.orphan(other));
+
+    registry.destroy(other);
+    const auto recycled = registry.create();
+
+    ASSERT_TRUE(registry.orphan(recycled));
+    ASSERT_FALSE(registry.has<many_types<3u>>(recycled));
+}
+
+TEST(Registry, Fork) {
+    entt::registry registry;
+    listener listener;
+
+    const auto entity = registry.create();
+    const auto other = registry.create();
+    registry.destroy(registry.create());
+
+    registry.on_construct<int>().connect<&listener::incr<int>>(listener);
+    registry.emplace<int>(entity, 42);
+    registry.emplace<paged_int>(entity, 3);
+    registry.emplace<paged_int>(other, 1);
+    registry.emplace<empty_type>(other);
+    registry.set<char>('c');
+
+    auto fork = registry.fork();
+
+    ASSERT_EQ(fork.size(), registry.size());
+    ASSERT_EQ(fork.alive(), registry.alive());
+    ASSERT_TRUE(fork.valid(entity));
+    ASSERT_TRUE(fork.valid(other));
+    ASSERT_EQ(fork.get<int>(entity), 42);
+    ASSERT_EQ(fork.get<paged_int>(entity).value, 3);
+    ASSERT_EQ(std::as_const(fork).get<paged_int>(other).value, 1);
+    ASSERT_TRUE(fork.has<empty_type>(other));
+    ASSERT_EQ(fork.try_ctx<char>(), nullptr);
+
+    fork.get<paged_int>(entity).value = 0;
+    fork.remove<empty_type>(other);
+    fork.emplace<int>(other, 0);
+    fork.destroy(entity);
+
+    ASSERT_EQ(listener.counter, 1);
+    ASSERT_FALSE(fork.valid(entity));
+    ASSERT_FALSE(fork.has<empty_type>(other));
+    ASSERT_EQ(fork.size<int>(), 1u);
+
+    ASSERT_TRUE(registry.valid(entity));
+    ASSERT_TRUE(registry.has<empty_type>(other));
+    ASSERT_FALSE(registry.has<int>(other));
+    ASSERT_EQ(registry.get<int>(entity), 42);
+    ASSERT_EQ(registry.get<paged_int>(entity).value, 3);
+
+    registry.clear();
+
+    ASSERT_EQ(fork.get<paged_int>(other).value, 1);
+    ASSERT_EQ(fork.view<paged_int>().size(), 1u);
+}
+
+TEST(Registry, ForkNonCopyable) {
+    entt::registry registry;
+    const auto entity = registry.create();
+
+    registry.emplace<int>(entity, 42);
+    registry.emplace<std::unique_ptr<int>>(entity, new int{3});
+
+    ASSERT_THROW(static_cast<void>(registry.fork()), std::logic_error);
+    ASSERT_EQ(registry.get<int>(entity), 42);
+    ASSERT_EQ(*registry.get<std::unique_ptr<int>>(entity), 3);
+
+    registry.clear<std::unique_ptr<int>>();
+
+    ASSERT_THROW(static_cast<void>(registry.fork()), std::logic_error);
+}
+
+TEST(Registry, Footprint) {
+    entt::registry registry;
+    auto info = registry.footprint();
+
+    ASSERT_EQ(info.pools.reserved, 0u);
+    ASSERT_EQ(info.groups, 0u);
+    ASSERT_EQ(info.vars, 0u);
+
+    for(auto next = 0; next < 10; ++next) {
+        const auto entity = registry.create();
+        registry.emplace<int>(entity, next);
+
+        if(next % 2) {
+            registry.emplace<char>(entity);
+        }
+    }
+
+    static_cast<void>(registry.group(entt::get<int, char>));
+    registry.set<double>();
+
+    std::size_t count{};
+
+    registry.footprint([&count](const auto type, const auto &curr) {
+        if(type == entt::type_info<int>::id()) {
+            ASSERT_EQ(curr.packed, 10u * sizeof(entt::entity));
+            ASSERT_EQ(curr.instances, 10u * sizeof(int));
+        } else {
+            ASSERT_EQ(type, entt::type_info<char>::id());
+            ASSERT_EQ(curr.instances, 5u * sizeof(char));
+        }
+
+        ++count;
+    });
+
+    info = registry.footprint();
+
+    ASSERT_EQ(count, 2u);
+    ASSERT_EQ(info.pools.packed, 15u * sizeof(entt::entity));
+    ASSERT_EQ(info.pools.instances, 10u * sizeof(int) + 5u * sizeof(char));
+    ASSERT_GE(info.pools.reserved, info.pools.packed + info.pools.instances);
+    ASSERT_EQ(info.pools.used_pages, 2u);
+    ASSERT_NE(info.lookup, 0u);
+    ASSERT_GE(info.entities, 10u * sizeof(entt::entity));
+    ASSERT_NE(info.groups, 0u);
+    ASSERT_NE(info.vars, 0u);
+}
+
+TEST(Registry, Stats) {
+    constexpr std::size_t enabled = ENTT_POOL_STATS_ENABLED;
+    entt::registry registry;
+    listener listener;
+
+    registry.on_construct<int>().connect<&listener::incr<int>>(listener);
+
+    const auto entity = registry.create();
+    const auto other = registry.create();
+
+    registry.emplace<int>(entity, 0);
+    registry.emplace<int>(other, 1);
+    registry.emplace<char>(entity, 'c');
+    registry.patch<int>(entity, [](auto &value) { ++value; });
+    registry.replace<int>(other, 3);
+
+    static_cast<void>(registry.get<int>(entity));
+    static_cast<void>(registry.get<int, char>(entity));
+    static_cast<void>(registry.try_get<int>(other));
+    static_cast<void>(registry.get_or_emplace<char>(entity));
+
+    registry.remove<int>(other);
+
+    auto stats = registry.stats<int>();
+
+    ASSERT_EQ(stats.emplace, enabled * 2u);
+    ASSERT_EQ(stats.erase, enabled * 1u);
+    ASSERT_EQ(stats.patch, enabled * 2u);
+    ASSERT_EQ(stats.get, enabled * 3u);
+    ASSERT_EQ(stats.pages, enabled * 1u);
+    ASSERT_EQ(stats.publish, enabled * 2u);
+
+    std::size_t count{};
+
+    registry.stats([&count](const auto type, const auto &curr) {
+        if(type == entt::type_info<char>::id()) {
+            ASSERT_EQ(curr.emplace, enabled * 1u);
+            ASSERT_EQ(curr.get, enabled * 2u);
+            ASSERT_EQ(curr.publish, 0u);
+        }
+
+        ++count;
+    });
+
+    ASSERT_EQ(count, 2u);
+}
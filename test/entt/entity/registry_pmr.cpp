@@ -0,0 +1,73 @@
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <gtest/gtest.h>
+#include <entt/entity/registry.hpp>
+
+struct empty_type {};
+
+void batch_listener(entt::registry &, const entt::entity *, const entt::entity *) {}
+
+struct tracking_resource: std::pmr::memory_resource {
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++count;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override {
+        --count;
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+    std::size_t count{};
+};
+
+TEST(Registry, PolymorphicAllocator) {
+    tracking_resource resource{};
+    const auto *default_resource = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+    {
+        entt::registry registry{&resource};
+
+        ASSERT_EQ(registry.get_allocator().resource(), &resource);
+
+        const auto entity = registry.create();
+        const auto other = registry.create();
+
+        registry.emplace<int>(entity, 42);
+        registry.emplace<int>(other, 3);
+        registry.emplace<char>(other, 'c');
+        registry.emplace<empty_type>(entity);
+
+        registry.set<double>(.3);
+
+        ASSERT_EQ(registry.group<int>(entt::get<char>).size(), 1u);
+        ASSERT_EQ(registry.group(entt::get<int, empty_type>).size(), 1u);
+        ASSERT_EQ(registry.get<int>(entity), 42);
+        ASSERT_EQ(registry.ctx<double>(), .3);
+        ASSERT_NE(resource.count, 0u);
+
+        registry.destroy(entity);
+
+        ASSERT_EQ(registry.group(entt::get<int, empty_type>).size(), 0u);
+
+        // temporaries must come from the allocator of the registry as well
+        registry.sort_by_key<char>([](const char value) { return static_cast<unsigned char>(value); });
+
+        ASSERT_NE(registry.footprint().pools.packed, 0u);
+
+        entt::entity entities[1u]{other};
+        registry.on_destroy_batch<char>().connect<&batch_listener>();
+        registry.remove<char>(std::make_reverse_iterator(std::end(entities)), std::make_reverse_iterator(std::begin(entities)));
+
+        ASSERT_FALSE(registry.has<char>(other));
+    }
+
+    std::pmr::set_default_resource(const_cast<std::pmr::memory_resource *>(default_resource));
+
+    ASSERT_EQ(resource.count, 0u);
+}
@@ -223,3 +223,45 @@ TEST(RuntimeView, ExcludedComponents) {
         ASSERT_EQ(e0, entity);
     });
 }
+
+TEST(RuntimeView, Chunked) {
+    entt::registry registry;
+
+    registry.emplace<int>(registry.create());
+
+    for(auto i = 0; i < 4; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<int>(entity);
+        registry.emplace<char>(entity);
+    }
+
+    const auto other = registry.create();
+    registry.emplace<char>(other);
+
+    for(auto i = 0; i < 3; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<int>(entity);
+        registry.emplace<char>(entity);
+    }
+
+    entt::id_type components[] = { entt::type_info<int>::id(), entt::type_info<char>::id() };
+    auto view = registry.runtime_view(std::begin(components), std::end(components));
+    std::size_t count{};
+
+    view.chunked([&](const entt::entity *entity, std::size_t sz) {
+        const auto *ints = registry.view<int>().data();
+        const auto *chars = registry.view<char>().data();
+        const auto ipos = std::find(ints, ints + registry.size<int>(), entity[0]) - ints;
+        const auto cpos = std::find(chars, chars + registry.size<char>(), entity[0]) - chars;
+
+        for(decltype(sz) i{}; i < sz; ++i) {
+            ASSERT_TRUE(view.contains(entity[i]));
+            ASSERT_EQ(ints[ipos + i], entity[i]);
+            ASSERT_EQ(chars[cpos + i], entity[i]);
+        }
+
+        count += sz;
+    });
+
+    ASSERT_EQ(count, 7u);
+}
@@ -0,0 +1,268 @@
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include <entt/entity/pool.hpp>
+#include <entt/entity/registry.hpp>
+#include <entt/entity/soa_storage.hpp>
+
+struct position {
+    float x;
+    float y;
+};
+
+struct fragile {
+    fragile(const int v): value{v} {}
+    fragile(const fragile &) = default;
+
+    fragile(fragile &&other): value{other.value} {
+        if(value < 0) {
+            throw std::runtime_error{"fragile"};
+        }
+    }
+
+    fragile & operator=(const fragile &) = default;
+    fragile & operator=(fragile &&) = default;
+
+    int value;
+};
+
+struct brittle {
+    int a;
+    fragile b;
+};
+
+using position_storage = entt::soa_storage<entt::entity, position, &position::x, &position::y>;
+
+template<typename Entity>
+struct entt::pool<Entity, position> {
+    using type = entt::default_pool<Entity, position, entt::soa_storage<Entity, position, &position::x, &position::y>>;
+};
+
+TEST(SoAStorage, Functionalities) {
+    position_storage pool;
+
+    pool.reserve(42);
+
+    ASSERT_EQ(pool.capacity(), 42u);
+    ASSERT_TRUE(pool.empty());
+    ASSERT_EQ(pool.begin(), pool.end());
+
+    pool.emplace(entt::entity{41}, 1.f, 2.f);
+    pool.emplace(entt::entity{3}, 3.f, 4.f);
+
+    ASSERT_EQ(pool.size(), 2u);
+    ASSERT_TRUE(pool.contains(entt::entity{41}));
+    ASSERT_TRUE(pool.contains(entt::entity{3}));
+
+    ASSERT_EQ(pool.get(entt::entity{41}).get<&position::x>(), 1.f);
+    ASSERT_EQ(pool.get(entt::entity{41}).get<&position::y>(), 2.f);
+    ASSERT_EQ(std::as_const(pool).get(entt::entity{3}).get<&position::x>(), 3.f);
+
+    const position value = pool.get(entt::entity{3});
+
+    ASSERT_EQ(value.x, 3.f);
+    ASSERT_EQ(value.y, 4.f);
+
+    pool.get(entt::entity{3}) = position{5.f, 6.f};
+    pool.get(entt::entity{41}).get<&position::y>() = 7.f;
+
+    ASSERT_EQ(pool.raw().data<&position::x>()[0u], 1.f);
+    ASSERT_EQ(pool.raw().data<&position::y>()[0u], 7.f);
+    ASSERT_EQ(pool.raw().data<&position::x>()[1u], 5.f);
+    ASSERT_EQ(pool.raw().data<&position::y>()[1u], 6.f);
+
+    pool.erase(entt::entity{41});
+
+    ASSERT_EQ(pool.size(), 1u);
+    ASSERT_FALSE(pool.contains(entt::entity{41}));
+    ASSERT_EQ(pool.raw().data<&position::x>()[0u], 5.f);
+    ASSERT_EQ(pool.raw().data<&position::y>()[0u], 6.f);
+
+    pool.clear();
+
+    ASSERT_TRUE(pool.empty());
+
+    pool.shrink_to_fit();
+
+    ASSERT_EQ(pool.capacity(), 0u);
+}
+
+TEST(SoAStorage, Iterator) {
+    using iterator = typename position_storage::iterator;
+
+    static_assert(std::is_same_v<typename iterator::reference, entt::soa_reference<position, &position::x, &position::y>>);
+
+    position_storage pool;
+    pool.emplace(entt::entity{3}, 1.f, 2.f);
+    pool.emplace(entt::entity{42}, 3.f, 4.f);
+
+    iterator begin{pool.begin()};
+    iterator end{pool.end()};
+
+    ASSERT_EQ(end - begin, 2);
+    ASSERT_EQ((*begin).get<&position::x>(), 3.f);
+    ASSERT_EQ(begin[1].get<&position::x>(), 1.f);
+    ASSERT_EQ(++begin + 1, end);
+
+    float sum{};
+
+    for(auto &&elem: std::as_const(pool)) {
+        sum += elem.get<&position::x>() + elem.get<&position::y>();
+    }
+
+    ASSERT_EQ(sum, 10.f);
+}
+
+TEST(SoAStorage, Insert) {
+    position_storage pool;
+    entt::entity entities[3u]{entt::entity{3}, entt::entity{42}, entt::entity{7}};
+
+    pool.insert(std::begin(entities), std::begin(entities) + 2, position{1.f, 2.f});
+
+    ASSERT_EQ(pool.size(), 2u);
+    ASSERT_EQ(pool.get(entt::entity{42}).get<&position::y>(), 2.f);
+
+    const position values[1u]{{3.f, 4.f}};
+    pool.insert(std::begin(entities) + 2, std::end(entities), std::begin(values), std::end(values));
+
+    ASSERT_EQ(pool.size(), 3u);
+    ASSERT_EQ(pool.index(entt::entity{7}), 2u);
+    ASSERT_EQ(pool.raw().data<&position::x>()[2u], 3.f);
+    ASSERT_EQ(pool.raw().data<&position::y>()[2u], 4.f);
+
+    pool.erase(std::begin(entities), std::end(entities));
+
+    ASSERT_TRUE(pool.empty());
+}
+
+TEST(SoAStorage, ThrowingMember) {
+    entt::soa_storage<entt::entity, brittle, &brittle::a, &brittle::b> pool;
+    const entt::entity entities[2u]{entt::entity{3}, entt::entity{4}};
+    const fragile invalid{-1};
+
+    pool.emplace(entt::entity{1}, 3, fragile{3});
+
+    ASSERT_THROW(pool.emplace(entt::entity{2}, 4, invalid), std::runtime_error);
+    ASSERT_EQ(pool.size(), 1u);
+    ASSERT_FALSE(pool.contains(entt::entity{2}));
+
+    pool.emplace(entt::entity{2}, 5, fragile{5});
+
+    ASSERT_EQ(pool.get(entt::entity{2}).get<&brittle::a>(), 5);
+    ASSERT_EQ(pool.get(entt::entity{2}).get<&brittle::b>().value, 5);
+
+    const brittle values[2u]{{7, fragile{7}}, {8, fragile{-1}}};
+
+    ASSERT_THROW(pool.insert(std::begin(entities), std::end(entities), std::begin(values), std::end(values)), std::runtime_error);
+    ASSERT_EQ(pool.size(), 2u);
+    ASSERT_FALSE(pool.contains(entt::entity{3}));
+
+    pool.insert(std::begin(entities), std::end(entities), brittle{9, fragile{9}});
+
+    ASSERT_EQ(pool.size(), 4u);
+    ASSERT_EQ(pool.get(entt::entity{1}).get<&brittle::a>(), 3);
+    ASSERT_EQ(pool.get(entt::entity{2}).get<&brittle::b>().value, 5);
+    ASSERT_EQ(pool.get(entt::entity{4}).get<&brittle::a>(), 9);
+    ASSERT_EQ(pool.get(entt::entity{4}).get<&brittle::b>().value, 9);
+}
+
+TEST(SoAStorage, Sort) {
+    position_storage pool;
+    std::vector<entt::entity> entities{};
+
+    for(auto next = 0u; next < 5u; ++next) {
+        entities.push_back(entt::entity{next});
+        pool.emplace(entities.back(), static_cast<float>(next % 3u), static_cast<float>(next));
+    }
+
+    pool.sort(pool.begin(), pool.end(), [](const auto lhs, const auto rhs) {
+        return lhs.template get<&position::x>() < rhs.template get<&position::x>();
+    });
+
+    auto prev = pool.begin();
+
+    for(auto it = ++pool.begin(); it != pool.end(); ++it, ++prev) {
+        ASSERT_LE((*prev).get<&position::x>(), (*it).get<&position::x>());
+    }
+
+    for(auto entt: entities) {
+        const position value = pool.get(entt);
+        ASSERT_EQ(value.x, static_cast<float>(entt::to_integral(entt) % 3u));
+        ASSERT_EQ(value.y, static_cast<float>(entt::to_integral(entt)));
+    }
+}
+
+TEST(SoAStorage, Registry) {
+    entt::registry registry;
+
+    static_assert(std::is_base_of_v<position_storage, entt::pool_t<entt::entity, position>>);
+
+    const auto e0 = registry.create();
+    const auto e1 = registry.create();
+
+    registry.emplace<position>(e0, 1.f, 2.f);
+    registry.emplace<position>(e1, 3.f, 4.f);
+    registry.emplace<int>(e1, 42);
+
+    ASSERT_EQ(registry.get<position>(e0).get<&position::x>(), 1.f);
+
+    registry.patch<position>(e0, [](auto &&pos) { pos.template get<&position::x>() = 5.f; });
+    registry.replace<position>(e1, 6.f, 7.f);
+
+    auto [pos, value] = registry.get<position, int>(e1);
+
+    ASSERT_EQ(pos.get<&position::x>(), 6.f);
+    ASSERT_EQ(pos.get<&position::y>(), 7.f);
+    ASSERT_EQ(value, 42);
+
+    float sum{};
+
+    registry.view<position>().each([&sum](auto &&elem) {
+        sum += elem.template get<&position::x>();
+    });
+
+    ASSERT_EQ(sum, 11.f);
+
+    registry.view<position, int>().each([](auto entt, auto &&elem, int &other) {
+        ASSERT_EQ(entt::to_integral(entt), 1u);
+        ASSERT_EQ(elem.template get<&position::y>(), 7.f);
+        ASSERT_EQ(other, 42);
+    });
+
+    registry.view<position, int>().chunked([](const entt::entity *entities, auto arrays, const int *other, std::size_t length) {
+        ASSERT_EQ(length, 1u);
+        ASSERT_EQ(entities[0u], entt::entity{1});
+        ASSERT_EQ(arrays.template data<&position::x>()[0u], 6.f);
+        ASSERT_EQ(other[0u], 42);
+    });
+
+    registry.group<position>(entt::get<int>).each([](auto &&elem, int &other) {
+        elem.template get<&position::x>() += static_cast<float>(other);
+    });
+
+    ASSERT_EQ(registry.get<position>(e1).get<&position::x>(), 48.f);
+
+    registry.remove<position>(e0);
+
+    ASSERT_FALSE(registry.has<position>(e0));
+    ASSERT_EQ(registry.size<position>(), 1u);
+}
+
+TEST(SoAStorage, Spawn) {
+    entt::registry registry;
+
+    registry.spawn<position>(3u, [](const entt::entity entity, auto ref) {
+        ref.template get<&position::x>() = static_cast<float>(entt::to_integral(entity));
+        ref.template get<&position::y>() = 1.f;
+    });
+
+    ASSERT_EQ(registry.size<position>(), 3u);
+
+    registry.view<position>().each([](const entt::entity entity, auto ref) {
+        ASSERT_EQ(ref.template get<&position::x>(), static_cast<float>(entt::to_integral(entity)));
+        ASSERT_EQ(ref.template get<&position::y>(), 1.f);
+    });
+}
@@ -1,8 +1,11 @@
 #include <cstdint>
 #include <utility>
 #include <iterator>
+#include <vector>
 #include <algorithm>
 #include <functional>
+#include <memory_resource>
+#include <stdexcept>
 #include <type_traits>
 #include <gtest/gtest.h>
 #include <entt/entity/sparse_set.hpp>
@@ -11,6 +14,24 @@
 struct empty_type {};
 struct boxed_int { int value; };
 
+struct mirrored_set: entt::sparse_set<entt::entity> {
+    void emplace(const entt::entity entity) {
+        entt::sparse_set<entt::entity>::emplace(entity);
+        mirror.push_back(entity);
+    }
+
+    std::vector<entt::entity> mirror;
+
+protected:
+    void move_element(const std::size_t from, const std::size_t to) override {
+        mirror[to] = mirror[from];
+    }
+
+    void truncate(const std::size_t length) override {
+        mirror.resize(length);
+    }
+};
+
 TEST(SparseSet, Functionalities) {
     entt::sparse_set<entt::entity> set;
 
@@ -138,6 +159,42 @@ TEST(SparseSet, BatchAdd) {
     ASSERT_EQ(set.data()[set.index(entt::entity{24})], entt::entity{24});
 }
 
+TEST(SparseSet, BatchErase) {
+    entt::sparse_set<entt::entity> set;
+    std::vector<entt::entity> entities;
+
+    for(auto next = 0u; next < 64u; ++next) {
+        set.emplace(entt::entity(next));
+    }
+
+    set.erase(set.begin(), set.begin() + 2);
+
+    ASSERT_EQ(set.size(), 62u);
+    ASSERT_FALSE(set.contains(entt::entity{63}));
+    ASSERT_FALSE(set.contains(entt::entity{62}));
+
+    for(auto next = 0u; next < 62u; next += 2u) {
+        entities.push_back(entt::entity(next));
+    }
+
+    set.erase(entities.begin(), entities.end());
+
+    ASSERT_EQ(set.size(), 31u);
+
+    for(auto next = 0u; next < 62u; ++next) {
+        ASSERT_EQ(set.contains(entt::entity(next)), next % 2u == 1u);
+    }
+
+    for(auto pos = 0u; pos < set.size(); ++pos) {
+        ASSERT_EQ(set.index(set.data()[pos]), pos);
+    }
+
+    set.erase(set.begin(), set.end());
+
+    ASSERT_TRUE(set.empty());
+    ASSERT_FALSE(set.contains(entt::entity{1}));
+}
+
 TEST(SparseSet, Iterator) {
     using iterator = typename entt::sparse_set<entt::entity>::iterator;
 
@@ -760,3 +817,311 @@ TEST(SparseSet, CanModifyDuringIteration) {
     const auto entity = *it;
     (void)entity;
 }
+
+TEST(SparseSet, SpreadIdentifiers) {
+    entt::sparse_set<entt::entity> set;
+    const auto last = entt::entt_traits<entt::entity>::entity_mask - 1u;
+
+    set.emplace(entt::entity{last});
+    set.emplace(entt::entity{0});
+
+    ASSERT_GT(set.extent(), last);
+    ASSERT_TRUE(set.contains(entt::entity{last}));
+    ASSERT_FALSE(set.contains(entt::entity{last - 1u}));
+    ASSERT_FALSE(set.contains(entt::entity{1}));
+    ASSERT_EQ(set.index(entt::entity{last}), 0u);
+    ASSERT_EQ(set.index(entt::entity{0}), 1u);
+
+    set.erase(entt::entity{last});
+
+    ASSERT_FALSE(set.contains(entt::entity{last}));
+    ASSERT_EQ(set.index(entt::entity{0}), 0u);
+}
+
+TEST(SparseSet, CustomAllocator) {
+    std::pmr::monotonic_buffer_resource resource{};
+    entt::sparse_set<entt::entity, std::pmr::polymorphic_allocator<entt::entity>> set{&resource};
+
+    ASSERT_EQ(set.get_allocator().resource(), &resource);
+
+    set.emplace(entt::entity{42});
+    set.emplace(entt::entity{3});
+
+    decltype(set) other{std::move(set)};
+
+    ASSERT_TRUE(set.empty());
+    ASSERT_EQ(other.get_allocator().resource(), &resource);
+    ASSERT_TRUE(other.contains(entt::entity{42}));
+    ASSERT_EQ(other.index(entt::entity{3}), 1u);
+
+    set = std::move(other);
+
+    ASSERT_TRUE(other.empty());
+    ASSERT_TRUE(set.contains(entt::entity{42}));
+
+    set.clear();
+
+    ASSERT_FALSE(set.contains(entt::entity{42}));
+}
+
+TEST(SparseSet, Hashed) {
+    entt::sparse_set<entt::entity> set{entt::sparse_policy::hashed};
+    entt::sparse_set<entt::entity> other{entt::sparse_policy::hashed};
+
+    ASSERT_EQ(set.policy(), entt::sparse_policy::hashed);
+    ASSERT_EQ(set.extent(), 0u);
+    ASSERT_FALSE(set.contains(entt::entity{0}));
+
+    for(std::uint32_t next{}; next < 64u; ++next) {
+        set.emplace(entt::entity{next * 4096u});
+    }
+
+    ASSERT_EQ(set.size(), 64u);
+    ASSERT_EQ(set.extent(), 256u);
+
+    for(std::uint32_t next{}; next < 64u; ++next) {
+        ASSERT_TRUE(set.contains(entt::entity{next * 4096u}));
+        ASSERT_FALSE(set.contains(entt::entity{next * 4096u + 1u}));
+        ASSERT_EQ(set.index(entt::entity{next * 4096u}), next);
+
+        ASSERT_TRUE(set.contains<entt::sparse_policy::hashed>(entt::entity{next * 4096u}));
+        ASSERT_FALSE(set.contains<entt::sparse_policy::hashed>(entt::entity{next * 4096u + 1u}));
+        ASSERT_EQ(set.index<entt::sparse_policy::hashed>(entt::entity{next * 4096u}), next);
+    }
+
+    other.insert<entt::sparse_policy::hashed>(set.begin(), set.end());
+    other.emplace<entt::sparse_policy::hashed>(entt::entity{1});
+
+    ASSERT_EQ(other.size(), 65u);
+    ASSERT_TRUE(other.contains(entt::entity{1}));
+    ASSERT_EQ(other.index(entt::entity{1}), 64u);
+
+    other.clear();
+
+    for(std::uint32_t next{}; next < 64u; next += 2u) {
+        set.erase(entt::entity{next * 4096u});
+    }
+
+    ASSERT_EQ(set.size(), 32u);
+
+    for(std::uint32_t next{}; next < 64u; ++next) {
+        ASSERT_EQ(set.contains(entt::entity{next * 4096u}), (next % 2u) == 1u);
+    }
+
+    for(auto entity: set) {
+        ASSERT_EQ(*(set.data() + set.index(entity)), entity);
+    }
+
+    set.sort(set.begin(), set.end(), std::less{});
+
+    ASSERT_TRUE(std::is_sorted(set.begin(), set.end()));
+
+    for(auto entity: set) {
+        ASSERT_EQ(*(set.data() + set.index(entity)), entity);
+    }
+
+    const entt::entity entities[3u]{entt::entity{4096u * 63u}, entt::entity{42}, entt::entity{4096u * 3u}};
+    other.insert(std::begin(entities), std::end(entities));
+    set.respect(other);
+
+    ASSERT_EQ(*set.begin(), entt::entity{4096u * 3u});
+    ASSERT_EQ(*(++set.begin()), entt::entity{4096u * 63u});
+
+    set.clear();
+
+    ASSERT_TRUE(set.empty());
+    ASSERT_EQ(set.extent(), 0u);
+    ASSERT_FALSE(set.contains(entt::entity{4096u}));
+}
+
+TEST(SparseSet, EraseNotifiesDerivedClasses) {
+    mirrored_set set;
+    std::vector<entt::entity> entities;
+
+    for(auto next = 0u; next < 64u; ++next) {
+        set.emplace(entt::entity(next));
+    }
+
+    set.erase(entt::entity{3});
+    set.erase(entt::entity{63});
+
+    for(auto next = 0u; next < 62u; next += 2u) {
+        entities.push_back(entt::entity(next));
+    }
+
+    // small batches remove one entity at a time, large ones in a single pass
+    set.erase(entities.begin(), entities.begin() + 2u);
+    set.erase(entities.begin() + 2u, entities.end());
+
+    ASSERT_EQ(set.size(), 31u);
+    ASSERT_EQ(set.mirror.size(), set.size());
+
+    for(auto pos = 0u; pos < set.size(); ++pos) {
+        ASSERT_EQ(set.mirror[pos], set.data()[pos]);
+    }
+}
+
+TEST(SparseSet, BatchEraseThrowingDerivedClass) {
+    struct fragile_set: mirrored_set {
+        std::size_t budget{};
+
+    protected:
+        void move_element(const std::size_t from, const std::size_t to) override {
+            if(budget && !--budget) {
+                throw std::runtime_error{"fragile"};
+            }
+
+            mirrored_set::move_element(from, to);
+        }
+    };
+
+    fragile_set set;
+    std::vector<entt::entity> entities;
+
+    for(auto next = 0u; next < 64u; ++next) {
+        set.emplace(entt::entity(next));
+    }
+
+    for(auto next = 0u; next < 64u; next += 2u) {
+        entities.push_back(entt::entity(next));
+    }
+
+    set.budget = 3u;
+
+    ASSERT_THROW(set.erase(entities.begin(), entities.end()), std::runtime_error);
+    ASSERT_EQ(set.mirror.size(), set.size());
+
+    for(auto pos = 0u; pos < set.size(); ++pos) {
+        ASSERT_FALSE(set.data()[pos] == entt::null);
+        ASSERT_EQ(set.index(set.data()[pos]), pos);
+        ASSERT_EQ(set.mirror[pos], set.data()[pos]);
+    }
+
+    for(auto next = 1u; next < 64u; next += 2u) {
+        ASSERT_TRUE(set.contains(entt::entity(next)));
+    }
+
+    entities.erase(std::remove_if(entities.begin(), entities.end(), [&set](const auto entity) { return !set.contains(entity); }), entities.end());
+    set.erase(entities.begin(), entities.end());
+
+    ASSERT_EQ(set.size(), 32u);
+    ASSERT_EQ(set.mirror.size(), set.size());
+
+    for(auto pos = 0u; pos < set.size(); ++pos) {
+        ASSERT_EQ(set.mirror[pos], set.data()[pos]);
+    }
+}
+
+TEST(SparseSet, InPlaceDelete) {
+    entt::sparse_set<entt::entity> set{entt::sparse_policy::paged, entt::deletion_policy::in_place};
+
+    ASSERT_EQ(set.deletion(), entt::deletion_policy::in_place);
+
+    for(auto next = 0u; next < 8u; ++next) {
+        set.emplace(entt::entity(next));
+    }
+
+    set.sort(set.begin(), set.end(), std::less{});
+    set.erase(entt::entity{2});
+    set.erase(entt::entity{5});
+
+    ASSERT_EQ(set.size(), 8u);
+    ASSERT_FALSE(set.contains(entt::entity{2}));
+    ASSERT_FALSE(set.contains(entt::entity{5}));
+    ASSERT_EQ(set.index(entt::entity{7}), 0u);
+    ASSERT_EQ(set.index(entt::entity{0}), 7u);
+    ASSERT_TRUE(set.data()[5u] == entt::null);
+
+    set.erase(entt::entity{7});
+    set.erase(entt::entity{0});
+
+    ASSERT_EQ(set.size(), 7u);
+    ASSERT_TRUE(set.data()[0u] == entt::null);
+
+    set.compact();
+
+    ASSERT_EQ(set.size(), 4u);
+    ASSERT_TRUE(std::is_sorted(set.begin(), set.end()));
+
+    for(auto entity: set) {
+        ASSERT_EQ(*(set.data() + set.index(entity)), entity);
+    }
+
+    set.erase(entt::entity{1});
+
+    ASSERT_EQ(set.size(), 3u);
+    ASSERT_EQ(*set.begin(), entt::entity{3});
+}
+
+TEST(SparseSet, Footprint) {
+    constexpr auto entt_per_page = ENTT_PAGE_SIZE / sizeof(entt::entity);
+    entt::sparse_set<entt::entity> set;
+    entt::sparse_set<entt::entity> hashed{entt::sparse_policy::hashed};
+
+    auto info = set.footprint();
+
+    ASSERT_EQ(info.packed, 0u);
+    ASSERT_EQ(info.instances, 0u);
+    ASSERT_EQ(info.reserved, 0u);
+    ASSERT_EQ(info.sparse, 0u);
+    ASSERT_EQ(info.pages, 0u);
+    ASSERT_EQ(info.used_pages, 0u);
+
+    set.reserve(8u);
+    set.emplace(entt::entity{0});
+    set.emplace(static_cast<entt::entity>(3u * entt_per_page));
+    set.erase(entt::entity{0});
+
+    info = set.footprint();
+
+    ASSERT_EQ(info.packed, sizeof(entt::entity));
+    ASSERT_EQ(info.instances, 0u);
+    ASSERT_EQ(info.reserved, set.capacity() * sizeof(entt::entity));
+    ASSERT_GE(info.sparse, 2u * entt_per_page * sizeof(entt::entity));
+    ASSERT_EQ(info.pages, 2u);
+    ASSERT_EQ(info.used_pages, 1u);
+
+    for(std::uint32_t next{}; next < 4u; ++next) {
+        hashed.emplace(entt::entity{next * 4096u});
+    }
+
+    info = hashed.footprint();
+
+    ASSERT_EQ(info.packed, 4u * sizeof(entt::entity));
+    ASSERT_GE(info.sparse, 4u * sizeof(entt::entity));
+    ASSERT_EQ(info.pages, 0u);
+    ASSERT_EQ(info.used_pages, 0u);
+}
+
+TEST(SparseSet, Stats) {
+    constexpr auto entt_per_page = ENTT_PAGE_SIZE / sizeof(entt::entity);
+    constexpr std::size_t enabled = ENTT_POOL_STATS_ENABLED;
+    entt::sparse_set<entt::entity> set;
+    entt::entity entities[3u]{entt::entity{1}, entt::entity{2}, static_cast<entt::entity>(entt_per_page)};
+
+    set.emplace(entt::entity{0});
+    set.insert(std::begin(entities), std::end(entities));
+    set.erase(entt::entity{0});
+    set.record(entt::pool_event::publish, 2u);
+
+    entt::sparse_set<entt::entity> other{set, entt::fork_t{}};
+    other.emplace(entt::entity{3});
+
+    auto stats = set.stats();
+
+    ASSERT_EQ(stats.emplace, enabled * 4u);
+    ASSERT_EQ(stats.erase, enabled * 1u);
+    ASSERT_EQ(stats.patch, 0u);
+    ASSERT_EQ(stats.get, 0u);
+    ASSERT_EQ(stats.pages, enabled * 2u);
+    ASSERT_EQ(stats.publish, enabled * 2u);
+
+    // the fork starts from zero and unshares the first page
+    ASSERT_EQ(other.stats().emplace, enabled * 1u);
+    ASSERT_EQ(other.stats().pages, enabled * 1u);
+
+    set.clear();
+    stats = set.stats();
+
+    ASSERT_EQ(stats.erase, enabled * 4u);
+}
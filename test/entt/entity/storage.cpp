@@ -1,15 +1,58 @@
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <utility>
 #include <iterator>
 #include <exception>
 #include <type_traits>
 #include <unordered_set>
+#include <vector>
 #include <gtest/gtest.h>
+#include <entt/entity/component.hpp>
 #include <entt/entity/storage.hpp>
 #include <entt/entity/fwd.hpp>
 
 struct empty_type {};
 struct boxed_int { int value; };
+struct paged_int { int value; };
+struct hashed_int { int value; };
+struct stable_int { int value; };
+struct tracked_int { int value; };
+
+template<>
+struct entt::component_traits<paged_int>: entt::basic_component_traits {
+    static constexpr std::size_t page_size = 4u;
+};
+
+struct counted_int {
+    counted_int(const int v): value{v} {}
+    counted_int(const counted_int &other): value{other.value} { ++copies; }
+    counted_int & operator=(const counted_int &) = default;
+
+    inline static std::size_t copies{};
+    int value;
+};
+
+template<>
+struct entt::component_traits<counted_int>: entt::basic_component_traits {
+    static constexpr std::size_t page_size = 4u;
+};
+
+template<>
+struct entt::component_traits<hashed_int>: entt::basic_component_traits {
+    static constexpr entt::sparse_policy sparse = entt::sparse_policy::hashed;
+};
+
+template<>
+struct entt::component_traits<stable_int>: entt::basic_component_traits {
+    static constexpr entt::deletion_policy deletion = entt::deletion_policy::in_place;
+};
+
+template<>
+struct entt::component_traits<tracked_int>: entt::basic_component_traits {
+    static constexpr bool track_changes = true;
+};
 
 struct throwing_component {
     struct constructor_exception: std::exception {};
@@ -104,6 +147,43 @@ TEST(Storage, BatchAdd) {
     ASSERT_EQ(pool.get(entities[1]), 0);
 }
 
+TEST(Storage, BatchErase) {
+    entt::storage<entt::entity, int> pool;
+    std::vector<entt::entity> entities;
+
+    for(auto next = 0; next < 64; ++next) {
+        pool.emplace(entt::entity(next), next);
+    }
+
+    for(auto next = 0; next < 64; next += 4) {
+        entities.push_back(entt::entity(next));
+        entities.push_back(entt::entity(next + 1));
+    }
+
+    pool.erase(entities.begin(), entities.end());
+
+    ASSERT_EQ(pool.size(), 32u);
+
+    for(auto next = 0; next < 64; ++next) {
+        if(next % 4 < 2) {
+            ASSERT_FALSE(pool.contains(entt::entity(next)));
+        } else {
+            ASSERT_EQ(pool.get(entt::entity(next)), next);
+        }
+    }
+
+    pool.erase(pool.data(), pool.data() + 1);
+
+    ASSERT_EQ(pool.size(), 31u);
+    ASSERT_FALSE(pool.contains(entt::entity{63}));
+    ASSERT_EQ(pool.get(entt::entity{62}), 62);
+
+    const entt::sparse_set<entt::entity> &base = pool;
+    pool.erase(base.begin(), base.end());
+
+    ASSERT_TRUE(pool.empty());
+}
+
 TEST(Storage, BatchAddEmptyType) {
     entt::storage<entt::entity, empty_type> pool;
     entt::entity entities[2];
@@ -444,6 +524,63 @@ TEST(Storage, SortUnordered) {
     ASSERT_EQ(begin, end);
 }
 
+TEST(Storage, SortByKey) {
+    entt::storage<entt::entity, boxed_int> pool;
+    entt::storage<entt::entity, paged_int> paged;
+    const int values[]{6, 3, 1, 9, 12, 3};
+
+    for(std::size_t pos{}; pos < std::size(values); ++pos) {
+        pool.emplace(entt::entity(pos), boxed_int{values[pos]});
+        paged.emplace(entt::entity(pos), paged_int{values[pos]});
+    }
+
+    pool.sort_by_key([](const boxed_int &instance) { return static_cast<unsigned int>(instance.value); });
+    paged.sort_by_key([](const paged_int &instance) { return static_cast<std::uint16_t>(instance.value); }, [](const std::size_t tasks, auto task) {
+        for(std::size_t pos{}; pos < tasks; ++pos) {
+            task(pos);
+        }
+    });
+
+    ASSERT_EQ(pool.size(), std::size(values));
+    ASSERT_EQ(paged.size(), std::size(values));
+
+    ASSERT_TRUE(std::is_sorted(pool.begin(), pool.end(), [](const auto &lhs, const auto &rhs) { return lhs.value < rhs.value; }));
+    ASSERT_TRUE(std::is_sorted(paged.begin(), paged.end(), [](const auto &lhs, const auto &rhs) { return lhs.value < rhs.value; }));
+
+    for(std::size_t pos{}; pos < std::size(values); ++pos) {
+        ASSERT_EQ(pool.get(entt::entity(pos)).value, values[pos]);
+        ASSERT_EQ(paged.get(entt::entity(pos)).value, values[pos]);
+        ASSERT_EQ(pool.data()[pool.index(entt::entity(pos))], entt::entity(pos));
+    }
+
+    ASSERT_EQ(pool.begin()->value, 1);
+    ASSERT_EQ(paged.begin()->value, 1);
+}
+
+TEST(Storage, SortByKeyStability) {
+    entt::storage<entt::entity, boxed_int> pool;
+    std::vector<std::pair<entt::entity, int>> expected{};
+
+    for(auto pos = 0u; pos < 64u; ++pos) {
+        pool.emplace(entt::entity{pos}, boxed_int{static_cast<int>((pos * 7u) % 5u)});
+    }
+
+    for(auto entity: static_cast<entt::sparse_set<entt::entity> &>(pool)) {
+        expected.emplace_back(entity, pool.get(entity).value);
+    }
+
+    std::stable_sort(expected.begin(), expected.end(), [](const auto &lhs, const auto &rhs) { return lhs.second < rhs.second; });
+    pool.sort_by_key([](const boxed_int &instance) { return static_cast<unsigned int>(instance.value); });
+
+    auto it = expected.cbegin();
+
+    for(auto entity: static_cast<entt::sparse_set<entt::entity> &>(pool)) {
+        ASSERT_EQ(entity, (it++)->first);
+    }
+
+    ASSERT_EQ(it, expected.cend());
+}
+
 TEST(Storage, SortRange) {
     entt::storage<entt::entity, boxed_int> pool;
 
@@ -765,3 +902,318 @@ TEST(Storage, ConstructorExceptionDoesNotAddToStorage) {
 
     ASSERT_TRUE(pool.empty());
 }
+
+TEST(Storage, Paged) {
+    entt::storage<entt::entity, paged_int> pool;
+
+    pool.emplace(entt::entity{0}, 0);
+    const auto *first = &pool.get(entt::entity{0});
+
+    for(auto next = 1; next < 42; ++next) {
+        pool.emplace(entt::entity(next), next);
+    }
+
+    ASSERT_EQ(pool.size(), 42u);
+    ASSERT_EQ(&pool.get(entt::entity{0}), first);
+    ASSERT_EQ(pool.pages()[0u], first);
+    ASSERT_EQ(std::as_const(pool).pages()[10u][1u].value, 41);
+    ASSERT_EQ(pool.try_get(entt::entity{41}), &pool.pages()[10u][1u]);
+    ASSERT_EQ(pool.try_get(entt::entity{42}), nullptr);
+
+    ASSERT_EQ(pool.end() - pool.begin(), 42);
+    ASSERT_EQ(pool.begin()->value, 41);
+    ASSERT_EQ(pool.rbegin()->value, 0);
+    ASSERT_EQ((pool.rend() - 1)->value, 41);
+    ASSERT_EQ(pool.crend() - pool.crbegin(), 42);
+
+    pool.erase(entt::entity{0});
+
+    ASSERT_EQ(pool.get(entt::entity{41}).value, 41);
+    ASSERT_EQ(&pool.get(entt::entity{41}), first);
+    ASSERT_EQ(pool.size(), 41u);
+
+    pool.sort(pool.begin(), pool.end(), [](const auto &lhs, const auto &rhs) { return lhs.value < rhs.value; });
+
+    auto value = 1;
+
+    for(auto &&instance: pool) {
+        ASSERT_EQ(instance.value, value++);
+    }
+
+    ASSERT_EQ(pool.rbegin()->value, 41);
+
+    pool.shrink_to_fit();
+
+    ASSERT_EQ(pool.get(entt::entity{1}).value, 1);
+
+    pool.clear();
+    pool.shrink_to_fit();
+
+    ASSERT_TRUE(pool.empty());
+}
+
+TEST(Storage, PagedBatchAdd) {
+    entt::storage<entt::entity, paged_int> pool;
+    entt::entity entities[6u]{entt::entity{0}, entt::entity{1}, entt::entity{2}, entt::entity{3}, entt::entity{4}, entt::entity{5}};
+    const paged_int values[3u]{{1}, {2}, {3}};
+
+    pool.insert(std::begin(entities), std::begin(entities) + 3, values, values + 3);
+    pool.insert(std::begin(entities) + 3, std::end(entities), paged_int{42});
+
+    ASSERT_EQ(pool.size(), 6u);
+    ASSERT_EQ(pool.get(entt::entity{0}).value, 1);
+    ASSERT_EQ(pool.get(entt::entity{2}).value, 3);
+    ASSERT_EQ(pool.get(entt::entity{3}).value, 42);
+    ASSERT_EQ(pool.get(entt::entity{5}).value, 42);
+
+    entt::storage<entt::entity, paged_int> other{std::move(pool)};
+
+    ASSERT_TRUE(pool.empty());
+    ASSERT_EQ(other.size(), 6u);
+    ASSERT_EQ(other.get(entt::entity{5}).value, 42);
+}
+
+TEST(Storage, CustomAllocator) {
+    std::pmr::monotonic_buffer_resource resource{};
+    entt::storage<entt::entity, int, std::pmr::polymorphic_allocator<int>> pool{&resource};
+    entt::storage<entt::entity, paged_int, std::pmr::polymorphic_allocator<paged_int>> paged{&resource};
+    entt::storage<entt::entity, empty_type, std::pmr::polymorphic_allocator<empty_type>> empty{&resource};
+
+    ASSERT_EQ(pool.get_allocator().resource(), &resource);
+    ASSERT_EQ(paged.get_allocator().resource(), &resource);
+    ASSERT_EQ(empty.get_allocator().resource(), &resource);
+
+    for(auto next = 0; next < 8; ++next) {
+        pool.emplace(entt::entity(next), next);
+        paged.emplace(entt::entity(next), next);
+        empty.emplace(entt::entity(next));
+    }
+
+    decltype(pool) other{std::move(pool)};
+    decltype(paged) other_paged{std::move(paged)};
+
+    ASSERT_EQ(other.get_allocator().resource(), &resource);
+    ASSERT_EQ(other_paged.get_allocator().resource(), &resource);
+    ASSERT_EQ(other.get(entt::entity{5}), 5);
+    ASSERT_EQ(other_paged.get(entt::entity{5}).value, 5);
+    ASSERT_TRUE(empty.contains(entt::entity{5}));
+}
+
+TEST(Storage, Hashed) {
+    entt::storage<entt::entity, hashed_int> pool;
+
+    ASSERT_EQ(pool.policy(), entt::sparse_policy::hashed);
+
+    pool.emplace(entt::entity{1000000}, 42);
+    pool.emplace(entt::entity{3}, 3);
+    pool.emplace(entt::entity{70000}, 7);
+
+    ASSERT_EQ(pool.get(entt::entity{1000000}).value, 42);
+    ASSERT_EQ(pool.get(entt::entity{70000}).value, 7);
+    ASSERT_EQ(pool.try_get(entt::entity{4}), nullptr);
+
+    pool.erase(entt::entity{1000000});
+
+    ASSERT_FALSE(pool.contains(entt::entity{1000000}));
+    ASSERT_EQ(pool.get(entt::entity{3}).value, 3);
+    ASSERT_EQ(pool.get(entt::entity{70000}).value, 7);
+    ASSERT_LT(pool.extent(), 64u);
+}
+
+TEST(Storage, InPlaceDelete) {
+    entt::storage<entt::entity, stable_int> pool;
+
+    for(auto next = 0; next < 8; ++next) {
+        pool.emplace(entt::entity(next), next);
+    }
+
+    pool.sort(pool.begin(), pool.end(), [](const auto &lhs, const auto &rhs) { return lhs.value < rhs.value; });
+
+    ASSERT_EQ(pool.deletion(), entt::deletion_policy::in_place);
+    ASSERT_EQ(pool.get(entt::entity{3}).value, 3);
+
+    const auto *instance = &pool.get(entt::entity{3});
+    pool.erase(entt::entity{0});
+    pool.erase(entt::entity{4});
+
+    ASSERT_EQ(pool.size(), 7u);
+    ASSERT_EQ(&pool.get(entt::entity{3}), instance);
+    ASSERT_FALSE(pool.contains(entt::entity{4}));
+    ASSERT_EQ(pool.try_get(entt::entity{0}), nullptr);
+
+    pool.compact();
+
+    ASSERT_EQ(pool.size(), 6u);
+
+    const int expected[]{1, 2, 3, 5, 6, 7};
+    ASSERT_TRUE(std::equal(pool.begin(), pool.end(), std::begin(expected), [](const auto &lhs, const auto rhs) { return lhs.value == rhs; }));
+
+    for(auto &&curr: expected) {
+        ASSERT_EQ(pool.get(entt::entity(curr)).value, curr);
+    }
+
+    pool.erase(entt::entity{7});
+
+    ASSERT_EQ(pool.size(), 6u);
+    ASSERT_FALSE(pool.contains(entt::entity{7}));
+    ASSERT_EQ(pool.get(entt::entity{6}).value, 6);
+}
+
+TEST(Storage, ChangeTicks) {
+    entt::storage<entt::entity, tracked_int> pool;
+    entt::entity entities[3u]{entt::entity{3}, entt::entity{12}, entt::entity{42}};
+
+    pool.emplace(entt::entity{1}, 1);
+    pool.insert(std::begin(entities), std::end(entities), tracked_int{0});
+
+    ASSERT_EQ(pool.tick(entt::entity{1}), 0u);
+    ASSERT_EQ(pool.tick(entt::entity{42}), 0u);
+
+    for(auto &&curr: pool) {
+        curr.value = 100 - static_cast<int>(entt::to_integral(pool.data()[&curr - pool.raw()]));
+    }
+
+    pool.stamp(entt::entity{1}, 1u);
+    pool.stamp(entt::entity{3}, 3u);
+    pool.stamp(entt::entity{12}, 12u);
+    pool.stamp(entt::entity{42}, 42u);
+
+    pool.swap(entt::entity{1}, entt::entity{42});
+
+    ASSERT_EQ(pool.tick(entt::entity{1}), 1u);
+    ASSERT_EQ(pool.ticks()[0u], 42u);
+
+    pool.sort(pool.begin(), pool.end(), [](const auto &lhs, const auto &rhs) { return lhs.value < rhs.value; });
+
+    for(auto pos = 0u; pos < pool.size(); ++pos) {
+        ASSERT_EQ(pool.ticks()[pos], entt::to_integral(pool.data()[pos]));
+    }
+
+    pool.sort_by_key([](const auto &value) { return static_cast<unsigned int>(value.value); });
+
+    for(auto pos = 0u; pos < pool.size(); ++pos) {
+        ASSERT_EQ(pool.ticks()[pos], entt::to_integral(pool.data()[pos]));
+    }
+
+    pool.erase(entt::entity{3});
+
+    ASSERT_EQ(pool.size(), 3u);
+    ASSERT_EQ(pool.tick(entt::entity{1}), 1u);
+    ASSERT_EQ(pool.tick(entt::entity{12}), 12u);
+    ASSERT_EQ(pool.tick(entt::entity{42}), 42u);
+
+    pool.clear();
+    pool.emplace(entt::entity{0}, 0);
+
+    ASSERT_EQ(pool.tick(entt::entity{0}), 0u);
+}
+
+TEST(Storage, CopyOnWrite) {
+    entt::storage<entt::entity, paged_int> pool;
+
+    for(auto next = 0u; next < 10u; ++next) {
+        pool.emplace(entt::entity{next}, static_cast<int>(next));
+    }
+
+    const auto copy = std::as_const(pool);
+
+    ASSERT_EQ(copy.size(), 10u);
+    ASSERT_NE(copy.pages()[0u], std::as_const(pool).pages()[0u]);
+    ASSERT_EQ(copy.get(entt::entity{3}).value, 3);
+
+    decltype(pool) other{pool, entt::fork_t{}};
+
+    ASSERT_EQ(other.size(), 10u);
+    ASSERT_EQ(std::as_const(other).pages()[0u], std::as_const(pool).pages()[0u]);
+    ASSERT_EQ(std::as_const(other).pages()[2u], std::as_const(pool).pages()[2u]);
+
+    other.get(entt::entity{1}).value = 42;
+
+    ASSERT_NE(std::as_const(other).pages()[0u], std::as_const(pool).pages()[0u]);
+    ASSERT_EQ(std::as_const(other).pages()[1u], std::as_const(pool).pages()[1u]);
+    ASSERT_EQ(std::as_const(pool).get(entt::entity{1}).value, 1);
+    ASSERT_EQ(other.get(entt::entity{1}).value, 42);
+
+    pool.erase(entt::entity{5});
+    other.emplace(entt::entity{10}, 10);
+
+    ASSERT_EQ(pool.size(), 9u);
+    ASSERT_EQ(other.size(), 11u);
+    ASSERT_TRUE(other.contains(entt::entity{5}));
+    ASSERT_FALSE(pool.contains(entt::entity{10}));
+    ASSERT_EQ(std::as_const(other).get(entt::entity{5}).value, 5);
+    ASSERT_EQ(std::as_const(pool).get(entt::entity{9}).value, 9);
+
+    pool.clear();
+
+    ASSERT_TRUE(pool.empty());
+    ASSERT_EQ(other.size(), 11u);
+
+    for(auto next = 0u; next < 10u; ++next) {
+        ASSERT_EQ(std::as_const(other).get(entt::entity{next}).value, next == 1u ? 42 : static_cast<int>(next));
+    }
+}
+
+TEST(Storage, TruncateSharedPages) {
+    entt::storage<entt::entity, counted_int> pool;
+    entt::entity entities[4u]{entt::entity{8}, entt::entity{9}, entt::entity{10}, entt::entity{11}};
+
+    for(auto next = 0u; next < 12u; ++next) {
+        pool.emplace(entt::entity{next}, static_cast<int>(next));
+    }
+
+    decltype(pool) other{pool, entt::fork_t{}};
+    counted_int::copies = 0u;
+
+    // pages that are dropped as a whole aren't copied
+    other.erase(std::begin(entities), std::end(entities));
+
+    ASSERT_EQ(counted_int::copies, 0u);
+    ASSERT_EQ(other.size(), 8u);
+
+    // only the elements that are kept are copied
+    other.erase(entt::entity{7});
+
+    ASSERT_EQ(counted_int::copies, 3u);
+    ASSERT_EQ(other.size(), 7u);
+
+    other.clear();
+
+    ASSERT_EQ(counted_int::copies, 3u);
+    ASSERT_TRUE(other.empty());
+    ASSERT_EQ(pool.size(), 12u);
+
+    for(auto next = 0u; next < 12u; ++next) {
+        ASSERT_EQ(std::as_const(pool).get(entt::entity{next}).value, static_cast<int>(next));
+    }
+}
+
+TEST(Storage, Footprint) {
+    entt::storage<entt::entity, int> pool;
+    entt::storage<entt::entity, paged_int> paged;
+    entt::storage<entt::entity, tracked_int> tracked;
+
+    pool.reserve(4u);
+    pool.emplace(entt::entity{1}, 42);
+
+    auto info = pool.footprint();
+
+    ASSERT_EQ(info.packed, sizeof(entt::entity));
+    ASSERT_EQ(info.instances, sizeof(int));
+    ASSERT_GE(info.reserved, 4u * (sizeof(entt::entity) + sizeof(int)));
+    ASSERT_EQ(info.pages, 1u);
+    ASSERT_EQ(info.used_pages, 1u);
+
+    for(auto next = 0u; next < 5u; ++next) {
+        paged.emplace(entt::entity{next}, static_cast<int>(next));
+    }
+
+    info = paged.footprint();
+
+    ASSERT_EQ(info.instances, 5u * sizeof(paged_int));
+    ASSERT_EQ(info.reserved, paged.capacity() * sizeof(entt::entity) + 8u * sizeof(paged_int));
+
+    tracked.emplace(entt::entity{0}, 0);
+
+    ASSERT_EQ(tracked.footprint().instances, sizeof(tracked_int) + sizeof(entt::tick_type));
+}
@@ -1,10 +1,34 @@
+#include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <utility>
 #include <type_traits>
+#include <vector>
 #include <gtest/gtest.h>
+#include <entt/entity/component.hpp>
 #include <entt/entity/registry.hpp>
 #include <entt/entity/view.hpp>
+#include <entt/core/thread_pool.hpp>
 
 struct empty_type {};
+struct paged_int { int value; };
+struct stable_int { int value; };
+struct tracked_int { int value; };
+
+template<>
+struct entt::component_traits<paged_int>: entt::basic_component_traits {
+    static constexpr std::size_t page_size = 4u;
+};
+
+template<>
+struct entt::component_traits<stable_int>: entt::basic_component_traits {
+    static constexpr entt::deletion_policy deletion = entt::deletion_policy::in_place;
+};
+
+template<>
+struct entt::component_traits<tracked_int>: entt::basic_component_traits {
+    static constexpr bool track_changes = true;
+};
 
 TEST(SingleComponentView, Functionalities) {
     entt::registry registry;
@@ -278,6 +302,174 @@ TEST(SingleComponentView, FrontBack) {
     ASSERT_EQ(view.back(), e0);
 }
 
+TEST(SingleComponentView, Chunked) {
+    entt::registry registry;
+    std::size_t count{};
+
+    for(auto i = 0; i < 10; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<int>(entity, i);
+        registry.emplace<paged_int>(entity, i);
+        registry.emplace<stable_int>(entity, i);
+        registry.emplace<empty_type>(entity);
+    }
+
+    registry.view<const int>().chunked([&count](const entt::entity *entity, const int *value, std::size_t sz) {
+        ASSERT_EQ(sz, 10u);
+
+        for(decltype(sz) i{}; i < sz; ++i) {
+            ASSERT_EQ(static_cast<int>(entt::to_integral(entity[i])), value[i]);
+        }
+
+        ++count;
+    });
+
+    ASSERT_EQ(count, 1u);
+
+    count = {};
+    registry.view<paged_int>().chunked([&count](const entt::entity *entity, paged_int *value, std::size_t sz) {
+        ASSERT_LE(sz, 4u);
+
+        for(decltype(sz) i{}; i < sz; ++i) {
+            ASSERT_EQ(static_cast<int>(entt::to_integral(entity[i])), value[i].value);
+        }
+
+        count += sz;
+    });
+
+    ASSERT_EQ(count, 10u);
+
+    registry.remove<stable_int>(entt::entity{3});
+    registry.remove<stable_int>(entt::entity{4});
+    registry.remove<stable_int>(entt::entity{7});
+
+    count = {};
+    registry.view<stable_int>().chunked([&count](const entt::entity *entity, stable_int *value, std::size_t sz) {
+        for(decltype(sz) i{}; i < sz; ++i) {
+            ASSERT_TRUE(entity[i] != entt::null);
+            ASSERT_EQ(static_cast<int>(entt::to_integral(entity[i])), value[i].value);
+        }
+
+        count += sz;
+    });
+
+    ASSERT_EQ(count, 7u);
+
+    count = {};
+    registry.view<empty_type>().chunked([&count](const entt::entity *, std::size_t sz) {
+        count += sz;
+    });
+
+    ASSERT_EQ(count, 10u);
+}
+
+TEST(SingleComponentView, InPlaceDelete) {
+    entt::registry registry;
+    entt::entity entities[4u];
+
+    registry.create(std::begin(entities), std::end(entities));
+
+    for(auto next = 0; next < 4; ++next) {
+        registry.emplace<stable_int>(entities[next], next);
+    }
+
+    registry.remove<stable_int>(entities[1u]);
+    registry.remove<stable_int>(entities[2u]);
+
+    auto view = registry.view<stable_int>();
+    std::size_t cnt{};
+
+    ASSERT_EQ(view.size(), 4u);
+    ASSERT_EQ(std::distance(view.begin(), view.end()), 2);
+    ASSERT_EQ(std::distance(view.rbegin(), view.rend()), 2);
+    ASSERT_EQ(view.front(), entities[3u]);
+    ASSERT_EQ(view.back(), entities[0u]);
+    ASSERT_EQ(*(++view.find(entities[3u])), entities[0u]);
+    ASSERT_EQ(view.find(entities[1u]), view.end());
+
+    view.each([&cnt](const auto entt, const auto &instance) { cnt += (entt == entt::entity(instance.value)); });
+    view.each([&cnt](const auto &) { ++cnt; });
+
+    for(auto &&[entt, instance]: view.proxy()) {
+        cnt += (entt == entt::entity(instance.value));
+    }
+
+    ASSERT_EQ(cnt, 6u);
+
+    registry.compact<stable_int>();
+
+    ASSERT_EQ(view.size(), 2u);
+    ASSERT_EQ(view.front(), entities[3u]);
+    ASSERT_EQ(view.get(entities[0u]).value, 0);
+
+    registry.remove<stable_int>(entities[3u]);
+    registry.remove<stable_int>(entities[0u]);
+
+    ASSERT_TRUE(view.empty());
+}
+
+TEST(SingleComponentView, ChangedSince) {
+    entt::registry registry;
+    auto view = registry.view<tracked_int>();
+    auto cview = std::as_const(registry).view<const tracked_int>();
+    entt::entity entities[3u];
+
+    registry.create(std::begin(entities), std::end(entities));
+    registry.insert<tracked_int>(std::begin(entities), std::end(entities));
+
+    const auto tick = registry.tick();
+    std::size_t count{};
+
+    view.each(entt::changed_since<tracked_int>(tick), [&count](auto &&...) { ++count; });
+
+    ASSERT_NE(tick, 0u);
+    ASSERT_EQ(count, 0u);
+
+    registry.patch<tracked_int>(entities[1u], [](auto &value) { value.value = 1; });
+    registry.replace<tracked_int>(entities[2u], 2);
+    registry.emplace<tracked_int>(registry.create(), 3);
+    registry.destroy(entities[2u]);
+
+    cview.each(entt::changed_since<tracked_int>(tick), [&count](const auto entity, const auto &value) {
+        ASSERT_EQ(entt::to_integral(entity), static_cast<entt::id_type>(value.value));
+        ++count;
+    });
+
+    ASSERT_EQ(count, 2u);
+
+    view.each(entt::changed_since<tracked_int>(registry.tick()), [](auto &&...) { FAIL(); });
+}
+
+TEST(SingleComponentView, EachExecutor) {
+    entt::registry registry;
+    entt::thread_pool pool{2u};
+    std::atomic<int> count{};
+
+    for(auto next = 0; next < 100; ++next) {
+        const auto entity = registry.create();
+        registry.emplace<paged_int>(entity, next);
+        registry.emplace<stable_int>(entity, next);
+        registry.emplace<empty_type>(entity);
+    }
+
+    registry.view<paged_int>().each(pool, [](const auto entity, auto &value) {
+        ASSERT_EQ(value.value, static_cast<int>(entt::to_integral(entity)));
+        value.value *= 2;
+    }, 3u);
+
+    registry.view<const paged_int>().each(pool, [&count](const auto &value) {
+        count += value.value;
+    });
+
+    ASSERT_EQ(count.load(), 9900);
+
+    registry.destroy(entt::entity{3});
+    registry.view<stable_int>().each(pool, [&count](auto &value) { count -= value.value; }, 7u);
+    registry.view<empty_type>().each(pool, [&count]() { ++count; }, 7u);
+
+    ASSERT_EQ(count.load(), 4953 + 99);
+}
+
 TEST(MultiComponentView, Functionalities) {
     entt::registry registry;
     auto view = registry.view<int, char>();
@@ -800,6 +992,30 @@ TEST(MultiComponentView, ChunkedContiguous) {
     });
 }
 
+TEST(MultiComponentView, ChunkedPaged) {
+    entt::registry registry;
+    auto view = registry.view<const paged_int, const char>();
+    std::size_t count{};
+
+    for(auto i = 0; i < 10; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<paged_int>(entity, i);
+        registry.emplace<char>(entity);
+    }
+
+    view.chunked([&count](auto *entity, auto *value, auto *, auto sz) {
+        ASSERT_LE(sz, 4u);
+
+        for(decltype(sz) i{}; i < sz; ++i) {
+            ASSERT_EQ(static_cast<int>(entt::to_integral(*(entity + i))), (value + i)->value);
+        }
+
+        count += sz;
+    });
+
+    ASSERT_EQ(count, 10u);
+}
+
 TEST(MultiComponentView, ChunkedSpread) {
     entt::registry registry;
     auto view = registry.view<const entt::id_type, const char>();
@@ -879,3 +1095,88 @@ TEST(MultiComponentView, ChunkedWithExcludedComponents) {
         }
     });
 }
+
+TEST(MultiComponentView, EachExecutor) {
+    entt::registry registry;
+    auto view = registry.view<int, const char>(entt::exclude<double>);
+    std::vector<entt::entity> expected{};
+    std::vector<entt::entity> visited{};
+
+    view.each([](auto...) { FAIL(); });
+
+    for(auto next = 0; next < 100; ++next) {
+        const auto entity = registry.create();
+        registry.emplace<int>(entity, next);
+
+        if(next % 3) {
+            registry.emplace<char>(entity);
+        }
+
+        if(next % 7 == 0) {
+            registry.emplace<double>(entity);
+        }
+    }
+
+    view.each([&expected](const entt::entity entity, auto &&...) { expected.push_back(entity); });
+
+    // chunks are run backwards to make sure they are independent of each other
+    view.each([](const std::size_t tasks, auto task) {
+        ASSERT_EQ(tasks, 10u);
+
+        for(auto pos = tasks; pos; --pos) {
+            task(pos - 1u);
+        }
+    }, [&visited](const auto entity, int &value, const char) {
+        ASSERT_EQ(value, static_cast<int>(entt::to_integral(entity)));
+        visited.push_back(entity);
+    }, 7u);
+
+    ASSERT_EQ(visited.size(), expected.size());
+    ASSERT_TRUE(std::is_permutation(visited.cbegin(), visited.cend(), expected.cbegin()));
+
+    entt::thread_pool pool{3u};
+    std::atomic<std::size_t> count{};
+
+    view.each<int>(pool, [&count](int &value, const char) {
+        ++count;
+        ++value;
+    }, 4u);
+
+    ASSERT_EQ(count.load(), expected.size());
+
+    view.each(pool, [](const auto entity, const int value, const char) {
+        ASSERT_EQ(value, static_cast<int>(entt::to_integral(entity)) + 1);
+    });
+}
+
+TEST(MultiComponentView, ChangedSince) {
+    entt::registry registry;
+    auto view = registry.view<tracked_int, const char>(entt::exclude<double>);
+
+    for(auto next = 0; next < 5; ++next) {
+        const auto entity = registry.create();
+        registry.emplace<tracked_int>(entity, next);
+        registry.emplace<char>(entity, static_cast<char>('a' + next));
+    }
+
+    const auto tick = registry.tick();
+
+    registry.patch<tracked_int>(entt::entity{0}, [](auto &value) { value.value = 42; });
+    registry.patch<tracked_int>(entt::entity{1}, [](auto &value) { value.value = 42; });
+    registry.replace<tracked_int>(entt::entity{3}, 42);
+    registry.emplace<double>(entt::entity{1});
+    registry.emplace<tracked_int>(registry.create(), 42);
+
+    std::size_t count{};
+
+    view.each(entt::changed_since<tracked_int>(tick), [&count](const auto entity, auto &value, const char character) {
+        ASSERT_TRUE(entity == entt::entity{0} || entity == entt::entity{3});
+        ASSERT_EQ(value.value, 42);
+        ASSERT_EQ(character, 'a' + static_cast<char>(entt::to_integral(entity)));
+        ++count;
+    });
+
+    ASSERT_EQ(count, 2u);
+
+    view.each(entt::changed_since<tracked_int>(registry.tick()), [](auto &&...) { FAIL(); });
+}